@@ -960,6 +960,50 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Reserve CPU bandwidth for a thread
+ *
+ * Places @a thread in the earliest-deadline-first class, served by a
+ * Constant Bandwidth Server which guarantees it @a runtime_us of CPU
+ * time in every @a period_us.  The kernel manages the thread's
+ * deadline from then on; k_thread_deadline_set() should not be used
+ * on it.  Within a priority level, reserved threads run ahead of
+ * best-effort threads and are ordered by deadline.  Reservations do
+ * not change static priorities: threads of higher priority still
+ * preempt reserved ones.
+ *
+ * When the thread has consumed its runtime, its deadline is postponed
+ * by one period and its runtime replenished, so that it yields to the
+ * other reserved threads instead of starving them.  If the budget
+ * timer detects this while the thread is running, @a overrun is
+ * called first, in interrupt context and with the thread preempted,
+ * in the same way as the k_thread_time_slice_set() callback.
+ *
+ * Budgets are accounted in k_cycle_get_32() units but enforced by the
+ * system timer, so an overrun is detected up to one tick late.
+ *
+ * A reservation is released with @a runtime_us of zero, or when the
+ * thread exits.
+ *
+ * @param thread Thread to configure
+ * @param runtime_us Guaranteed runtime per period, in microseconds, or
+ *                   zero to release the reservation
+ * @param period_us Server period and relative deadline, in microseconds
+ * @param overrun Callback invoked on budget overrun, or NULL
+ * @param data Parameter for @a overrun
+ *
+ * @retval 0 on success
+ * @retval -EINVAL @a runtime_us exceeds @a period_us, or the period is
+ *                 too long to be represented
+ * @retval -EBUSY Admission control refused the reservation because the
+ *                total reserved bandwidth would exceed
+ *                @kconfig{CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION}
+ */
+int k_thread_cbs_set(k_tid_t thread, uint32_t runtime_us, uint32_t period_us,
+		     k_thread_cbs_fn_t overrun, void *data);
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -2298,9 +2342,24 @@ __syscall int k_futex_wake(struct k_futex *futex, bool wake_all);
  * @ingroup event_apis
  */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#ifdef CONFIG_EVENTS_WAIT_BUCKETS
+#define Z_EVENT_WAIT_BUCKETS CONFIG_EVENTS_WAIT_BUCKETS
+#else
+#define Z_EVENT_WAIT_BUCKETS 1
+#endif
+/** @endcond */
+
 struct k_event {
-	_wait_q_t         wait_q;
-	uint32_t          events;
+	/* Waiters, by the lowest event they wait for */
+	_wait_q_t         wait_q[Z_EVENT_WAIT_BUCKETS];
+	/* Events waited for in each wait queue, may be stale */
+	uint32_t          wait_mask[Z_EVENT_WAIT_BUCKETS];
+	/* Union of wait_mask[] */
+	atomic_t          waiting;
+	atomic_t          events;
 	struct k_spinlock lock;
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_event)
@@ -2311,9 +2370,11 @@ struct k_event {
 
 };
 
+#define Z_EVENT_WAIT_Q_INIT(i, obj) Z_WAIT_Q_INIT(&(obj).wait_q[i])
+
 #define Z_EVENT_INITIALIZER(obj) \
 	{ \
-	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.wait_q = { LISTIFY(Z_EVENT_WAIT_BUCKETS, Z_EVENT_WAIT_Q_INIT, (,), obj) }, \
 	.events = 0 \
 	}
 
@@ -2974,6 +3035,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3560,6 +3622,46 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue);
 
+/** @brief Add a worker thread to a work queue.
+ *
+ * The work items of a queue are normally processed one at a time by the
+ * thread started with k_work_queue_start().  Each worker added with this
+ * function runs an additional thread, at the priority of the queue thread,
+ * that processes items of the same queue concurrently.
+ *
+ * Every worker keeps a local list of pending items.  Items submitted from
+ * a worker go to its own list, items submitted from other contexts go to
+ * the list of the worker pinned to the submitting CPU (or to the queue
+ * thread if there is none), and idle workers steal items from the others.
+ * A single work item is never run concurrently with itself, and flush,
+ * cancel and drain operations behave as they do on a single-threaded
+ * queue.  No ordering is guaranteed between distinct work items.
+ *
+ * Workers can't be removed once added.
+ *
+ * @note Requires @kconfig{CONFIG_WORKQUEUE_WORKERS}.
+ *
+ * @param queue pointer to the queue structure, which must have been
+ *        started.
+ *
+ * @param worker pointer to the worker structure.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the worker thread stack area, in bytes.
+ *
+ * @param cpu the CPU to pin the worker thread to, or -1 to let it run on
+ *        any CPU.  Pinning requires @kconfig{CONFIG_SCHED_CPU_MASK}.
+ *
+ * @retval 0 if the worker was added and started
+ * @retval -ENODEV if the queue is not started
+ * @retval -EINVAL if @p cpu is invalid or pinning is not supported
+ */
+int k_work_queue_add_worker(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int cpu);
+
 /** @brief Wait until the work queue has drained, optionally plugging it.
  *
  * This blocks submission to the work queue except when coming from queue
@@ -3975,6 +4077,11 @@ struct k_work {
 	 * It can be RUNNING and CANCELING simultaneously.
 	 */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* Flushes waiting for the item, on queues with workers. */
+	sys_slist_t flushers;
+#endif /* CONFIG_WORKQUEUE_WORKERS */
 };
 
 #define Z_WORK_INITIALIZER(work_handler) { \
@@ -4030,10 +4137,19 @@ struct k_work_delayable {
  * processing) the item, and will be processed as soon as the item
  * completes.  When the flusher is processed the semaphore will be
  * signaled, releasing the thread waiting for the flush.
+ *
+ * On queues with additional workers the flusher could be picked up by
+ * another worker before the item completes, so it is instead inserted
+ * into the list of flushes of the item and signaled by the worker
+ * completing the item.
  */
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* Whether the flushed instance of the item is still queued */
+	bool queued;
+#endif /* CONFIG_WORKQUEUE_WORKERS */
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4103,6 +4219,44 @@ struct k_work_queue_config {
 	 * essential thread.
 	 */
 	bool essential;
+
+#if defined(CONFIG_SCHED_CPU_MASK) || defined(__DOXYGEN__)
+	/** The CPUs the work queue thread is allowed to run on, one bit
+	 * per CPU.
+	 *
+	 * The mask is applied before the thread is started. Leave it zero
+	 * to let the thread run on any CPU.
+	 */
+	uint32_t cpu_mask;
+#endif
+};
+
+/** @brief A structure used to hold an additional work queue thread. */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* The queue this worker processes items for. */
+	struct k_work_q *queue;
+
+	/* Node in the list of workers of the queue. */
+	sys_snode_t node;
+
+	/* List of k_work items submitted to this worker. */
+	sys_slist_t pending;
+
+	/* Wait queue for idle worker thread. */
+	_wait_q_t notifyq;
+
+	/* CPU the worker thread is pinned to, or -1. */
+	int cpu;
+
+	/* Whether the worker is running a work item. */
+	bool busy;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -4125,6 +4279,11 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* List of additional k_work_q_worker threads. */
+	sys_slist_t workers;
+#endif /* CONFIG_WORKQUEUE_WORKERS */
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4525,6 +4684,13 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	/** Wait queue of zero-copy users, and of threads they hold up */
+	_wait_q_t zc_wait_q;
+	/** Messages purged behind a claimed message */
+	uint32_t zc_purged;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 
 #ifdef CONFIG_OBJ_CORE_MSGQ
@@ -4536,6 +4702,13 @@ struct k_msgq {
  */
 
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+#define Z_MSGQ_ZC_INIT(obj) \
+	.zc_wait_q = Z_WAIT_Q_INIT(&obj.zc_wait_q),
+#else
+#define Z_MSGQ_ZC_INIT(obj)
+#endif
+
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -4547,6 +4720,7 @@ struct k_msgq {
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
+	Z_MSGQ_ZC_INIT(obj) \
 	}
 
 /**
@@ -4555,6 +4729,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_RESERVED	BIT(1)
+#define K_MSGQ_FLAG_CLAIMED	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4728,12 +4904,106 @@ __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
  *
  * This routine discards all unreceived messages in a message queue's ring
  * buffer. Any threads that are blocked waiting to send a message to the
- * message queue are unblocked and see an -ENOMSG error code.
+ * message queue are unblocked and see an -ENOMSG error code. A message
+ * claimed by k_msgq_get_peek() stays valid, and the purged messages keep
+ * their slots until it is released.
  *
  * @param msgq Address of the message queue.
  */
 __syscall void k_msgq_purge(struct k_msgq *msgq);
 
+/**
+ * @brief Reserve space for a message in place.
+ *
+ * This routine reserves the next free slot of the ring buffer of message
+ * queue @a msgq and returns its address, so that a message can be written
+ * directly into the queue instead of being copied by k_msgq_put(). The
+ * message becomes visible to receivers when k_msgq_put_commit() is called.
+ *
+ * Only one slot can be reserved at a time. While it is, other senders
+ * wait as if the queue were full.
+ *
+ * A user thread must have write access to the whole ring buffer of
+ * @a msgq.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the address of the reserved slot.
+ * @param timeout Waiting period to reserve a slot, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Slot reserved.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_reserve(struct k_msgq *msgq, void **data,
+				 k_timeout_t timeout);
+
+/**
+ * @brief Send a message written in place.
+ *
+ * This routine adds the message written into the slot returned by
+ * k_msgq_put_reserve() to message queue @a msgq.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of the reserved slot.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL @a data is not the reserved slot.
+ */
+__syscall int k_msgq_put_commit(struct k_msgq *msgq, void *data);
+
+/**
+ * @brief Receive a message in place.
+ *
+ * This routine claims the first message of message queue @a msgq and
+ * returns its address in the ring buffer, so that it can be read without
+ * being copied by k_msgq_get(). The message stays in the queue, and its
+ * slot in use, until k_msgq_get_release() is called.
+ *
+ * Only one message can be claimed at a time. While it is, other
+ * receivers wait as if the queue were empty.
+ *
+ * A user thread must have read access to the whole ring buffer of
+ * @a msgq.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the address of the message.
+ * @param timeout Waiting period to receive the message, or one of the
+ *                special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_get_peek(struct k_msgq *msgq, void **data,
+			      k_timeout_t timeout);
+
+/**
+ * @brief Release a message received in place.
+ *
+ * This routine removes the message claimed by k_msgq_get_peek() from
+ * message queue @a msgq and frees its slot.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of the claimed message.
+ *
+ * @retval 0 Message released.
+ * @retval -EINVAL @a data is not the claimed message.
+ */
+__syscall int k_msgq_get_release(struct k_msgq *msgq, void *data);
+
 /**
  * @brief Get the amount of free space in a message queue.
  *
@@ -4955,12 +5225,20 @@ struct k_pipe {
 	struct {
 		_wait_q_t      readers; /**< Reader wait queue */
 		_wait_q_t      writers; /**< Writer wait queue */
+#ifdef CONFIG_PIPE_ZERO_COPY
+		_wait_q_t      zc;      /**< Zero-copy wait queue */
+#endif
 	} wait_q;			/** Wait queue */
 
 	Z_DECL_POLL_EVENT
 
 	uint8_t	       flags;		/**< Flags */
 
+#ifdef CONFIG_PIPE_ZERO_COPY
+	size_t         reserved;        /**< Bytes reserved for writing */
+	size_t         claimed;         /**< Bytes claimed for reading */
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_pipe)
 
 #ifdef CONFIG_OBJ_CORE_PIPE
@@ -4973,6 +5251,13 @@ struct k_pipe {
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
 
+#ifdef CONFIG_PIPE_ZERO_COPY
+#define Z_PIPE_ZC_WAIT_Q_INIT(obj) \
+	, .zc = Z_WAIT_Q_INIT(&obj.wait_q.zc)
+#else
+#define Z_PIPE_ZC_WAIT_Q_INIT(obj)
+#endif
+
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
 	.buffer = pipe_buffer,                                      \
@@ -4984,6 +5269,7 @@ struct k_pipe {
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
 		.writers = Z_WAIT_Q_INIT(&obj.wait_q.writers)        \
+		Z_PIPE_ZC_WAIT_Q_INIT(obj)                           \
 	},                                                          \
 	Z_POLL_EVENT_OBJ_INIT(obj)                                   \
 	.flags = 0,                                                 \
@@ -5145,6 +5431,105 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  */
 __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 
+/**
+ * @brief Reserve space in a pipe's buffer.
+ *
+ * This routine reserves up to @a len contiguous bytes of free space in the
+ * buffer of @a pipe and returns their address, so that data can be
+ * written directly into the pipe instead of being copied by k_pipe_put().
+ * The data becomes visible to readers when k_pipe_put_commit() is called.
+ *
+ * The space granted ends at the end of the buffer or at the first byte in
+ * use, so it may be shorter than requested even if the pipe has more free
+ * space. Only one reservation can be outstanding at a time. While it is,
+ * other writers wait as if the pipe were full.
+ *
+ * A user thread must have write access to the whole buffer of @a pipe.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the reserved space.
+ * @param len Address of the number of bytes wanted, updated with the
+ *            number of bytes granted.
+ * @param timeout Waiting period to reserve space, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space reserved.
+ * @retval -EINVAL @a pipe has no buffer, or @a len points to zero.
+ * @retval -EIO Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_pipe_put_reserve(struct k_pipe *pipe, void **data,
+				 size_t *len, k_timeout_t timeout);
+
+/**
+ * @brief Write data written in place to a pipe.
+ *
+ * This routine adds the first @a len bytes of the space returned by
+ * k_pipe_put_reserve() to the data of @a pipe, and ends the reservation.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes written, at most the number granted.
+ *
+ * @retval 0 Data written.
+ * @retval -EINVAL No reservation is outstanding, or @a len is too large.
+ */
+__syscall int k_pipe_put_commit(struct k_pipe *pipe, size_t len);
+
+/**
+ * @brief Read data in place from a pipe.
+ *
+ * This routine claims up to @a len contiguous bytes of data at the head of
+ * the buffer of @a pipe and returns their address, so that they can be
+ * read without being copied by k_pipe_get(). The data stays in the pipe
+ * until k_pipe_get_release() is called.
+ *
+ * Data wrapping around the end of the buffer is returned in two parts.
+ * Only one claim can be outstanding at a time. While it is, other readers
+ * wait as if the pipe were empty.
+ *
+ * A user thread must have read access to the whole buffer of @a pipe.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the data.
+ * @param len Address of the maximum number of bytes to claim, updated with
+ *            the number of bytes claimed.
+ * @param timeout Waiting period to wait for data, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data claimed.
+ * @retval -EINVAL @a pipe has no buffer, or @a len points to zero.
+ * @retval -EIO Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_pipe_get_peek(struct k_pipe *pipe, void **data,
+			      size_t *len, k_timeout_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe.
+ *
+ * This routine removes the first @a len bytes of the data claimed by
+ * k_pipe_get_peek() from @a pipe, and ends the claim.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pipe Address of the pipe.
+ * @param len Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL No claim is outstanding, or @a len is too large.
+ */
+__syscall int k_pipe_get_release(struct k_pipe *pipe, size_t len);
+
 /** @} */
 
 /**
@@ -5166,6 +5551,14 @@ struct k_mem_slab {
 	char *buffer;
 	char *free_list;
 	struct k_mem_slab_info info;
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	atomic_t free_head;
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+	atomic_t waiters;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
@@ -5320,7 +5713,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	return (uint32_t)atomic_get(&slab->num_used);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5335,7 +5732,9 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && defined(CONFIG_MEM_SLAB_LOCK_FREE)
+	return (uint32_t)atomic_get(&slab->max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->info.max_used;
 #else
 	ARG_UNUSED(slab);
@@ -5355,7 +5754,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5398,6 +5797,10 @@ struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Blocking allocations in progress, see k_heap_free() */
+	atomic_t waiters;
+#endif
 };
 
 /**
@@ -5502,9 +5905,32 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
 /* Hand-calculated minimum heap sizes needed to return a successful
- * 1-byte allocation.  See details in lib/os/heap.[ch]
- */
-#define Z_HEAP_MIN_SIZE ((sizeof(void *) > 4) ? 56 : 44)
+ * 1-byte allocation, for 32 and 64 bit CPUs.  See details in
+ * lib/heap/heap.[ch].  With TLSF the bucket array and its bitmaps
+ * grow with the number of second level buckets, and the runtime
+ * statistics enlarge struct z_heap.
+ */
+#define Z_HEAP_MIN_SIZE_SEL(sz32, sz64) ((sizeof(void *) > 4) ? (sz64) : (sz32))
+
+#if defined(CONFIG_SYS_HEAP_TLSF) && defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+#define Z_HEAP_MIN_SIZE							\
+	((CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 1) ? Z_HEAP_MIN_SIZE_SEL(84, 112) :	\
+	 (CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 2) ? Z_HEAP_MIN_SIZE_SEL(124, 152) :	\
+	 (CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 3) ? Z_HEAP_MIN_SIZE_SEL(212, 240) :	\
+	 (CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 4) ? Z_HEAP_MIN_SIZE_SEL(428, 456) :	\
+	 Z_HEAP_MIN_SIZE_SEL(948, 976))
+#elif defined(CONFIG_SYS_HEAP_TLSF)
+#define Z_HEAP_MIN_SIZE							\
+	((CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 1) ? Z_HEAP_MIN_SIZE_SEL(76, 88) :	\
+	 (CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 2) ? Z_HEAP_MIN_SIZE_SEL(108, 120) :	\
+	 (CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 3) ? Z_HEAP_MIN_SIZE_SEL(196, 208) :	\
+	 (CONFIG_SYS_HEAP_TLSF_SL_LOG2 == 4) ? Z_HEAP_MIN_SIZE_SEL(412, 424) :	\
+	 Z_HEAP_MIN_SIZE_SEL(932, 944))
+#elif defined(CONFIG_SYS_HEAP_RUNTIME_STATS)
+#define Z_HEAP_MIN_SIZE Z_HEAP_MIN_SIZE_SEL(52, 80)
+#else
+#define Z_HEAP_MIN_SIZE Z_HEAP_MIN_SIZE_SEL(44, 56)
+#endif
 
 /**
  * @brief Define a static k_heap in the specified linker section
@@ -5796,6 +6222,11 @@ struct k_poll_event {
 	/** PRIVATE - DO NOT TOUCH */
 	struct z_poller *poller;
 
+#ifdef CONFIG_POLL_SET
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dnode_t _ready_node;
+#endif
+
 	/** optional user-specified tag, opaque, untouched by the API */
 	uint32_t tag:8;
 
@@ -5973,6 +6404,91 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+#if defined(CONFIG_POLL_SET) || defined(__DOXYGEN__)
+/**
+ * @brief Poll set
+ *
+ * A set of poll events which stay registered on their objects between
+ * waits, see k_poll_set_init().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+};
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is an alternative to k_poll() for threads polling the same
+ * events over and over: the events are registered on their objects once,
+ * when added to the set, rather than on each call. Events which may be
+ * ready are kept on a ready list, so waiting on a set only costs as much
+ * as the number of events ready, not the number of events in the set.
+ *
+ * Polling a set is level-triggered: an event returned by
+ * k_poll_set_wait() is returned again by the next wait as long as its
+ * condition is still met.
+ *
+ * Poll sets are not available to user mode threads.
+ *
+ * @param set The poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized, e.g. with k_poll_event_init(),
+ * and must not be passed to k_poll() or to another poll set until it is
+ * removed from @a set. It is owned by the set meanwhile and its state
+ * field is managed by the set.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @retval 0 The event was added.
+ * @retval -EBUSY The event is already registered.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove.
+ *
+ * @retval 0 The event was removed.
+ * @retval -EINVAL The event is not in @a set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Stores pointers to up to @a max_events ready events of @a set in
+ * @a events. The state field of each of them has the K_POLL_STATE_xxx
+ * values of the conditions met. Events not returned because @a events is
+ * full are returned first by the next call.
+ *
+ * @param set The poll set.
+ * @param events Array filled with the ready events.
+ * @param max_events Size of the @a events array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a events, at least 1.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout);
+#endif /* CONFIG_POLL_SET */
+
 /** @} */
 
 /**
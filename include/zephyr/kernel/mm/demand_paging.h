@@ -59,6 +59,24 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+#if defined(CONFIG_BACKING_STORE_COMPRESSED) || defined(__DOXYGEN__)
+	/**
+	 * Compressed backing store usage. Only kept system-wide, not per
+	 * thread. The compression ratio is
+	 * pages * CONFIG_MMU_PAGE_SIZE / bytes.
+	 */
+	struct {
+		/** Number of pages held in the backing store */
+		unsigned long			pages;
+
+		/** Number of those pages stored uncompressed */
+		unsigned long			incompressible;
+
+		/** Number of pool bytes used by those pages */
+		unsigned long			bytes;
+	} compression;
+#endif /* CONFIG_BACKING_STORE_COMPRESSED */
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
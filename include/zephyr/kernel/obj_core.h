@@ -35,6 +35,8 @@
 #define K_OBJ_TYPE_EVENT_ID      K_OBJ_TYPE_ID_GEN("EVNT")
 /** FIFO object type */
 #define K_OBJ_TYPE_FIFO_ID       K_OBJ_TYPE_ID_GEN("FIFO")
+/** IPI object type */
+#define K_OBJ_TYPE_IPI_ID        K_OBJ_TYPE_ID_GEN("IPI_")
 /** Kernel object type */
 #define K_OBJ_TYPE_KERNEL_ID     K_OBJ_TYPE_ID_GEN("KRNL")
 /** LIFO object type */
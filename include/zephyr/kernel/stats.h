@@ -30,4 +30,14 @@ struct k_cycle_stats {
 	bool      track_usage;  /**< true if gathering usage stats */
 };
 
+/**
+ * Structure used to track the inter-processor interrupts of a CPU.
+ */
+
+struct k_ipi_stats {
+	uint32_t  sent;         /**< \# of IPIs sent by this CPU */
+	uint32_t  received;     /**< \# of IPIs handled by this CPU */
+	uint32_t  coalesced;    /**< \# of IPI requests merged into pending ones */
+};
+
 #endif /* ZEPHYR_INCLUDE_KERNEL_STATS_H_ */
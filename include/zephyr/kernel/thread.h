@@ -114,6 +114,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds the thread while it is queued */
+	uint8_t rq_cpu;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -142,6 +147,17 @@ struct _thread_base {
 	void *slice_data;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* Constant bandwidth server, in k_cycle_get_32() units.  A zero
+	 * period means the thread has no reservation.
+	 */
+	uint32_t cbs_runtime;
+	uint32_t cbs_period;
+	int32_t cbs_budget;
+	k_thread_cbs_fn_t cbs_overrun;
+	void *cbs_data;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif /* CONFIG_SCHED_THREAD_USAGE */
@@ -141,6 +141,16 @@ struct _ready_q {
 
 typedef struct _ready_q _ready_q_t;
 
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+/* Per CPU IPI object, tracked separately from the CPU object core as both
+ * register their own statistics.
+ */
+struct _cpu_ipi {
+	struct k_obj_core  obj_core;
+	struct k_ipi_stats stats;
+};
+#endif
+
 struct _cpu {
 	/* nested interrupt count */
 	uint32_t nested;
@@ -154,10 +164,15 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* number of threads in ready_q, used for load balancing */
+	uint32_t nr_ready;
+#endif
+
 #if (CONFIG_NUM_METAIRQ_PRIORITIES > 0) &&                                                         \
 	(CONFIG_NUM_COOP_PRIORITIES > CONFIG_NUM_METAIRQ_PRIORITIES)
 	/* Coop thread preempted by current metairq, or NULL */
@@ -193,6 +208,10 @@ struct _cpu {
 	struct k_obj_core  obj_core;
 #endif
 
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+	struct _cpu_ipi ipi;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
@@ -210,7 +229,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -297,7 +316,10 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  With
+	 * CONFIG_TIMEOUT_QUEUE_WHEEL this is the absolute expiry tick
+	 * rather than a delta from the previous timeout.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
@@ -305,6 +327,7 @@ struct _timeout {
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
+typedef void (*k_thread_cbs_fn_t)(struct k_thread *thread, void *data);
 
 #ifdef __cplusplus
 }
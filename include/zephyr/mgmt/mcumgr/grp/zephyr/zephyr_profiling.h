@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_ZEPHYR_MCUMGR_GRP_ZPROFILING_H_
+#define ZEPHYR_INCLUDE_ZEPHYR_MCUMGR_GRP_ZPROFILING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Command IDs for zephyr profiling management group.
+ */
+#define ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLES	0	/* Read or reset the sampler histogram */
+#define ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLER	1	/* Start or stop the sampler */
+
+/**
+ * Command result codes for zephyr profiling management group.
+ */
+enum zephyr_profiling_group_err_code_t {
+	/** No error, this is implied if there is no ret value in the response */
+	ZEPHYRPROFILING_MGMT_ERR_OK = 0,
+
+	/** Unknown error occurred. */
+	ZEPHYRPROFILING_MGMT_ERR_UNKNOWN,
+
+	/** The requested sampling frequency is not supported. */
+	ZEPHYRPROFILING_MGMT_ERR_INVALID_FREQUENCY,
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_ZEPHYR_MCUMGR_GRP_ZPROFILING_H_ */
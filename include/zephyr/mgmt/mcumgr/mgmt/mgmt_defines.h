@@ -88,6 +88,9 @@ enum mcumgr_group_t {
 	 *  Zephyr-specific: Basic group
 	 */
 	ZEPHYR_MGMT_GRP_BASIC	= (MGMT_GROUP_ID_PERUSER - 1),
+
+	/** Zephyr-specific: Profiling group */
+	ZEPHYR_MGMT_GRP_PROFILING	= (MGMT_GROUP_ID_PERUSER - 2),
 };
 
 /**
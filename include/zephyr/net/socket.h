@@ -76,8 +76,13 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: do not block once the first message has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
+/** Maximum number of messages handled by one zsock_sendmmsg/zsock_recvmmsg call */
+#define ZSOCK_MMSG_VLEN_MAX 1024
+
 /**
  * @name Options for shutdown() function
  * @{
@@ -526,6 +531,60 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Send several messages on a socket in one call
+ *
+ * @details
+ * @rst
+ * Equivalent to calling :c:func:`zsock_sendmsg` for each element of
+ * ``msgvec``, with the socket looked up and locked only once. The number
+ * of bytes sent for each message is stored in its ``msg_len`` field.
+ * At most :c:macro:`ZSOCK_MMSG_VLEN_MAX` messages are sent.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages to send
+ * @param vlen Number of elements in @p msgvec
+ * @param flags Flags, as for zsock_sendmsg()
+ *
+ * @return Number of messages sent, or -1 with errno set if the first message
+ *         could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several messages from a socket in one call
+ *
+ * @details
+ * @rst
+ * Equivalent to calling :c:func:`zsock_recvmsg` for each element of
+ * ``msgvec``, with the socket looked up and locked only once. The number
+ * of bytes received for each message is stored in its ``msg_len`` field.
+ * With ``ZSOCK_MSG_WAITFORONE`` in ``flags``, the call does not block once
+ * a message has been received. The time spent waiting for the whole batch
+ * is bounded by ``timeout``, or by the receive timeout of the socket
+ * (``SO_RCVTIMEO``) if ``timeout`` is NULL. Socket types without native
+ * support only check the timeout between messages.
+ * At most :c:macro:`ZSOCK_MMSG_VLEN_MAX` messages are received.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_POSIX_API` is defined.
+ * @endrst
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Array of messages to fill
+ * @param vlen Number of elements in @p msgvec
+ * @param flags Flags, as for zsock_recvmsg(), and ZSOCK_MSG_WAITFORONE
+ * @param timeout Time to wait for the messages, or NULL
+ *
+ * @return Number of messages received, or -1 with errno set if none was.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     struct timespec *timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -959,6 +1018,21 @@ static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
 	return zsock_recvmsg(sock, msg, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags,
+			   struct timespec *timeout)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags, timeout);
+}
+
 /** POSIX wrapper for @ref zsock_poll */
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
@@ -1065,6 +1139,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -1214,6 +1290,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Name of the congestion control algorithm (string, e.g. "cubic") */
+#define TCP_CONGESTION 5
 
 /** @} */
 
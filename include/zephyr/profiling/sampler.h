@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_SAMPLER_H_
+#define ZEPHYR_INCLUDE_PROFILING_SAMPLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup profiling_sampler_apis Sampling profiler APIs
+ * @ingroup os_services
+ * @{
+ */
+
+/**
+ * @brief Samples of one function in one thread
+ */
+struct profiling_sampler_entry {
+	/** Thread which was interrupted */
+	k_tid_t thread;
+	/** Function which was running, as named by the symbol table */
+	const char *func;
+	/** Number of samples */
+	uint32_t count;
+};
+
+/**
+ * @brief Sampling profiler statistics
+ */
+struct profiling_sampler_stats {
+	/** Number of samples taken */
+	uint32_t samples;
+	/** Number of samples not counted, for lack of room or of a symbol */
+	uint32_t dropped;
+	/** Current sampling frequency in Hz, 0 when stopped */
+	uint32_t frequency;
+};
+
+/**
+ * @brief Start sampling
+ *
+ * Samples the function being run by the current thread @a frequency times
+ * per second, from a timer interrupt. The samples are counted per thread
+ * and per function, on top of the samples taken before.
+ *
+ * @param frequency Sampling frequency in Hz.
+ *
+ * @retval 0 Sampling started.
+ * @retval -EINVAL @a frequency is 0 or higher than the system tick rate.
+ */
+int profiling_sampler_start(uint32_t frequency);
+
+/**
+ * @brief Stop sampling
+ *
+ * The samples taken so far are kept.
+ */
+void profiling_sampler_stop(void);
+
+/**
+ * @brief Discard the samples taken so far
+ */
+void profiling_sampler_reset(void);
+
+/**
+ * @brief Get the sampling profiler statistics
+ *
+ * @param stats Filled with the statistics.
+ */
+void profiling_sampler_stats_get(struct profiling_sampler_stats *stats);
+
+/**
+ * @brief Get the functions sampled the most
+ *
+ * @param entries Filled with the entries with the most samples, in
+ *                decreasing number of samples.
+ * @param max_entries Size of @a entries.
+ *
+ * @return Number of entries stored in @a entries.
+ */
+size_t profiling_sampler_top(struct profiling_sampler_entry *entries,
+			     size_t max_entries);
+
+/**
+ * @brief Get the name of a sampled thread
+ *
+ * The thread may have exited since it was sampled, in which case its
+ * address is used instead.
+ *
+ * @param thread Thread of a sampler entry.
+ * @param buf Buffer for the name.
+ * @param size Size of @a buf.
+ *
+ * @return @a buf
+ */
+const char *profiling_sampler_thread_name(k_tid_t thread, char *buf,
+					  size_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_SAMPLER_H_ */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_condvar APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_CONDVAR_H_
+#define ZEPHYR_INCLUDE_SYS_CONDVAR_H_
+
+/*
+ * sys_condvar exists in user memory and works with a sys_mutex. When user
+ * mode is enabled it is built on a futex, so signalling a condition
+ * variable nobody waits on needs no syscall. When user mode isn't enabled,
+ * sys_condvar behaves like k_condvar.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_condvar structure
+ */
+struct sys_condvar {
+#ifdef CONFIG_USERSPACE
+	struct k_futex seq;
+	atomic_t waiters;
+#else
+	struct k_condvar kernel_condvar;
+#endif
+};
+
+/**
+ * @defgroup user_condvar_apis User mode condition variable APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_condvar
+ *
+ * The condition variable can be accessed outside the module where it is
+ * defined using:
+ *
+ * @code extern struct sys_condvar <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param _name Name of the condition variable.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_CONDVAR_DEFINE(_name) \
+	struct sys_condvar _name
+#else
+#define SYS_CONDVAR_DEFINE(_name) \
+	struct sys_condvar _name = { \
+		.kernel_condvar = Z_CONDVAR_INITIALIZER(_name.kernel_condvar) \
+	}
+#endif
+
+/**
+ * @brief Initialize a condition variable.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Condition variable initialized.
+ * @retval -EINVAL Bad parameters.
+ */
+int sys_condvar_init(struct sys_condvar *condvar);
+
+/**
+ * @brief Signal a condition variable.
+ *
+ * Wakes up one thread waiting on @a condvar, if any.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_condvar_signal(struct sys_condvar *condvar);
+
+/**
+ * @brief Broadcast a condition variable.
+ *
+ * Wakes up all threads waiting on @a condvar.
+ *
+ * @param condvar Address of the condition variable.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_condvar_broadcast(struct sys_condvar *condvar);
+
+/**
+ * @brief Wait on a condition variable.
+ *
+ * Atomically releases @a mutex and waits for @a condvar to be signalled,
+ * then locks @a mutex again before returning, even on a timeout. The
+ * caller must have locked @a mutex exactly once.
+ *
+ * As with any condition variable, wake-ups may be spurious: the caller
+ * must check its condition again after this returns.
+ *
+ * @param condvar Address of the condition variable.
+ * @param mutex Address of the mutex.
+ * @param timeout Waiting period for the condition variable,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Woken up.
+ * @retval -ETIMEDOUT Waiting period timed out.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ * @retval -EPERM Caller does not own @a mutex.
+ */
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_CONDVAR_H_ */
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_HEAP_CACHE_H_
+#define ZEPHYR_INCLUDE_SYS_HEAP_CACHE_H_
+
+#include <stddef.h>
+#include <zephyr/types.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/sys_heap.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Per-CPU small block cache for sys_heap.
+ *
+ * Small blocks are kept on per-CPU free lists, one for each
+ * power-of-two size class from 8 bytes up to
+ * 8 << (CONFIG_SYS_HEAP_CACHE_CLASSES - 1) bytes.  Allocating or
+ * freeing such a block only takes the local CPU's lock, and not
+ * whatever lock the user wraps around the heap.  The heap itself is
+ * only entered to refill or flush CONFIG_SYS_HEAP_CACHE_BATCH blocks at
+ * a time.
+ *
+ * Cached blocks stay allocated from the heap's point of view.  Heap
+ * listeners are notified when a block is handed to or returned by the
+ * user, not when it moves between a cache and the heap, and
+ * sys_heap_runtime_stats_get() reports cached blocks as free.
+ *
+ * The user must still serialize calls that enter the heap: those are
+ * sys_heap_cache_refill(), sys_heap_cache_flush() and
+ * sys_heap_cache_drain(), along with all the regular sys_heap calls.
+ */
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+
+/** @cond INTERNAL_HIDDEN */
+struct sys_heap_cache_bin {
+	void *head;
+	uint16_t count;
+};
+
+struct sys_heap_cache_cpu {
+	struct k_spinlock lock;
+	struct sys_heap_cache_bin bins[CONFIG_SYS_HEAP_CACHE_CLASSES];
+};
+/** @endcond */
+
+/**
+ * @brief Per-CPU block cache attached to a sys_heap
+ */
+struct sys_heap_cache {
+	/** Alignment of every cached block */
+	size_t align;
+	/** Bytes currently held in the caches */
+	atomic_t cached_bytes;
+	/** @cond INTERNAL_HIDDEN */
+	struct sys_heap_cache_cpu cpus[CONFIG_MP_MAX_NUM_CPUS];
+	/** @endcond */
+};
+
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
+/**
+ * @addtogroup low_level_heap_allocator
+ * @{
+ */
+
+/** @brief Attach a block cache to a sys_heap
+ *
+ * Must be called on an initialized heap before it is used
+ * concurrently.  Only requests whose alignment is at most @a align
+ * bytes are served by the cache.
+ *
+ * @param cache Cache to initialize
+ * @param heap Heap the cache is put in front of
+ * @param align Alignment of cached blocks, a power of two
+ */
+void sys_heap_cache_init(struct sys_heap_cache *cache, struct sys_heap *heap,
+			 size_t align);
+
+/** @brief Allocate a block from the local CPU's cache
+ *
+ * Does not enter the heap and needs no external locking.
+ *
+ * @param heap Heap with an attached cache
+ * @param align Alignment in bytes, a power of two or zero
+ * @param bytes Number of bytes requested
+ * @return Pointer to the block, or NULL if the request cannot be
+ *         served from the cache.  Use sys_heap_cache_refill() then.
+ */
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Allocate a block, refilling the local CPU's cache
+ *
+ * Called when sys_heap_cache_alloc() failed, with the heap locked.
+ * A cacheable request allocates a batch of blocks of its size class
+ * and keeps all but one of them in the local cache.  If the heap is
+ * exhausted, all caches are drained first.  Other requests are passed
+ * on to sys_heap_aligned_alloc(), and retried once after draining the
+ * caches if that fails.
+ *
+ * @param heap Heap with an attached cache
+ * @param align Alignment in bytes, a power of two or zero
+ * @param bytes Number of bytes requested
+ * @return Pointer to the block, or NULL
+ */
+void *sys_heap_cache_refill(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Free a block into the local CPU's cache
+ *
+ * Does not enter the heap and needs no external locking.  When the
+ * block cannot be cached, or the cache overflows, the blocks to give
+ * back to the heap are returned as a list for
+ * sys_heap_cache_flush().
+ *
+ * @param heap Heap with an attached cache
+ * @param mem Block to free, or NULL
+ * @return List of blocks to flush, or NULL
+ */
+void *sys_heap_cache_free(struct sys_heap *heap, void *mem);
+
+/** @brief Return blocks to the heap
+ *
+ * Frees a list returned by sys_heap_cache_free(), with the heap
+ * locked.
+ *
+ * @param heap Heap with an attached cache
+ * @param list List of blocks
+ */
+void sys_heap_cache_flush(struct sys_heap *heap, void *list);
+
+/** @brief Return all cached blocks to the heap
+ *
+ * Called with the heap locked.
+ *
+ * @param heap Heap with an attached cache
+ */
+void sys_heap_cache_drain(struct sys_heap *heap);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HEAP_CACHE_H_ */
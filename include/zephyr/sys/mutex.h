@@ -11,9 +11,9 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST_PATH, uncontended sys_mutexes are locked and
+ * unlocked with atomic ops on the lock word instead of syscalls, similar to
+ * Linux's FUTEX_LOCK_PI and FUTEX_UNLOCK_PI.
  */
 
 #ifdef __cplusplus
@@ -24,15 +24,24 @@ extern "C" {
 #include <zephyr/sys/atomic.h>
 #include <zephyr/types.h>
 #include <zephyr/sys_clock.h>
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#include <zephyr/kernel.h>
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* Owner thread, or 0 if unlocked. Used to lock and unlock the mutex
+	 * with atomic ops while there is no contention.
 	 */
 	atomic_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* Recursive locks by the owner, on top of the first one */
+	uint32_t nested;
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 };
 
+/* Set in sys_mutex::val while the kernel tracks the owner */
+#define SYS_MUTEX_WAITERS BIT(0)
+
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
  * @ingroup kernel_apis
@@ -67,10 +76,15 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_clear(&mutex->val);
+	mutex->nested = 0U;
+#else
 	ARG_UNUSED(mutex);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 
-	/* Nothing to do, kernel-side data structures are initialized at
-	 * boot
+	/* Nothing else to do, kernel-side data structures are initialized
+	 * at boot
 	 */
 }
 
@@ -98,10 +112,27 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
+ * @retval -EPERM The mutex names an owner the caller may not access
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = (atomic_val_t)k_current_get();
+
+	if (mutex == NULL) {
+		return -EINVAL;
+	}
+
+	if (atomic_cas(&mutex->val, 0, self)) {
+		return 0;
+	}
+
+	if ((atomic_get(&mutex->val) & ~SYS_MUTEX_WAITERS) == self) {
+		mutex->nested++;
+		return 0;
+	}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -124,7 +155,24 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = (atomic_val_t)k_current_get();
+
+	if (mutex == NULL) {
+		return -EINVAL;
+	}
+
+	if (((atomic_get(&mutex->val) & ~SYS_MUTEX_WAITERS) == self) &&
+	    (mutex->nested > 0U)) {
+		mutex->nested--;
+		return 0;
+	}
+
+	if (atomic_cas(&mutex->val, self, 0)) {
+		return 0;
+	}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief public sys_rwlock APIs.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_RWLOCK_H_
+#define ZEPHYR_INCLUDE_SYS_RWLOCK_H_
+
+/*
+ * sys_rwlock exists in user memory. When user mode is enabled it is built
+ * on a futex, and taking or releasing it without contention needs no
+ * syscall. When user mode isn't enabled, it is built on a k_mutex and a
+ * k_condvar.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * sys_rwlock structure
+ */
+struct sys_rwlock {
+#ifdef CONFIG_USERSPACE
+	struct k_futex state;
+#else
+	struct k_mutex lock;
+	struct k_condvar cond;
+	int32_t state;
+#endif
+};
+
+/**
+ * @defgroup user_rwlock_apis User mode read-write lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a sys_rwlock
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct sys_rwlock <name>; @endcode
+ *
+ * Route this to memory domains using K_APP_DMEM().
+ *
+ * @param _name Name of the lock.
+ */
+#ifdef CONFIG_USERSPACE
+#define SYS_RWLOCK_DEFINE(_name) \
+	struct sys_rwlock _name
+#else
+#define SYS_RWLOCK_DEFINE(_name) \
+	struct sys_rwlock _name = { \
+		.lock = Z_MUTEX_INITIALIZER(_name.lock), \
+		.cond = Z_CONDVAR_INITIALIZER(_name.cond), \
+	}
+#endif
+
+/**
+ * @brief Initialize a read-write lock.
+ *
+ * @param rwlock Address of the lock.
+ *
+ * @retval 0 Lock initialized.
+ * @retval -EINVAL Bad parameters.
+ */
+int sys_rwlock_init(struct sys_rwlock *rwlock);
+
+/**
+ * @brief Take a read-write lock for reading.
+ *
+ * Any number of threads may hold @a rwlock for reading at the same time,
+ * as long as no thread holds it for writing. Readers are not held back by
+ * waiting writers.
+ *
+ * @param rwlock Address of the lock.
+ * @param timeout Waiting period to take the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock taken.
+ * @retval -ETIMEDOUT Waiting period timed out.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_rwlock_rdlock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Take a read-write lock for writing.
+ *
+ * @param rwlock Address of the lock.
+ * @param timeout Waiting period to take the lock,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Lock taken.
+ * @retval -ETIMEDOUT Waiting period timed out.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_rwlock_wrlock(struct sys_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Release a read-write lock.
+ *
+ * Releases @a rwlock, taken for reading or for writing by the caller.
+ *
+ * @param rwlock Address of the lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EPERM The lock was not taken.
+ * @retval -EINVAL Parameter address not recognized.
+ * @retval -EACCES Caller does not have enough access.
+ */
+int sys_rwlock_unlock(struct sys_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_RWLOCK_H_ */
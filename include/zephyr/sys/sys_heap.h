@@ -54,10 +54,15 @@ extern "C" {
  * put the two values somewhere else, though it would make
  * SYS_HEAP_DEFINE a little hairy to write.
  */
+struct sys_heap_cache;
+
 struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap_cache *cache;
+#endif
 };
 
 struct z_heap_stress_result {
@@ -65,6 +70,10 @@ struct z_heap_stress_result {
 	uint32_t successful_allocs;
 	uint32_t total_frees;
 	uint64_t accumulated_in_use_bytes;
+	/* Failed allocations that would have fit in the free bytes */
+	uint32_t fragmented_allocs;
+	uint32_t allocs_per_sec;
+	uint32_t max_alloc_cycles;
 };
 
 /**
@@ -78,6 +87,10 @@ struct z_heap_stress_result {
 /**
  * @brief Get the runtime statistics of a sys_heap
  *
+ * Blocks held in a cache attached with sys_heap_cache_init() are
+ * counted as free.  The maximum includes them, as it is only updated
+ * by the heap itself.
+ *
  * @param heap Pointer to specified sys_heap
  * @param stats_t Pointer to struct to copy statistics into
  * @return -EINVAL if null pointers, otherwise 0
@@ -229,7 +242,9 @@ static inline bool sys_heap_validate(struct sys_heap *heap)
  * target_percent full.  Allocation and free operations are provided
  * by the caller as callbacks (i.e. this can in theory test any heap).
  * Results, including counts of frees and successful/unsuccessful
- * allocations, are returned via the @a result struct.
+ * allocations, allocations that failed although enough bytes were
+ * free, the allocation rate and the worst allocation latency, are
+ * returned via the @a result struct.
  *
  * @param alloc_fn Callback to perform an allocation.  Passes back the @a
  *              arg parameter as a context handle.
@@ -257,6 +272,36 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     int target_percent,
 		     struct z_heap_stress_result *result);
 
+/** @brief Multi-threaded sys_heap stress test rig
+ *
+ * Runs the sys_heap_stress() test from @a num_threads threads at
+ * once, at the priority of the caller.  Each thread works on an equal
+ * share of @a scratch_mem and of @a total_bytes, so that together they
+ * seek @a target_percent fill of the whole heap.  The callbacks must
+ * be safe to call concurrently.  The counts in @a result are summed
+ * over all threads, and its allocation rate measured over the whole
+ * run.
+ *
+ * @param alloc_fn Callback to perform an allocation
+ * @param free_fn Callback to perform a free
+ * @param arg Context handle to pass back to the callbacks
+ * @param total_bytes Size of the byte array the heap was initialized in
+ * @param op_count How many iterations each thread tests
+ * @param scratch_mem A pointer to scratch memory shared by the threads
+ * @param scratch_bytes Size of the memory pointed to by @a scratch_mem
+ * @param target_percent Percentage fill value (1-100) to seek
+ * @param num_threads Number of threads, at most
+ *                    CONFIG_SYS_HEAP_STRESS_THREADS
+ * @param result Struct into which to store test results.
+ */
+void sys_heap_stress_threaded(void *(*alloc_fn)(void *arg, size_t bytes),
+			      void (*free_fn)(void *arg, void *p),
+			      void *arg, size_t total_bytes,
+			      uint32_t op_count,
+			      void *scratch_mem, size_t scratch_bytes,
+			      int target_percent, int num_threads,
+			      struct z_heap_stress_result *result);
+
 /** @brief Print heap internal structure information to the console
  *
  * Print information on the heap structure such as its size, chunk buckets,
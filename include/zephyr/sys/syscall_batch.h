@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Batched system calls
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+#define ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+
+#include <zephyr/toolchain.h>
+#include <zephyr/syscall_list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup usermode_apis
+ * @{
+ */
+
+/**
+ * @brief One system call of a batch
+ *
+ * @a args are the raw system call arguments, as passed to the
+ * arch_syscall_invoke functions: 64-bit values take two words on 32-bit
+ * targets, and system calls with more than 6 words of arguments take a
+ * pointer to the remaining ones as their last argument.
+ */
+struct k_syscall_batch_entry {
+	/** System call ID, one of the K_SYSCALL_* values */
+	uintptr_t id;
+	/** Raw system call arguments */
+	uintptr_t args[6];
+	/** Set to the raw return value of the system call */
+	uintptr_t ret;
+};
+
+/**
+ * @brief Initializer for a batched system call
+ *
+ * @param _id System call ID, e.g. K_SYSCALL_K_SEM_GIVE
+ * @param ... Up to 6 raw system call arguments
+ */
+#define K_SYSCALL_BATCH_ENTRY(_id, ...) \
+	{ .id = (_id), .args = { __VA_ARGS__ } }
+
+/**
+ * @brief Make several system calls at once
+ *
+ * Executes the system calls described by @a entries in order, trapping
+ * into the kernel only once, and stores the return value of each in its
+ * entry. Each system call is verified as if it was made on its own: an
+ * invalid call kills the caller like it would outside a batch, and the
+ * calls which precede it have already been executed.
+ *
+ * This is only useful to user mode threads, supervisor threads call the
+ * kernel directly anyway.
+ *
+ * @param entries Array of system calls, writable by the caller
+ * @param count Number of entries, at most CONFIG_SYSCALL_BATCH_MAX
+ *
+ * @retval 0 All system calls were made.
+ * @retval -EINVAL @a count is too large.
+ * @retval -ENOTSUP Called from supervisor mode.
+ */
+__syscall int k_syscall_batch(struct k_syscall_batch_entry *entries,
+			      size_t count);
+
+#ifndef CONFIG_USERSPACE
+/* LCOV_EXCL_START */
+/**
+ * @internal
+ */
+static inline int z_impl_k_syscall_batch(struct k_syscall_batch_entry *entries,
+					 size_t count)
+{
+	ARG_UNUSED(entries);
+	ARG_UNUSED(count);
+
+	return -ENOTSUP;
+}
+/* LCOV_EXCL_STOP */
+#endif /* !CONFIG_USERSPACE */
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <zephyr/syscalls/syscall_batch.h>
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYSCALL_BATCH_H_ */
@@ -18,6 +18,12 @@
  * Threads waiting on an event object have the option of either waking once
  * any or all of the events it desires have been posted to the event object.
  *
+ * Waiting threads are spread over CONFIG_EVENTS_WAIT_BUCKETS wait queues by
+ * the lowest event they wait for, and the events waited for in each queue
+ * are tracked, so that only the queues which may hold a thread to wake are
+ * walked. The events themselves are updated atomically, and posting events
+ * nobody waits for does not take the lock at all.
+ *
  * @brief Kernel event object
  */
 
@@ -30,6 +36,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 /* private kernel APIs */
 #include <wait_q.h>
 #include <ksched.h>
@@ -42,7 +49,9 @@
 
 struct event_walk_data {
 	struct k_thread  *head;
+	struct k_thread  *tail;
 	uint32_t events;
+	uint32_t remaining;
 };
 
 #ifdef CONFIG_OBJ_CORE_EVENT
@@ -51,12 +60,16 @@ static struct k_obj_type obj_type_event;
 
 void z_impl_k_event_init(struct k_event *event)
 {
-	event->events = 0;
+	atomic_clear(&event->events);
+	atomic_clear(&event->waiting);
 	event->lock = (struct k_spinlock) {};
 
 	SYS_PORT_TRACING_OBJ_INIT(k_event, event);
 
-	z_waitq_init(&event->wait_q);
+	for (unsigned int i = 0; i < Z_EVENT_WAIT_BUCKETS; i++) {
+		z_waitq_init(&event->wait_q[i]);
+		event->wait_mask[i] = 0;
+	}
 
 	k_object_init(event);
 
@@ -98,6 +111,12 @@ static bool are_wait_conditions_met(uint32_t desired, uint32_t current,
 	return match != 0;
 }
 
+/* Wait queue of a thread waiting for <desired> */
+static inline unsigned int event_bucket(uint32_t desired)
+{
+	return u32_count_trailing_zeros(desired) % Z_EVENT_WAIT_BUCKETS;
+}
+
 static int event_walk_op(struct k_thread *thread, void *data)
 {
 	unsigned int      wait_condition;
@@ -118,65 +137,102 @@ static int event_walk_op(struct k_thread *thread, void *data)
 
 		/*
 		 * The wait conditions have been satisfied. Add this
-		 * thread to the list of threads to unpend.
+		 * thread to the list of threads to unpend, keeping the
+		 * wait queue order so that they are readied as one batch.
 		 */
-		thread->next_event_link = event_data->head;
-		event_data->head = thread;
+		thread->next_event_link = NULL;
+		if (event_data->tail == NULL) {
+			event_data->head = thread;
+		} else {
+			event_data->tail->next_event_link = thread;
+		}
+		event_data->tail = thread;
 		z_abort_timeout(&thread->base.timeout);
+	} else {
+		event_data->remaining |= thread->events;
 	}
 
 	return 0;
 }
 
-static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
-				  uint32_t events_mask)
+/* Wake the threads waiting for <added> events whose wait conditions are met
+ * by <events>.
+ */
+static void event_wake(struct k_event *event, uint32_t events, uint32_t added)
 {
 	k_spinlock_key_t  key;
 	struct k_thread  *thread;
 	struct event_walk_data data;
-	uint32_t previous_events;
+	uint32_t waiting = 0;
 
 	data.head = NULL;
+	data.tail = NULL;
+	data.events = events;
 	key = k_spin_lock(&event->lock);
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, post, event, events,
-					events_mask);
-
-	previous_events = event->events & events_mask;
-	events = (event->events & ~events_mask) |
-		 (events & events_mask);
-	event->events = events;
-	data.events = events;
 	/*
 	 * Posting an event has the potential to wake multiple pended threads.
 	 * It is desirable to unpend all affected threads simultaneously. This
 	 * is done in three steps:
 	 *
-	 * 1. Walk the waitq and create a linked list of threads to unpend.
-	 * 2. Unpend each of the threads in the linked list
-	 * 3. Ready each of the threads in the linked list
+	 * 1. Walk the waitqs which may hold threads waiting for the added
+	 *    events and create a linked list of threads to unpend. A wait
+	 *    condition can only become true when one of its events is added.
+	 * 2. Set the return values of the threads in the linked list
+	 * 3. Unpend and ready the threads in the linked list as a batch
 	 */
 
-	z_sched_waitq_walk(&event->wait_q, event_walk_op, &data);
+	for (unsigned int i = 0; i < Z_EVENT_WAIT_BUCKETS; i++) {
+		if ((event->wait_mask[i] & added) != 0U) {
+			data.remaining = 0;
+			z_sched_waitq_walk(&event->wait_q[i], event_walk_op, &data);
+			event->wait_mask[i] = data.remaining;
+		}
+		waiting |= event->wait_mask[i];
+	}
+	atomic_set(&event->waiting, waiting);
+
+	for (thread = data.head; thread != NULL; thread = thread->next_event_link) {
+		arch_thread_return_value_set(thread, 0);
+		thread->events = events;
+	}
 
 	if (data.head != NULL) {
-		thread = data.head;
-		struct k_thread *next;
-		do {
-			arch_thread_return_value_set(thread, 0);
-			thread->events = events;
-			next = thread->next_event_link;
-			z_sched_wake_thread(thread, false);
-			thread = next;
-		} while (thread != NULL);
+		z_sched_wake_event_list(data.head);
 	}
 
 	z_reschedule(&event->lock, key);
+}
+
+static uint32_t k_event_post_internal(struct k_event *event, uint32_t events,
+				  uint32_t events_mask)
+{
+	atomic_val_t previous_events;
+	uint32_t added;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_event, post, event, events,
+					events_mask);
+
+	do {
+		previous_events = atomic_get(&event->events);
+		events = (previous_events & ~events_mask) |
+			 (events & events_mask);
+	} while (!atomic_cas(&event->events, previous_events, events));
+
+	/*
+	 * Waiters publish the events they wait for before checking the
+	 * events a last time: either they see the added events, or the
+	 * added events are seen here to be waited for.
+	 */
+	added = events & ~previous_events;
+	if ((added & atomic_get(&event->waiting)) != 0U) {
+		event_wake(event, events, added);
+	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_event, post, event, events,
 				       events_mask);
 
-	return previous_events;
+	return previous_events & events_mask;
 }
 
 uint32_t z_impl_k_event_post(struct k_event *event, uint32_t events)
@@ -259,15 +315,18 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 	thread = k_sched_current_thread_query();
 
 	k_spinlock_key_t  key = k_spin_lock(&event->lock);
+	unsigned int bucket = event_bucket(events);
+	uint32_t current;
 
 	if (options & K_EVENT_WAIT_RESET) {
-		event->events = 0;
+		atomic_clear(&event->events);
 	}
 
 	/* Test if the wait conditions have already been met. */
 
-	if (are_wait_conditions_met(events, event->events, wait_condition)) {
-		rv = event->events;
+	current = atomic_get(&event->events);
+	if (are_wait_conditions_met(events, current, wait_condition)) {
+		rv = current;
 
 		k_spin_unlock(&event->lock, key);
 		goto out;
@@ -280,6 +339,22 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 		goto out;
 	}
 
+	/*
+	 * Publish the events we are about to wait for, then test again in
+	 * case they were posted without taking the lock meanwhile.
+	 */
+
+	event->wait_mask[bucket] |= events;
+	atomic_or(&event->waiting, events);
+
+	current = atomic_get(&event->events);
+	if (are_wait_conditions_met(events, current, wait_condition)) {
+		rv = current;
+
+		k_spin_unlock(&event->lock, key);
+		goto out;
+	}
+
 	/*
 	 * The caller must pend to wait for the match. Save the desired
 	 * set of events in the k_thread structure.
@@ -291,7 +366,7 @@ static uint32_t k_event_wait_internal(struct k_event *event, uint32_t events,
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_event, wait, event, events,
 					   options, timeout);
 
-	if (z_pend_curr(&event->lock, key, &event->wait_q, timeout) == 0) {
+	if (z_pend_curr(&event->lock, key, &event->wait_q[bucket], timeout) == 0) {
 		/* Retrieve the set of events that woke the thread */
 		rv = thread->events;
 	}
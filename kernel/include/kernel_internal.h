@@ -182,6 +182,13 @@ void z_mem_domain_exit_thread(struct k_thread *thread);
 extern struct k_spinlock z_mem_domain_lock;
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* Slow paths of a sys_mutex, whose lock word is <val> */
+int z_mutex_lock_word(struct k_mutex *mutex, atomic_t *val,
+		      k_timeout_t timeout);
+int z_mutex_unlock_word(struct k_mutex *mutex, atomic_t *val);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 #ifdef CONFIG_GDBSTUB
 struct gdb_ctx;
 
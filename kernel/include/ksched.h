@@ -58,6 +58,7 @@ void *z_get_next_switch_handle(void *interrupted);
 void z_time_slice(void);
 void z_reset_time_slice(struct k_thread *curr);
 void z_sched_ipi(void);
+void z_sched_cpu_runq_balance(int32_t ticks);
 void z_sched_start(struct k_thread *thread);
 void z_ready_thread(struct k_thread *thread);
 void z_requeue_current(struct k_thread *curr);
@@ -65,6 +66,8 @@ struct k_thread *z_swap_next_thread(void);
 void z_thread_abort(struct k_thread *thread);
 void move_thread_to_end_of_prio_q(struct k_thread *thread);
 bool thread_is_sliceable(struct k_thread *thread);
+bool z_sched_cbs_charge(struct k_thread *thread, uint32_t cycles);
+void z_cbs_thread_exit(struct k_thread *thread);
 
 static inline void z_reschedule_unlocked(void)
 {
@@ -195,11 +198,26 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * All threads are unpended and made ready in a single hold of the
+ * scheduler lock.  They are added to the run queue in one pass, the next
+ * thread to run is recomputed once, and each other CPU is flagged for at
+ * most one IPI.
  *
- * @param wait_q Wait queue to wake up the highest prio thread
- * @param swap_retval Swap return value for woken thread
+ * @param wait_q Wait queue to wake up the threads on
+ * @param swap_retval Swap return value for woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @return Number of threads woken up
+ */
+int z_sched_wake_batch(_wait_q_t *wait_q, int swap_retval, void *swap_data);
+
+/**
+ * Wake up all threads pending on the provided wait queue
+ *
+ * Same as z_sched_wake_batch(), for callers that only care whether any
+ * thread was woken up.
+ *
+ * @param wait_q Wait queue to wake up the threads on
+ * @param swap_retval Swap return value for woken threads
  * @param swap_data Data return value to supplement swap_retval. May be NULL.
  * @retval true If any threads were woken up
  * @retval false If the wait_q was empty
@@ -207,16 +225,22 @@ void z_sched_wake_thread(struct k_thread *thread, bool is_timeout);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
-	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_batch(wait_q, swap_retval, swap_data) != 0;
 }
 
+#ifdef CONFIG_EVENTS
+/**
+ * Wake up a list of threads pending on an event
+ *
+ * Readies the threads linked through their next_event_link field as a
+ * batch, see z_sched_wake_batch().  The list should be in wait queue
+ * order.  Their return values must have been set already.
+ *
+ * @param head First thread of the list
+ */
+void z_sched_wake_event_list(struct k_thread *head);
+#endif /* CONFIG_EVENTS */
+
 /**
  * Atomically put the current thread to sleep on a wait queue, with timeout
  *
@@ -136,10 +136,6 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 		z_sched_switch_spin(new_thread);
 		_current_cpu->current = new_thread;
 
-#ifdef CONFIG_TIMESLICING
-		z_reset_time_slice(new_thread);
-#endif /* CONFIG_TIMESLICING */
-
 #ifdef CONFIG_SPIN_VALIDATE
 		z_spin_lock_set_owner(&_sched_spinlock);
 #endif /* CONFIG_SPIN_VALIDATE */
@@ -153,6 +149,14 @@ static ALWAYS_INLINE unsigned int do_swap(unsigned int key,
 		 */
 		z_requeue_current(old_thread);
 #endif /* CONFIG_SMP */
+
+		/* After the requeue, as resetting the slice may move
+		 * old_thread in the run queue (CONFIG_SCHED_DEADLINE_CBS).
+		 */
+#ifdef CONFIG_TIMESLICING
+		z_reset_time_slice(new_thread);
+#endif /* CONFIG_TIMESLICING */
+
 		void *newsh = new_thread->switch_handle;
 
 		if (IS_ENABLED(CONFIG_SMP)) {
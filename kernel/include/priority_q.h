@@ -18,6 +18,7 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 /* Dumb Scheduling */
 #if defined(CONFIG_SCHED_DUMB)
 #define _priq_run_add		z_priq_dumb_add
+#define _priq_run_add_after	z_priq_dumb_add_after
 #define _priq_run_remove	z_priq_dumb_remove
 # if defined(CONFIG_SCHED_CPU_MASK)
 #  define _priq_run_best	z_priq_dumb_mask_best
@@ -29,6 +30,7 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 #define _priq_run_add		z_priq_rb_add
 #define _priq_run_remove	z_priq_rb_remove
 #define _priq_run_best		z_priq_rb_best
+#define _priq_run_add_after(pq, prev, thread) z_priq_rb_add(pq, thread)
  /* Multi Queue Scheduling */
 #elif defined(CONFIG_SCHED_MULTIQ)
 
@@ -41,6 +43,7 @@ bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
+#define _priq_run_add_after(pq, prev, thread) z_priq_mq_add(pq, thread)
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq, struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq, struct k_thread *thread);
 #endif
@@ -220,6 +223,28 @@ static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
 
 	sys_dlist_append(pq, &thread->base.qnode_dlist);
 }
+
+/* Same as z_priq_dumb_add(), for a thread that does not outrank
+ * <prev>, a thread already in the queue: the search for its slot
+ * starts there instead of at the head.  Adding a batch of threads
+ * sorted by decreasing priority this way walks the queue only once.
+ */
+static ALWAYS_INLINE void z_priq_dumb_add_after(sys_dlist_t *pq,
+						struct k_thread *prev,
+						struct k_thread *thread)
+{
+	struct k_thread *t = prev;
+
+	while ((t = SYS_DLIST_PEEK_NEXT_CONTAINER(pq, t, base.qnode_dlist)) != NULL) {
+		if (z_sched_prio_cmp(thread, t) > 0) {
+			sys_dlist_insert(&t->base.qnode_dlist,
+					 &thread->base.qnode_dlist);
+			return;
+		}
+	}
+
+	sys_dlist_append(pq, &thread->base.qnode_dlist);
+}
 #endif /* CONFIG_SCHED_DUMB || CONFIG_WAITQ_DUMB */
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_PRIORITY_Q_H_ */
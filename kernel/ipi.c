@@ -7,17 +7,41 @@
 #include <kswap.h>
 #include <ksched.h>
 #include <ipi.h>
+#include <zephyr/init.h>
+#include <string.h>
 
 #ifdef CONFIG_TRACE_SCHED_IPI
 extern void z_trace_sched_ipi(void);
 #endif
 
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+static struct k_obj_type obj_type_ipi;
+
+/* Counters are only ever updated by their own CPU, with interrupts locked
+ * so the thread can't migrate halfway.
+ */
+#define IPI_STATS_INC(field)                            \
+	do {                                            \
+		unsigned int key = arch_irq_lock();     \
+							\
+		_current_cpu->ipi.stats.field++;        \
+		arch_irq_unlock(key);                   \
+	} while (false)
+#else
+#define IPI_STATS_INC(field) do { } while (false)
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
 
 void flag_ipi(uint32_t ipi_mask)
 {
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		atomic_or(&_kernel.pending_ipi, (atomic_val_t)ipi_mask);
+		atomic_val_t pending;
+
+		pending = atomic_or(&_kernel.pending_ipi, (atomic_val_t)ipi_mask);
+		if ((ipi_mask != 0U) &&
+		    (((uint32_t)pending & ipi_mask) == ipi_mask)) {
+			IPI_STATS_INC(coalesced);
+		}
 	}
 #endif /* CONFIG_SCHED_IPI_SUPPORTED */
 }
@@ -25,6 +49,14 @@ void flag_ipi(uint32_t ipi_mask)
 /* Create a bitmask of CPUs that need an IPI. Note: sched_spinlock is held. */
 atomic_val_t ipi_mask_create(struct k_thread *thread)
 {
+	if (IS_ENABLED(CONFIG_SCHED_CPU_RUNQ)) {
+		/* With per-CPU run queues only the CPU owning the queue
+		 * can pick the thread up, and that CPU was already flagged
+		 * when the thread was placed.
+		 */
+		return 0;
+	}
+
 	if (!IS_ENABLED(CONFIG_IPI_OPTIMIZE)) {
 		return (CONFIG_MP_MAX_NUM_CPUS > 1) ? IPI_ALL_CPUS_MASK : 0;
 	}
@@ -34,6 +66,11 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 	uint32_t  id = _current_cpu->id;
 	struct k_thread *cpu_thread;
 	bool   executable_on_cpu = true;
+#ifdef CONFIG_IPI_COALESCE
+	uint32_t  pending = (uint32_t)atomic_get(&_kernel.pending_ipi);
+	struct k_thread *lowest = NULL;
+	uint32_t  target = 0;
+#endif /* CONFIG_IPI_COALESCE */
 
 	for (uint32_t i = 0; i < num_cpus; i++) {
 		if (id == i) {
@@ -60,9 +97,29 @@ atomic_val_t ipi_mask_create(struct k_thread *thread)
 		      (thread_is_preemptible(cpu_thread))) ||
 		     thread_is_metairq(thread)) && executable_on_cpu) {
 			ipi_mask |= BIT(i);
+
+#ifdef CONFIG_IPI_COALESCE
+			if (((pending & BIT(i)) == 0U) &&
+			    ((lowest == NULL) ||
+			     (z_sched_prio_cmp(cpu_thread, lowest) < 0))) {
+				lowest = cpu_thread;
+				target = BIT(i);
+			}
+#endif /* CONFIG_IPI_COALESCE */
 		}
 	}
 
+#ifdef CONFIG_IPI_COALESCE
+	/* One CPU is enough to run <thread>: the one whose thread it beats
+	 * by the most, the idle thread being the lowest of all. CPUs already
+	 * flagged reschedule anyway and will pick it up if it is still the
+	 * best choice for them.
+	 */
+	if (!thread_is_metairq(thread)) {
+		ipi_mask = target;
+	}
+#endif /* CONFIG_IPI_COALESCE */
+
 	return (atomic_val_t)ipi_mask;
 }
 
@@ -81,6 +138,7 @@ void signal_pending_ipi(void)
 
 		cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
 		if (cpu_bitmap != 0) {
+			IPI_STATS_INC(sent);
 #ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
 			arch_sched_directed_ipi(cpu_bitmap);
 #else
@@ -100,9 +158,62 @@ void z_sched_ipi(void)
 	z_trace_sched_ipi();
 #endif /* CONFIG_TRACE_SCHED_IPI */
 
+	IPI_STATS_INC(received);
+
 #ifdef CONFIG_TIMESLICING
-	if (thread_is_sliceable(_current)) {
+	if (thread_is_sliceable(_current) ||
+	    IS_ENABLED(CONFIG_SCHED_DEADLINE_CBS)) {
 		z_time_slice();
 	}
 #endif /* CONFIG_TIMESLICING */
 }
+
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+static int ipi_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	struct _cpu_ipi *ipi = CONTAINER_OF(obj_core, struct _cpu_ipi, obj_core);
+
+	memcpy(stats, &ipi->stats, sizeof(ipi->stats));
+
+	return 0;
+}
+
+static int ipi_stats_reset(struct k_obj_core *obj_core)
+{
+	struct _cpu_ipi *ipi = CONTAINER_OF(obj_core, struct _cpu_ipi, obj_core);
+
+	memset(&ipi->stats, 0, sizeof(ipi->stats));
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc ipi_stats_desc = {
+	.raw_size = sizeof(struct k_ipi_stats),
+	.query_size = sizeof(struct k_ipi_stats),
+	.raw   = ipi_stats_raw,
+	.query = ipi_stats_raw,
+	.reset = ipi_stats_reset,
+	.disable = NULL,
+	.enable  = NULL,
+};
+
+static int init_ipi_obj_core_list(void)
+{
+	z_obj_type_init(&obj_type_ipi, K_OBJ_TYPE_IPI_ID,
+			offsetof(struct _cpu_ipi, obj_core));
+	k_obj_type_stats_init(&obj_type_ipi, &ipi_stats_desc);
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct _cpu_ipi *ipi = &_kernel.cpus[i].ipi;
+
+		k_obj_core_init_and_link(K_OBJ_CORE(ipi), &obj_type_ipi);
+		k_obj_core_stats_register(K_OBJ_CORE(ipi), &ipi->stats,
+					  sizeof(ipi->stats));
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_ipi_obj_core_list, PRE_KERNEL_1,
+	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
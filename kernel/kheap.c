@@ -8,13 +8,41 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/heap_cache.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+static inline bool heap_cached(struct k_heap *heap)
+{
+	return heap->heap.cache != NULL;
+}
+
+static inline atomic_t *heap_waiters(struct k_heap *heap)
+{
+	return &heap->waiters;
+}
+#else
+static inline bool heap_cached(struct k_heap *heap)
+{
+	ARG_UNUSED(heap);
+	return false;
+}
+
+static inline atomic_t *heap_waiters(struct k_heap *heap)
+{
+	ARG_UNUSED(heap);
+	return NULL;
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	atomic_clear(&heap->waiters);
+#endif
 	sys_heap_init(&heap->heap, mem, bytes);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
@@ -68,6 +96,15 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+	if (heap_cached(heap)) {
+		ret = sys_heap_cache_alloc(&heap->heap, align, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
+			return ret;
+		}
+	}
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -76,8 +113,23 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 
 	bool blocked_alloc = false;
 
+	/* Announce the wait before the caches are drained, so that a
+	 * block freed into a cache after the drain is either seen by the
+	 * retry or flushed by k_heap_free(), which then wakes us up.
+	 */
+	bool waiter = heap_cached(heap) && IS_ENABLED(CONFIG_MULTITHREADING) &&
+		      !K_TIMEOUT_EQ(timeout, K_NO_WAIT);
+
+	if (waiter) {
+		atomic_inc(heap_waiters(heap));
+	}
+
 	while (ret == NULL) {
-		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
+		if (heap_cached(heap)) {
+			ret = sys_heap_cache_refill(&heap->heap, align, bytes);
+		} else {
+			ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
+		}
 
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -99,6 +151,10 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 		key = k_spin_lock(&heap->lock);
 	}
 
+	if (waiter) {
+		atomic_dec(heap_waiters(heap));
+	}
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
 
 	k_spin_unlock(&heap->lock, key);
@@ -148,9 +204,30 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&heap->lock);
+	k_spinlock_key_t key;
 
-	sys_heap_free(&heap->heap, mem);
+	if (heap_cached(heap)) {
+		mem = sys_heap_cache_free(&heap->heap, mem);
+
+		/* The waiter count is read after the block is in the
+		 * cache.  A waiter that drained the caches before the
+		 * block got there has already raised it, so we drain
+		 * again and wake it up.
+		 */
+		if ((mem == NULL) && (atomic_get(heap_waiters(heap)) == 0)) {
+			SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+			return;
+		}
+
+		key = k_spin_lock(&heap->lock);
+		sys_heap_cache_flush(&heap->heap, mem);
+		if (atomic_get(heap_waiters(heap)) != 0) {
+			sys_heap_cache_drain(&heap->heap);
+		}
+	} else {
+		key = k_spin_lock(&heap->lock);
+		sys_heap_free(&heap->heap, mem);
+	}
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && (z_unpend_all(&heap->wait_q) != 0)) {
@@ -18,6 +18,124 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+/* The free list is a Treiber stack. The low bits of free_head hold the
+ * index + 1 of the first free block, or 0 if there is none, and the
+ * high bits a tag that changes on every update, so that a CAS cannot
+ * succeed on a head that was popped and pushed back in between (ABA).
+ * Each free block holds the index + 1 of the next one in its first word.
+ *
+ * A slab only uses as many index bits as its block count needs, which
+ * leaves at least half of the word, and usually much more, to the tag.
+ * An ABA can then only go unnoticed if a thread is preempted between
+ * reading the head and its CAS for exactly a multiple of 2^tag_bits
+ * updates of the same slab: at least 65536 on 32-bit targets, at least
+ * 2^32 on 64-bit ones.
+ */
+#define HEAD_IDX_MAX_BITS (sizeof(atomic_val_t) * 4U)
+
+static inline uintptr_t head_idx_mask(struct k_mem_slab *slab)
+{
+	return BIT_MASK(LOG2(slab->info.num_blocks) + 1);
+}
+
+static inline atomic_val_t head_make(struct k_mem_slab *slab, atomic_val_t old,
+				     uintptr_t idx)
+{
+	uintptr_t mask = head_idx_mask(slab);
+
+	return (atomic_val_t)((((uintptr_t)old & ~mask) + mask + 1U) | idx);
+}
+
+static inline char *idx_to_block(struct k_mem_slab *slab, uintptr_t idx)
+{
+	return slab->buffer + (idx - 1U) * slab->info.block_size;
+}
+
+static char *free_list_pop(struct k_mem_slab *slab)
+{
+	atomic_val_t old;
+	uintptr_t idx, next;
+
+	do {
+		old = atomic_get(&slab->free_head);
+		idx = (uintptr_t)old & head_idx_mask(slab);
+		if (idx == 0U) {
+			return NULL;
+		}
+		/* May read user data if the block was just taken, in
+		 * which case the tag has changed and the CAS fails.
+		 */
+		next = *(volatile uintptr_t *)idx_to_block(slab, idx);
+	} while (!atomic_cas(&slab->free_head, old, head_make(slab, old, next)));
+
+	return idx_to_block(slab, idx);
+}
+
+static void free_list_push(struct k_mem_slab *slab, char *block)
+{
+	uintptr_t idx = (block - slab->buffer) / slab->info.block_size + 1U;
+	atomic_val_t old;
+
+	do {
+		old = atomic_get(&slab->free_head);
+		*(uintptr_t *)block = (uintptr_t)old & head_idx_mask(slab);
+	} while (!atomic_cas(&slab->free_head, old, head_make(slab, old, idx)));
+}
+
+/* The counters live in atomics. slab->info follows them loosely and is
+ * refreshed by sync_info() whenever statistics are read.
+ */
+static void count_alloc(struct k_mem_slab *slab)
+{
+	atomic_val_t used = atomic_inc(&slab->num_used) + 1;
+
+	slab->info.num_used = (uint32_t)used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t max = atomic_get(&slab->max_used);
+
+	while ((used > max) && !atomic_cas(&slab->max_used, max, used)) {
+		max = atomic_get(&slab->max_used);
+	}
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+static void count_free(struct k_mem_slab *slab)
+{
+	slab->info.num_used = (uint32_t)(atomic_dec(&slab->num_used) - 1);
+}
+
+static inline void sync_info(struct k_mem_slab *slab)
+{
+	slab->info.num_used = (uint32_t)atomic_get(&slab->num_used);
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = (uint32_t)atomic_get(&slab->max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+
+static inline void reset_max_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_set(&slab->max_used, atomic_get(&slab->num_used));
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+	sync_info(slab);
+}
+#else
+static inline void sync_info(struct k_mem_slab *slab)
+{
+	ARG_UNUSED(slab);
+}
+
+static inline void reset_max_used(struct k_mem_slab *slab)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = slab->info.num_used;
+#else
+	ARG_UNUSED(slab);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+}
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -32,6 +150,7 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
+	sync_info(slab);
 	memcpy(stats, &slab->info, sizeof(slab->info));
 	k_spin_unlock(&slab->lock, key);
 
@@ -48,6 +167,7 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
+	sync_info(slab);
 	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
 			  slab->info.block_size;
 	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
@@ -71,9 +191,7 @@ static int k_mem_slab_stats_reset(struct k_obj_core *obj_core)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-	slab->info.max_used = slab->info.num_used;
-#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+	reset_max_used(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
@@ -112,6 +230,19 @@ static int create_free_list(struct k_mem_slab *slab)
 	}
 
 	slab->free_list = NULL;
+
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	CHECKIF(slab->info.num_blocks > BIT_MASK(HEAD_IDX_MAX_BITS)) {
+		return -EINVAL;
+	}
+
+	for (uint32_t i = 0; i < slab->info.num_blocks; i++) {
+		p = slab->buffer + slab->info.block_size * i;
+		*(uintptr_t *)p = (i + 1U < slab->info.num_blocks) ? i + 2U : 0U;
+	}
+	atomic_set(&slab->free_head, (slab->info.num_blocks > 0U) ? 1 : 0);
+	atomic_clear(&slab->waiters);
+#else
 	p = slab->buffer + slab->info.block_size * (slab->info.num_blocks - 1);
 
 	while (p >= slab->buffer) {
@@ -119,6 +250,7 @@ static int create_free_list(struct k_mem_slab *slab)
 		slab->free_list = p;
 		p -= slab->info.block_size;
 	}
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 	return 0;
 }
 
@@ -182,6 +314,12 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+	atomic_clear(&slab->num_used);
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_clear(&slab->max_used);
+#endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 
 	rc = create_free_list(slab);
 	if (rc < 0) {
@@ -216,6 +354,106 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 }
 #endif
 
+#ifdef CONFIG_MEM_SLAB_LOCK_FREE
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+
+	*mem = free_list_pop(slab);
+	if (*mem != NULL) {
+		count_alloc(slab);
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		/* don't wait for a free block to become available */
+		result = -ENOMEM;
+	} else {
+		key = k_spin_lock(&slab->lock);
+
+		/* Raise the flag before looking again: a concurrent free
+		 * either pushed its block before this pop, or sees the
+		 * flag afterwards and hands the block over.
+		 */
+		atomic_set(&slab->waiters, 1);
+		*mem = free_list_pop(slab);
+		if (*mem != NULL) {
+			count_alloc(slab);
+			k_spin_unlock(&slab->lock, key);
+			result = 0;
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mem_slab, alloc, slab, timeout);
+
+			/* wait for a free block or timeout */
+			result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
+			if (result == 0) {
+				*mem = _current->base.swap_data;
+			}
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
+
+	return result;
+}
+
+static void wake_waiters(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	struct k_thread *thread;
+	bool woken = false;
+	char *block;
+
+	while (z_waitq_head(&slab->wait_q) != NULL) {
+		block = free_list_pop(slab);
+		if (block == NULL) {
+			break;
+		}
+
+		thread = z_unpend_first_thread(&slab->wait_q);
+		if (thread == NULL) {
+			/* the waiter timed out meanwhile */
+			free_list_push(slab, block);
+			break;
+		}
+
+		count_alloc(slab);
+		z_thread_return_value_set_with_data(thread, 0, block);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	if (z_waitq_head(&slab->wait_q) == NULL) {
+		atomic_clear(&slab->waiters);
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+{
+	__ASSERT(slab_ptr_is_good(slab, mem), "Invalid memory pointer provided");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+	/* count first, so num_used never exceeds num_blocks */
+	count_free(slab);
+	free_list_push(slab, mem);
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING) &&
+	    (atomic_get(&slab->waiters) != 0)) {
+		wake_waiters(slab);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+}
+#else
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
@@ -292,6 +530,7 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 
 	k_spin_unlock(&slab->lock, key);
 }
+#endif /* CONFIG_MEM_SLAB_LOCK_FREE */
 
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
 {
@@ -301,6 +540,7 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
+	sync_info(slab);
 	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
 	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
 			    slab->info.block_size;
@@ -325,7 +565,7 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab)
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	slab->info.max_used = slab->info.num_used;
+	reset_max_used(slab);
 
 	k_spin_unlock(&slab->lock, key);
 
@@ -1343,7 +1343,14 @@ static int page_frame_prepare_locked(struct k_mem_page_frame *pf, bool *dirty_pt
 		ret = k_mem_paging_backing_store_location_get(pf, location_ptr,
 							      page_fault);
 		if (ret != 0) {
-			LOG_ERR("out of backing store memory");
+			/* Only a real fault is stuck without room: the other
+			 * callers, prefetches included, handle -ENOMEM.
+			 */
+			if (page_fault) {
+				LOG_ERR("out of backing store memory");
+			} else {
+				LOG_DBG("out of backing store memory");
+			}
 			return -ENOMEM;
 		}
 		arch_mem_page_out(k_mem_page_frame_to_virt(pf), *location_ptr);
@@ -1602,16 +1609,125 @@ static inline struct k_mem_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
-static bool do_page_fault(void *addr, bool pin)
+/* Page in addr, whose data is at page_in_location in the backing store.
+ * Called with z_mm_lock held, which may be dropped in the meantime.
+ *
+ * Only prefetches, for which page_fault is false, may fail, when the
+ * backing store has no room for the page frame chosen for eviction.
+ * That page frame then stays mapped and queued, but the eviction
+ * algorithm is not told: whatever k_mem_paging_eviction_select()
+ * updated for it (e.g. clock hands or the CLOCK-Pro non-resident
+ * history) is not undone.  This only skews later choices of the
+ * algorithm, which is preferred over an extra eviction API call.
+ */
+static int page_in_locked(void *addr, uintptr_t page_in_location, bool pin,
+			  bool page_fault, struct k_thread *faulting_thread,
+			  k_spinlock_key_t *key)
+{
+	struct k_mem_page_frame *pf;
+	uintptr_t page_out_location;
+	bool evict = false;
+	bool dirty = false;
+	int ret;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx",
+			k_mem_page_frame_to_virt(pf),
+			k_mem_page_frame_to_phys(pf));
+		evict = true;
+	}
+	ret = page_frame_prepare_locked(pf, &dirty, page_fault, &page_out_location);
+	if (ret != 0) {
+		/* Only an evicted page frame can fail, it stays in place */
+		__ASSERT(!page_fault, "failed to prepare page frame");
+		return ret;
+	}
+	if (evict) {
+		paging_stats_eviction_inc(faulting_thread, dirty);
+	}
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	k_spin_unlock(&z_mm_lock, *key);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key = k_spin_lock(&z_mm_lock);
+	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_BUSY);
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_MAPPED);
+	frame_mapped_set(pf, addr);
+	if (pin) {
+		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_PINNED);
+	}
+
+	arch_mem_page_in(addr, k_mem_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+	if (!pin) {
+		k_mem_paging_eviction_add(pf);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+/* Page following the last one paged in by a fault, prefetched or not */
+static uint8_t *prefetch_next;
+
+/* If the fault at addr continues a sequential run, page in the following
+ * pages in the same pass. Called with z_mm_lock held.
+ */
+static void prefetch_locked(void *addr, struct k_thread *faulting_thread,
+			    k_spinlock_key_t *key)
+{
+	uint8_t *pos = UINT_TO_POINTER(ROUND_DOWN(POINTER_TO_UINT(addr),
+						  CONFIG_MMU_PAGE_SIZE));
+	bool sequential = (pos == prefetch_next);
+
+	pos += CONFIG_MMU_PAGE_SIZE;
+	prefetch_next = pos;
+	if (!sequential) {
+		return;
+	}
+
+	for (int i = 0; i < CONFIG_DEMAND_PAGING_PREFETCH_PAGES; i++) {
+		uintptr_t location;
+
+		if ((pos >= K_MEM_VIRT_RAM_END) ||
+		    (arch_page_location_get(pos, &location) !=
+		     ARCH_PAGE_LOCATION_PAGED_OUT)) {
+			break;
+		}
+
+		if (page_in_locked(pos, location, false, false,
+				   faulting_thread, key) != 0) {
+			break;
+		}
+		pos += CONFIG_MMU_PAGE_SIZE;
+		prefetch_next = pos;
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
+
+static bool do_page_fault(void *addr, bool pin, bool prefetch)
 {
 	struct k_mem_page_frame *pf;
 	k_spinlock_key_t key;
-	uintptr_t page_in_location, page_out_location;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread;
-	int ret;
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
@@ -1700,47 +1816,15 @@ static bool do_page_fault(void *addr, bool pin)
 
 	paging_stats_faults_inc(faulting_thread, key.key);
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx",
-			k_mem_page_frame_to_virt(pf),
-			k_mem_page_frame_to_phys(pf));
+	(void)page_in_locked(addr, page_in_location, pin, true, faulting_thread, &key);
 
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	k_spin_unlock(&z_mm_lock, key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = k_spin_lock(&z_mm_lock);
-	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_BUSY);
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	k_mem_page_frame_clear(pf, K_MEM_PAGE_FRAME_MAPPED);
-	frame_mapped_set(pf, addr);
-	if (pin) {
-		k_mem_page_frame_set(pf, K_MEM_PAGE_FRAME_PINNED);
-	}
-
-	arch_mem_page_in(addr, k_mem_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
-	if (!pin) {
-		k_mem_paging_eviction_add(pf);
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+	if (prefetch) {
+		prefetch_locked(addr, faulting_thread, &key);
 	}
+#else
+	ARG_UNUSED(prefetch);
+#endif /* CONFIG_DEMAND_PAGING_PREFETCH */
 out:
 	k_spin_unlock(&z_mm_lock, key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
@@ -1758,7 +1842,7 @@ static void do_page_in(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, false);
+	ret = do_page_fault(addr, false, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1775,7 +1859,7 @@ static void do_mem_pin(void *addr)
 {
 	bool ret;
 
-	ret = do_page_fault(addr, true);
+	ret = do_page_fault(addr, true, false);
 	__ASSERT(ret, "unmapped memory address %p", addr);
 	(void)ret;
 }
@@ -1790,7 +1874,7 @@ void k_mem_pin(void *addr, size_t size)
 
 bool k_mem_page_fault(void *addr)
 {
-	return do_page_fault(addr, false);
+	return do_page_fault(addr, false, true);
 }
 
 static void do_mem_unpin(void *addr)
@@ -36,6 +36,103 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+static inline void msgq_advance(struct k_msgq *msgq, char **ptr, uint32_t msgs)
+{
+	*ptr += msgs * msgq->msg_size;
+	if (*ptr >= msgq->buffer_end) {
+		*ptr -= msgq->buffer_end - msgq->buffer_start;
+	}
+}
+
+#ifdef CONFIG_MSGQ_ZERO_COPY
+/* A reserved slot is always at write_ptr, and a claimed message at
+ * read_ptr. Copying senders wait while a slot is reserved, and copying
+ * receivers while a message is claimed, so that messages stay in order.
+ * Those waits, and all waits of zero-copy users, happen on zc_wait_q and
+ * are retried on every change. This keeps wait_q to threads waiting on
+ * an empty queue or a full one, which are never both present.
+ */
+static int zc_pend(struct k_msgq *msgq, k_spinlock_key_t *key,
+		   k_timepoint_t end)
+{
+	k_timeout_t timeout = sys_timepoint_timeout(end);
+	int ret;
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	ret = z_pend_curr(&msgq->lock, *key, &msgq->zc_wait_q, timeout);
+	*key = k_spin_lock(&msgq->lock);
+
+	return ret;
+}
+
+/* Wait while any of @a flags is set, on behalf of a copying call */
+static int zc_wait_clear(struct k_msgq *msgq, k_spinlock_key_t *key,
+			 k_timeout_t *timeout, uint8_t flags)
+{
+	k_timepoint_t end;
+	int ret = 0;
+
+	if ((msgq->flags & flags) == 0U) {
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+		return -ENOMSG;
+	}
+
+	end = sys_timepoint_calc(*timeout);
+	while (((msgq->flags & flags) != 0U) && (ret == 0)) {
+		ret = zc_pend(msgq, key, end);
+	}
+	*timeout = sys_timepoint_timeout(end);
+
+	return ret;
+}
+
+static inline bool zc_wake(struct k_msgq *msgq)
+{
+	if (z_waitq_head(&msgq->zc_wait_q) == NULL) {
+		return false;
+	}
+
+	return z_sched_wake_all(&msgq->zc_wait_q, 0, NULL);
+}
+
+/* Index @a idx of a peek, skipping messages purged behind a claim */
+static inline uint32_t zc_peek_idx(struct k_msgq *msgq, uint32_t idx)
+{
+	return (idx == 0U) ? 0U : idx + msgq->zc_purged;
+}
+#else
+static inline int zc_wait_clear(struct k_msgq *msgq, k_spinlock_key_t *key,
+				k_timeout_t *timeout, uint8_t flags)
+{
+	ARG_UNUSED(msgq);
+	ARG_UNUSED(key);
+	ARG_UNUSED(timeout);
+	ARG_UNUSED(flags);
+
+	return 0;
+}
+
+static inline bool zc_wake(struct k_msgq *msgq)
+{
+	ARG_UNUSED(msgq);
+
+	return false;
+}
+
+static inline uint32_t zc_peek_idx(struct k_msgq *msgq, uint32_t idx)
+{
+	ARG_UNUSED(msgq);
+
+	return idx;
+}
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -49,6 +146,10 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	z_waitq_init(&msgq->zc_wait_q);
+	msgq->zc_purged = 0;
+#endif /* CONFIG_MSGQ_ZERO_COPY */
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
 #endif	/* CONFIG_POLL */
@@ -110,6 +211,14 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	CHECKIF(z_waitq_head(&msgq->zc_wait_q) != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
+
+		return -EBUSY;
+	}
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 	if ((msgq->flags & K_MSGQ_FLAG_ALLOC) != 0U) {
 		k_free(msgq->buffer_start);
 		msgq->flags &= ~K_MSGQ_FLAG_ALLOC;
@@ -133,6 +242,13 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
+	result = zc_wait_clear(msgq, &key, &timeout, K_MSGQ_FLAG_RESERVED);
+	if (result != 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		k_spin_unlock(&msgq->lock, key);
+		return result;
+	}
+
 	if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -152,14 +268,17 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 			__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
 					msgq->write_ptr < msgq->buffer_end);
 			(void)memcpy(msgq->write_ptr, (char *)data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
+			msgq_advance(msgq, &msgq->write_ptr, 1U);
 			msgq->used_msgs++;
 #ifdef CONFIG_POLL
 			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
+			if (zc_wake(msgq)) {
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
+
+				z_reschedule(&msgq->lock, key);
+				return 0;
+			}
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -225,13 +344,17 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
+	result = zc_wait_clear(msgq, &key, &timeout, K_MSGQ_FLAG_CLAIMED);
+	if (result != 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+		k_spin_unlock(&msgq->lock, key);
+		return result;
+	}
+
 	if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy((char *)data, msgq->read_ptr, msgq->msg_size);
-		msgq->read_ptr += msgq->msg_size;
-		if (msgq->read_ptr == msgq->buffer_end) {
-			msgq->read_ptr = msgq->buffer_start;
-		}
+		msgq_advance(msgq, &msgq->read_ptr, 1U);
 		msgq->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
@@ -244,10 +367,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 					msgq->write_ptr < msgq->buffer_end);
 			(void)memcpy(msgq->write_ptr, (char *)pending_thread->base.swap_data,
 			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
+			msgq_advance(msgq, &msgq->write_ptr, 1U);
 			msgq->used_msgs++;
 
 			/* wake up waiting thread */
@@ -259,6 +379,13 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 			return 0;
 		}
+
+		if (zc_wake(msgq)) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
+
+			z_reschedule(&msgq->lock, key);
+			return 0;
+		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
@@ -337,6 +464,7 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 
 	key = k_spin_lock(&msgq->lock);
 
+	idx = zc_peek_idx(msgq, idx);
 	if (msgq->used_msgs > idx) {
 		bytes_to_end = (msgq->buffer_end - msgq->read_ptr);
 		byte_offset = idx * msgq->msg_size;
@@ -389,8 +517,18 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 		z_ready_thread(pending_thread);
 	}
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) {
+		/* drop the rest together with the claimed message */
+		msgq->zc_purged = msgq->used_msgs - 1U;
+		z_reschedule(&msgq->lock, key);
+		return;
+	}
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
+	(void)zc_wake(msgq);
 
 	z_reschedule(&msgq->lock, key);
 }
@@ -419,6 +557,213 @@ static inline uint32_t z_vrfy_k_msgq_num_used_get(struct k_msgq *msgq)
 
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+static inline bool reserve_blocked(struct k_msgq *msgq)
+{
+	return ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) ||
+	       (msgq->used_msgs == msgq->max_msgs);
+}
+
+static inline bool claim_blocked(struct k_msgq *msgq)
+{
+	return ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) ||
+	       (msgq->used_msgs == 0U);
+}
+
+int z_impl_k_msgq_put_reserve(struct k_msgq *msgq, void **data,
+			      k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result = 0;
+
+	if (reserve_blocked(msgq) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = -ENOMSG;
+	}
+
+	while ((result == 0) && reserve_blocked(msgq)) {
+		result = zc_pend(msgq, &key, end);
+	}
+
+	if (result == 0) {
+		msgq->flags |= K_MSGQ_FLAG_RESERVED;
+		*data = msgq->write_ptr;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_reserve(struct k_msgq *msgq, void **data,
+					    k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(msgq->buffer_start,
+				      msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_put_reserve(msgq, data, timeout);
+}
+#include <zephyr/syscalls/k_msgq_put_reserve_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_msgq_put_commit(struct k_msgq *msgq, void *data)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	bool resched;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) ||
+	    (data != msgq->write_ptr)) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+
+	/* Only receivers can be waiting here, since the queue had room */
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		(void)memcpy(pending_thread->base.swap_data, data,
+			     msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	} else {
+		msgq_advance(msgq, &msgq->write_ptr, 1U);
+		msgq->used_msgs++;
+#ifdef CONFIG_POLL
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+	}
+
+	resched = zc_wake(msgq) || (pending_thread != NULL);
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_commit(struct k_msgq *msgq, void *data)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_put_commit(msgq, data);
+}
+#include <zephyr/syscalls/k_msgq_put_commit_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_msgq_get_peek(struct k_msgq *msgq, void **data,
+			   k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	int result = 0;
+
+	if (claim_blocked(msgq) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = -ENOMSG;
+	}
+
+	while ((result == 0) && claim_blocked(msgq)) {
+		result = zc_pend(msgq, &key, end);
+	}
+
+	if (result == 0) {
+		msgq->flags |= K_MSGQ_FLAG_CLAIMED;
+		*data = msgq->read_ptr;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_peek(struct k_msgq *msgq, void **data,
+					 k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	K_OOPS(K_SYSCALL_MEMORY_READ(msgq->buffer_start,
+				     msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_get_peek(msgq, data, timeout);
+}
+#include <zephyr/syscalls/k_msgq_get_peek_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_msgq_get_release(struct k_msgq *msgq, void *data)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t msgs;
+	bool resched;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (((msgq->flags & K_MSGQ_FLAG_CLAIMED) == 0U) ||
+	    (data != msgq->read_ptr)) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_CLAIMED;
+	msgs = 1U + msgq->zc_purged;
+	msgq->zc_purged = 0U;
+	msgq_advance(msgq, &msgq->read_ptr, msgs);
+	msgq->used_msgs -= msgs;
+
+	/* handle first thread waiting to write (if any) */
+	pending_thread = z_unpend_first_thread(&msgq->wait_q);
+	if (pending_thread != NULL) {
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+			     msgq->msg_size);
+		msgq_advance(msgq, &msgq->write_ptr, 1U);
+		msgq->used_msgs++;
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+	}
+
+#ifdef CONFIG_POLL
+	if (msgq->used_msgs > 0U) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	resched = zc_wake(msgq) || (pending_thread != NULL);
+	if (resched) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_release(struct k_msgq *msgq, void *data)
+{
+	K_OOPS(K_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_get_release(msgq, data);
+}
+#include <zephyr/syscalls/k_msgq_get_release_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 #ifdef CONFIG_OBJ_CORE_MSGQ
 static int init_msgq_obj_core_list(void)
 {
@@ -32,11 +32,13 @@
 #include <ksched.h>
 #include <kthread.h>
 #include <wait_q.h>
+#include <kernel_internal.h>
 #include <errno.h>
 #include <zephyr/init.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/mutex.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/llext/symbol.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
@@ -102,47 +104,86 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+static inline struct k_thread *owner_peek(struct k_mutex *mutex)
 {
-	int new_prio;
-	k_spinlock_key_t key;
-	bool resched = false;
-
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+	return *(struct k_thread *volatile *)&mutex->owner;
+}
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+/* True if <owner> is running on another CPU, and so may soon release
+ * the mutex.  Only a hint, this is read without the scheduler lock.
+ * The owner may exit and be freed while we spin, so it is only
+ * compared against each CPU's current thread, never dereferenced.
+ */
+static inline bool owner_running(struct k_thread *owner)
+{
+	if ((owner == NULL) || (owner == _current)) {
+		return false;
+	}
 
-	key = k_spin_lock(&lock);
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		if (*(struct k_thread *volatile *)&_kernel.cpus[i].current == owner) {
+			return true;
+		}
+	}
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	return false;
+}
 
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
+/* Spin without the lock while the mutex is owned by a thread running
+ * on another CPU, for at most CONFIG_MUTEX_SPIN_US.  Priority
+ * inheritance is not needed meanwhile: the owner is running, and if it
+ * is preempted the spin ends and the caller pends as usual.  Returns
+ * true if it spun, with <timeout> reduced by the time spent.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key,
+		       k_timeout_t *timeout)
+{
+	uint32_t budget = k_us_to_cyc_ceil32(CONFIG_MUTEX_SPIN_US);
+	k_timepoint_t end;
+	uint32_t start;
 
-		mutex->lock_count++;
-		mutex->owner = _current;
+	if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT) || (mutex->lock_count == 0U) ||
+	    !owner_running(mutex->owner)) {
+		return false;
+	}
 
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+	end = sys_timepoint_calc(*timeout);
+	start = k_cycle_get_32();
 
-		k_spin_unlock(&lock, key);
+	k_spin_unlock(&lock, *key);
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+	do {
+		arch_spin_relax();
+	} while (owner_running(owner_peek(mutex)) &&
+		 ((k_cycle_get_32() - start) < budget));
 
-		return 0;
-	}
+	*key = k_spin_lock(&lock);
 
-	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
-		k_spin_unlock(&lock, key);
+	*timeout = sys_timepoint_timeout(end);
 
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
+	return true;
+}
+#else
+static inline bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key,
+			      k_timeout_t *timeout)
+{
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(key);
+	ARG_UNUSED(timeout);
 
-		return -EBUSY;
-	}
+	return false;
+}
+#endif /* CONFIG_MUTEX_ADAPTIVE_SPIN */
 
-	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
+/* Wait for <mutex>, owned by another thread, boosting the owner's priority
+ * meanwhile. Called with the lock held, which is released.
+ */
+static int mutex_pend(struct k_mutex *mutex, k_spinlock_key_t key,
+		      k_timeout_t timeout)
+{
+	int new_prio;
+	bool resched = false;
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
@@ -161,7 +202,6 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
-		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
 
@@ -193,11 +233,63 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		k_spin_unlock(&lock, key);
 	}
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
-
 	return -EAGAIN;
 }
 
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	bool spun;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	key = k_spin_lock(&lock);
+
+	spun = mutex_spin(mutex, &key, &timeout);
+
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+
+		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+					_current->base.prio :
+					mutex->owner_orig_prio;
+
+		mutex->lock_count++;
+		mutex->owner = _current;
+
+		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+			_current, mutex, mutex->lock_count,
+			mutex->owner_orig_prio);
+
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		/* A timeout that ran out while spinning is a timeout */
+		ret = spun ? -EAGAIN : -EBUSY;
+
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, ret);
+
+		return ret;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
+
+	ret = mutex_pend(mutex, key, timeout);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, ret);
+
+	return ret;
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 				      k_timeout_t timeout)
@@ -292,6 +384,125 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 #include <zephyr/syscalls/k_mutex_unlock_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* The owner in a lock word was written from user mode.  Only trust it
+ * if it is a thread the caller could name itself: one it has
+ * permission on, or one in its own memory domain.
+ */
+static int lock_word_owner_check(struct k_thread *owner)
+{
+	struct k_object *ko = k_object_find(owner);
+	int ret = k_object_validate(ko, K_OBJ_THREAD, _OBJ_INIT_TRUE);
+
+	if ((ret == -EPERM) &&
+	    (owner->mem_domain_info.mem_domain ==
+	     _current->mem_domain_info.mem_domain)) {
+		ret = 0;
+	}
+
+	return (ret == -EBADF) ? -EINVAL : ret;
+}
+
+/*
+ * Lock word of a sys_mutex: 0 when free, else the owner thread, with
+ * SYS_MUTEX_WAITERS set once <mutex> tracks the owner, i.e. once the
+ * mutex was contended. Threads take and release it in user mode while it
+ * is clear; this is called when that fails.
+ */
+int z_mutex_lock_word(struct k_mutex *mutex, atomic_t *val,
+		      k_timeout_t timeout)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct k_thread *owner;
+	atomic_val_t v;
+	int ret;
+
+	for (;;) {
+		if (atomic_cas(val, 0, (atomic_val_t)_current)) {
+			k_spin_unlock(&lock, key);
+			return 0;
+		}
+
+		v = atomic_get(val);
+		owner = (struct k_thread *)(v & ~SYS_MUTEX_WAITERS);
+
+		if ((v & SYS_MUTEX_WAITERS) != 0) {
+			break;
+		}
+
+		ret = lock_word_owner_check(owner);
+		if (ret != 0) {
+			k_spin_unlock(&lock, key);
+			return ret;
+		}
+
+		/* Hand ownership over to <mutex> */
+		if (atomic_cas(val, v, v | SYS_MUTEX_WAITERS)) {
+			mutex->owner = owner;
+			mutex->owner_orig_prio = owner->base.prio;
+			mutex->lock_count = 1U;
+			break;
+		}
+	}
+
+	if (owner == _current) {
+		mutex->lock_count++;
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	return mutex_pend(mutex, key, timeout);
+}
+
+int z_mutex_unlock_word(struct k_mutex *mutex, atomic_t *val)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	atomic_val_t v = atomic_get(val);
+	struct k_thread *new_owner;
+
+	if ((struct k_thread *)(v & ~SYS_MUTEX_WAITERS) != _current) {
+		k_spin_unlock(&lock, key);
+		return (v == 0) ? -EINVAL : -EPERM;
+	}
+
+	if ((v & SYS_MUTEX_WAITERS) == 0) {
+		atomic_clear(val);
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	adjust_owner_prio(mutex, mutex->owner_orig_prio);
+
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+	mutex->owner = new_owner;
+
+	if (new_owner != NULL) {
+		mutex->owner_orig_prio = new_owner->base.prio;
+		atomic_set(val, (atomic_val_t)new_owner | SYS_MUTEX_WAITERS);
+		arch_thread_return_value_set(new_owner, 0);
+		z_ready_thread(new_owner);
+		z_reschedule(&lock, key);
+	} else {
+		mutex->lock_count = 0U;
+		atomic_clear(val);
+		k_spin_unlock(&lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static int init_mutex_obj_core_list(void)
 {
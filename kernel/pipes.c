@@ -46,6 +46,11 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
+#ifdef CONFIG_PIPE_ZERO_COPY
+	z_waitq_init(&pipe->wait_q.zc);
+	pipe->reserved = 0U;
+	pipe->claimed = 0U;
+#endif /* CONFIG_PIPE_ZERO_COPY */
 	SYS_PORT_TRACING_OBJ_INIT(k_pipe, pipe);
 
 	pipe->flags = 0;
@@ -105,6 +110,106 @@ static inline void handle_poll_events(struct k_pipe *pipe)
 #endif /* CONFIG_POLL */
 }
 
+#ifdef CONFIG_PIPE_ZERO_COPY
+/* Space reserved by k_pipe_put_reserve() starts at write_index, and data
+ * claimed by k_pipe_get_peek() at read_index. Copying writers wait while
+ * space is reserved, and copying readers while data is claimed, so that
+ * the byte stream stays in order. Those waits, and all waits of zero-copy
+ * users, happen on wait_q.zc and are retried on every change.
+ */
+static inline size_t zc_reserved(struct k_pipe *pipe)
+{
+	return pipe->reserved;
+}
+
+static inline size_t zc_claimed(struct k_pipe *pipe)
+{
+	return pipe->claimed;
+}
+
+static int zc_pend(struct k_pipe *pipe, k_spinlock_key_t *key,
+		   k_timepoint_t end)
+{
+	k_timeout_t timeout = sys_timepoint_timeout(end);
+	int ret;
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EAGAIN;
+	}
+
+	ret = z_pend_curr(&pipe->lock, *key, &pipe->wait_q.zc, timeout);
+	*key = k_spin_lock(&pipe->lock);
+
+	return ret;
+}
+
+/* Wait until no zero-copy access is outstanding on the @a writer side */
+static int zc_wait_idle(struct k_pipe *pipe, k_spinlock_key_t *key,
+			k_timeout_t *timeout, bool writer)
+{
+	size_t *busy = writer ? &pipe->reserved : &pipe->claimed;
+	k_timepoint_t end;
+	int ret = 0;
+
+	if (*busy == 0U) {
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+		return -EIO;
+	}
+
+	end = sys_timepoint_calc(*timeout);
+	while ((*busy != 0U) && (ret == 0)) {
+		ret = zc_pend(pipe, key, end);
+	}
+	*timeout = sys_timepoint_timeout(end);
+
+	return ret;
+}
+
+static inline bool zc_wake(struct k_pipe *pipe)
+{
+	if (z_waitq_head(&pipe->wait_q.zc) == NULL) {
+		return false;
+	}
+
+	return z_sched_wake_all(&pipe->wait_q.zc, 0, NULL);
+}
+#else
+static inline size_t zc_reserved(struct k_pipe *pipe)
+{
+	ARG_UNUSED(pipe);
+
+	return 0U;
+}
+
+static inline size_t zc_claimed(struct k_pipe *pipe)
+{
+	ARG_UNUSED(pipe);
+
+	return 0U;
+}
+
+static inline int zc_wait_idle(struct k_pipe *pipe, k_spinlock_key_t *key,
+			       k_timeout_t *timeout, bool writer)
+{
+	ARG_UNUSED(pipe);
+	ARG_UNUSED(key);
+	ARG_UNUSED(timeout);
+	ARG_UNUSED(writer);
+
+	return 0;
+}
+
+static inline bool zc_wake(struct k_pipe *pipe)
+{
+	ARG_UNUSED(pipe);
+
+	return false;
+}
+#endif /* CONFIG_PIPE_ZERO_COPY */
+
 void z_impl_k_pipe_flush(struct k_pipe *pipe)
 {
 	size_t  bytes_read;
@@ -137,7 +242,8 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	if (pipe->buffer != NULL) {
+	/* data claimed in place is not flushed */
+	if ((pipe->buffer != NULL) && (zc_claimed(pipe) == 0U)) {
 		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
 					 &bytes_read, 0U, K_NO_WAIT);
 	} else {
@@ -406,6 +512,17 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	int rc = zc_wait_idle(pipe, &key, &timeout, true);
+
+	if (rc != 0) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0U;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, rc);
+
+		return rc;
+	}
+
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
@@ -460,6 +577,7 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, const void *data,
 
 	if ((pipe->bytes_used != 0U) && (*bytes_written != 0U)) {
 		handle_poll_events(pipe);
+		reschedule_needed = zc_wake(pipe) || reschedule_needed;
 	}
 
 	/*
@@ -528,6 +646,46 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, const void *data,
 #include <zephyr/syscalls/k_pipe_put_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/**
+ * @brief Refill the pipe buffer from waiting writers
+ *
+ * Writers whose data has all been moved into the buffer are woken up.
+ */
+static void pipe_buffer_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	struct k_thread    *thread;
+	sys_dlist_t         src_list;
+	sys_dlist_t         pipe_list;
+
+	if ((pipe->bytes_used == pipe->size) || (zc_reserved(pipe) != 0U)) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+
+	for (thread = z_waitq_head(&pipe->wait_q.writers);
+	     (thread != NULL) &&
+	     (((struct _pipe_desc *)thread->base.swap_data)->bytes_to_xfer == 0U);
+	     thread = z_waitq_head(&pipe->wait_q.writers)) {
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		*reschedule = true;
+	}
+}
+
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 			     void *data, size_t bytes_to_read,
 			     size_t *bytes_read, size_t min_xfer,
@@ -552,7 +710,8 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 
 	sys_dlist_init(&src_list);
 
-	if (pipe->bytes_used != 0) {
+	/* Only a flush gets here while data is claimed. It leaves it alone. */
+	if ((pipe->bytes_used != 0) && (zc_claimed(pipe) == 0U)) {
 		bytes_can_read = pipe_buffer_list_populate(&src_list,
 							   pipe_desc,
 							   pipe->buffer,
@@ -625,28 +784,10 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
+	pipe_buffer_refill(pipe, &reschedule_needed);
 
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
-
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
+	if (num_bytes_read != 0U) {
+		reschedule_needed = zc_wake(pipe) || reschedule_needed;
 	}
 
 	/*
@@ -713,8 +854,19 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
-				    min_xfer, timeout);
+	int ret = zc_wait_idle(pipe, &key, &timeout, false);
+
+	if (ret != 0) {
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0U;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
+
+		return ret;
+	}
+
+	ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
+				min_xfer, timeout);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
 
@@ -756,6 +908,7 @@ size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 	} else {
 		res = pipe->size - (pipe->read_index - pipe->write_index);
 	}
+	res -= zc_claimed(pipe);
 
 	k_spin_unlock(&pipe->lock, key);
 
@@ -793,6 +946,7 @@ size_t z_impl_k_pipe_write_avail(struct k_pipe *pipe)
 	} else {
 		res = pipe->size - (pipe->write_index - pipe->read_index);
 	}
+	res -= zc_reserved(pipe);
 
 	k_spin_unlock(&pipe->lock, key);
 
@@ -810,6 +964,281 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 #include <zephyr/syscalls/k_pipe_write_avail_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_PIPE_ZERO_COPY
+static inline void pipe_index_advance(struct k_pipe *pipe, size_t *index,
+				      size_t bytes)
+{
+	*index += bytes;
+	if (*index >= pipe->size) {
+		*index -= pipe->size;
+	}
+}
+
+/* Contiguous free bytes at write_index, or 0 if space is reserved */
+static size_t zc_write_span(struct k_pipe *pipe)
+{
+	if (pipe->reserved != 0U) {
+		return 0U;
+	}
+
+	if (pipe->bytes_used == 0U) {
+		/* rewind, so that the whole buffer is contiguous */
+		pipe->read_index = 0U;
+		pipe->write_index = 0U;
+	}
+
+	if (pipe->bytes_used == pipe->size) {
+		return 0U;
+	}
+
+	if (pipe->write_index >= pipe->read_index) {
+		return pipe->size - pipe->write_index;
+	}
+
+	return pipe->read_index - pipe->write_index;
+}
+
+/* Contiguous data bytes at read_index, or 0 if data is claimed */
+static size_t zc_read_span(struct k_pipe *pipe)
+{
+	if ((pipe->claimed != 0U) || (pipe->bytes_used == 0U)) {
+		return 0U;
+	}
+
+	if (pipe->read_index < pipe->write_index) {
+		return pipe->write_index - pipe->read_index;
+	}
+
+	return pipe->size - pipe->read_index;
+}
+
+/**
+ * @brief Copy buffered data to readers waiting on an empty buffer
+ *
+ * @return true if a reader was woken up
+ */
+static bool pipe_buffer_to_readers(struct k_pipe *pipe)
+{
+	struct _pipe_desc *dest;
+	sys_dlist_t        dest_list;
+	size_t             bytes_copied;
+	bool               reschedule = false;
+
+	sys_dlist_init(&dest_list);
+	(void) pipe_waiter_list_populate(&dest_list, &pipe->wait_q.readers,
+					 pipe->bytes_used);
+
+	dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+	while ((dest != NULL) && (zc_read_span(pipe) != 0U)) {
+		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
+					 &pipe->buffer[pipe->read_index],
+					 zc_read_span(pipe));
+
+		dest->buffer        += bytes_copied;
+		dest->bytes_to_xfer -= bytes_copied;
+
+		pipe->bytes_used -= bytes_copied;
+		pipe_index_advance(pipe, &pipe->read_index, bytes_copied);
+
+		if (dest->bytes_to_xfer == 0U) {
+			z_unpend_thread(dest->thread);
+			z_ready_thread(dest->thread);
+			reschedule = true;
+
+			dest = (struct _pipe_desc *)sys_dlist_get(&dest_list);
+		}
+	}
+
+	return reschedule;
+}
+
+int z_impl_k_pipe_put_reserve(struct k_pipe *pipe, void **data, size_t *len,
+			      k_timeout_t timeout)
+{
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	size_t span;
+	int ret = 0;
+
+	CHECKIF((pipe->buffer == NULL) || (*len == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	span = zc_write_span(pipe);
+	if ((span == 0U) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		ret = -EIO;
+	}
+
+	while ((ret == 0) && (span == 0U)) {
+		ret = zc_pend(pipe, &key, end);
+		span = zc_write_span(pipe);
+	}
+
+	if (ret == 0) {
+		pipe->reserved = MIN(*len, span);
+		*data = &pipe->buffer[pipe->write_index];
+		*len = pipe->reserved;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_reserve(struct k_pipe *pipe, void **data, size_t *len,
+			      k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(len, sizeof(*len)));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_put_reserve(pipe, data, len, timeout);
+}
+#include <zephyr/syscalls/k_pipe_put_reserve_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_pipe_put_commit(struct k_pipe *pipe, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool reschedule_needed;
+
+	if ((pipe->reserved == 0U) || (len > pipe->reserved)) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->reserved = 0U;
+	pipe->bytes_used += len;
+	pipe_index_advance(pipe, &pipe->write_index, len);
+
+	reschedule_needed = pipe_buffer_to_readers(pipe);
+
+	if ((pipe->bytes_used != 0U) && (len != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	reschedule_needed = zc_wake(pipe) || reschedule_needed;
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_commit(struct k_pipe *pipe, size_t len)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_put_commit(pipe, len);
+}
+#include <zephyr/syscalls/k_pipe_put_commit_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_pipe_get_peek(struct k_pipe *pipe, void **data, size_t *len,
+			   k_timeout_t timeout)
+{
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	size_t span;
+	int ret = 0;
+
+	CHECKIF((pipe->buffer == NULL) || (*len == 0U)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	span = zc_read_span(pipe);
+	if ((span == 0U) && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		ret = -EIO;
+	}
+
+	while ((ret == 0) && (span == 0U)) {
+		ret = zc_pend(pipe, &key, end);
+		span = zc_read_span(pipe);
+	}
+
+	if (ret == 0) {
+		pipe->claimed = MIN(*len, span);
+		*data = &pipe->buffer[pipe->read_index];
+		*len = pipe->claimed;
+	}
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_peek(struct k_pipe *pipe, void **data, size_t *len,
+			   k_timeout_t timeout)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	K_OOPS(K_SYSCALL_MEMORY_WRITE(len, sizeof(*len)));
+	K_OOPS(K_SYSCALL_MEMORY_READ(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_get_peek(pipe, data, len, timeout);
+}
+#include <zephyr/syscalls/k_pipe_get_peek_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_k_pipe_get_release(struct k_pipe *pipe, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool reschedule_needed = false;
+
+	if ((pipe->claimed == 0U) || (len > pipe->claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->claimed = 0U;
+	pipe->bytes_used -= len;
+	pipe_index_advance(pipe, &pipe->read_index, len);
+
+	pipe_buffer_refill(pipe, &reschedule_needed);
+
+	if (pipe->bytes_used != 0U) {
+		handle_poll_events(pipe);
+	}
+
+	reschedule_needed = zc_wake(pipe) || reschedule_needed;
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_release(struct k_pipe *pipe, size_t len)
+{
+	K_OOPS(K_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_get_release(pipe, len);
+}
+#include <zephyr/syscalls/k_pipe_get_release_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_PIPE_ZERO_COPY */
+
 #ifdef CONFIG_OBJ_CORE_PIPE
 static int init_pipe_obj_core_list(void)
 {
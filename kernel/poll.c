@@ -35,10 +35,13 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+#ifdef CONFIG_POLL_SET
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
+#endif
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -82,7 +85,8 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 		}
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
-		if (event->msgq->used_msgs > 0) {
+		if ((event->msgq->used_msgs > 0) &&
+		    ((event->msgq->flags & K_MSGQ_FLAG_CLAIMED) == 0U)) {
 			*state = K_POLL_STATE_MSGQ_DATA_AVAILABLE;
 			return true;
 		}
@@ -109,22 +113,37 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Whether <poller> is to be notified before <pending> */
+static inline bool poller_precedes(struct z_poller *poller,
+				   struct z_poller *pending)
+{
+#ifdef CONFIG_POLL_SET
+	/* Poll sets have no priority, they come after the threads */
+	if (poller->mode == MODE_SET) {
+		return false;
+	}
+	if (pending->mode == MODE_SET) {
+		return true;
+	}
+#endif /* CONFIG_POLL_SET */
+
+	return z_sched_prio_cmp(poller_thread(poller),
+				poller_thread(pending)) > 0;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || !poller_precedes(poller, pending->poller)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_precedes(poller, pending->poller)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -443,6 +462,12 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+#ifdef CONFIG_POLL_SET
+	if ((poller != NULL) && (poller->mode == MODE_SET)) {
+		return signal_poll_set(event, state);
+	}
+#endif /* CONFIG_POLL_SET */
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -813,3 +838,174 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+#ifdef CONFIG_POLL_SET
+/*
+ * The events of a poll set stay registered on their objects. When an object
+ * signals one of them, it is registered again and queued on the ready list
+ * of the set. Waiting on the set only checks the events on the ready list:
+ * the events still ready are returned and stay queued, the others leave the
+ * list until their object signals them again.
+ */
+
+static struct k_poll_set *poll_set(struct z_poller *poller)
+{
+	return CONTAINER_OF(poller, struct k_poll_set, poller);
+}
+
+/* must be called with interrupts locked */
+static void poll_set_ready(struct k_poll_set *set, struct k_poll_event *event,
+			   uint32_t state)
+{
+	if (sys_dnode_is_linked(&event->_ready_node)) {
+		event->state |= state;
+		return;
+	}
+
+	event->state = state;
+	sys_dlist_append(&set->ready, &event->_ready_node);
+	(void)z_sched_wake_all(&set->wait_q, 0, NULL);
+}
+
+/* must be called with interrupts locked */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct z_poller *poller = event->poller;
+
+	/* The object took the event off its list to signal it */
+	register_event(event, poller);
+	poll_set_ready(poll_set(poller), event, state);
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	sys_dnode_init(&event->_ready_node);
+	event->state = K_POLL_STATE_NOT_READY;
+	register_event(event, &set->poller);
+
+	if (is_condition_met(event, &state)) {
+		poll_set_ready(set, event, state);
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	clear_event_registration(event);
+	if (sys_dnode_is_linked(&event->_ready_node)) {
+		sys_dlist_remove(&event->_ready_node);
+	}
+	event->state = K_POLL_STATE_NOT_READY;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static int poll_set_collect(struct k_poll_set *set, struct k_poll_event **events,
+			    int max_events)
+{
+	sys_dlist_t again = SYS_DLIST_STATIC_INIT(&again);
+	struct k_poll_event *event;
+	sys_dnode_t *node;
+	uint32_t state;
+	int count = 0;
+
+	while ((count < max_events) &&
+	       ((node = sys_dlist_get(&set->ready)) != NULL)) {
+		event = CONTAINER_OF(node, struct k_poll_event, _ready_node);
+
+		if (!is_condition_met(event, &state)) {
+			state = K_POLL_STATE_NOT_READY;
+		}
+
+		/* A cancellation is only reported once */
+		if ((event->state & K_POLL_STATE_CANCELLED) != 0U) {
+			event->state = state | K_POLL_STATE_CANCELLED;
+		} else if (state != K_POLL_STATE_NOT_READY) {
+			event->state = state;
+			sys_dlist_append(&again, node);
+		} else {
+			event->state = K_POLL_STATE_NOT_READY;
+			continue;
+		}
+
+		events[count] = event;
+		count++;
+	}
+
+	/* Events returned are checked again after the ones not looked at */
+	while ((node = sys_dlist_get(&again)) != NULL) {
+		sys_dlist_append(&set->ready, node);
+	}
+
+	return count;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "");
+	__ASSERT(events != NULL, "NULL events\n");
+	__ASSERT(max_events > 0, "no room for events\n");
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		ret = poll_set_collect(set, events, max_events);
+		if (ret > 0) {
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		ret = z_pend_curr(&lock, key, &set->wait_q,
+				  sys_timepoint_timeout(end));
+		if (ret != 0) {
+			return ret;
+		}
+
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+#endif /* CONFIG_POLL_SET */
@@ -39,6 +39,21 @@ static ALWAYS_INLINE void update_cache(int preempt_ok);
 static void halt_thread(struct k_thread *thread, uint8_t new_state);
 static void add_to_waitq_locked(struct k_thread *thread, _wait_q_t *wait_q);
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static void cbs_wakeup_locked(struct k_thread *thread);
+static void cbs_release_locked(struct k_thread *thread);
+#else
+static inline void cbs_wakeup_locked(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+
+static inline void cbs_release_locked(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 
 BUILD_ASSERT(CONFIG_NUM_COOP_PRIORITIES >= CONFIG_NUM_METAIRQ_PRIORITIES,
 	     "You need to provide at least as many CONFIG_NUM_COOP_PRIORITIES as "
@@ -64,6 +79,18 @@ int32_t z_sched_prio_cmp(struct k_thread *thread_1,
 		return b2 - b1;
 	}
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	/* Threads with a bandwidth reservation form the EDF class,
+	 * which runs ahead of best-effort threads of the same priority.
+	 */
+	bool s1 = thread_1->base.cbs_period != 0U;
+	bool s2 = thread_2->base.cbs_period != 0U;
+
+	if (s1 != s2) {
+		return s1 ? 1 : -1;
+	}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_SCHED_DEADLINE
 	/* If we assume all deadlines live within the same "half" of
 	 * the 32 bit modulus space (this is a documented API rule),
@@ -101,6 +128,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.rq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -109,17 +138,277 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Per-CPU run queues.  A queued thread lives in exactly one CPU's
+ * queue (base.rq_cpu), chosen when it is added.  CPUs only pick from
+ * their own queue, except when they are about to go idle, in which
+ * case they pull the best thread they can run from the other queues.
+ * The periodic balancer evens out queue lengths between ticks.  All
+ * of this runs under _sched_spinlock.
+ */
+static uint32_t balance_ticks =
+	DIV_ROUND_UP(CONFIG_SCHED_CPU_RUNQ_BALANCE_MS * Z_HZ_ticks, Z_HZ_ms);
+static uint32_t balance_elapsed;
+
+static inline bool cpu_runq_usable(struct k_thread *thread, int cpu)
+{
+	/* CPUs that have not been started yet have no current thread */
+	if (_kernel.cpus[cpu].current == NULL) {
+		return false;
+	}
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+/* True if <thread> should displace whatever <cpu> is running now */
+static bool cpu_runq_preempts(int cpu, struct k_thread *thread)
+{
+	struct k_thread *curr = _kernel.cpus[cpu].current;
+
+	if (curr == NULL) {
+		return false;
+	}
+
+	if (z_is_idle_thread_object(curr) ||
+	    z_is_thread_prevented_from_running(curr) ||
+	    thread_is_metairq(thread)) {
+		return true;
+	}
+
+	return (z_sched_prio_cmp(thread, curr) > 0) && thread_is_preemptible(curr);
+}
+
+/* Choose the run queue for a thread about to be queued: the CPU it
+ * last ran on if it would run there right away (cache affinity),
+ * otherwise the usable CPU running the lowest priority thread it can
+ * preempt.  Failing both it stays on its last CPU.  The owning CPU is
+ * the only one flagged for an IPI.
+ */
+static void cpu_runq_place(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int home = thread->base.cpu;
+	int target = -1;
+
+	if ((home >= num_cpus) || !cpu_runq_usable(thread, home)) {
+		home = 0;
+		for (int i = 0; i < num_cpus; i++) {
+			if (cpu_runq_usable(thread, i)) {
+				home = i;
+				break;
+			}
+		}
+	}
+
+	if (cpu_runq_preempts(home, thread)) {
+		target = home;
+	} else {
+		for (int i = 0; i < num_cpus; i++) {
+			if ((i == home) || !cpu_runq_usable(thread, i) ||
+			    !cpu_runq_preempts(i, thread)) {
+				continue;
+			}
+
+			if ((target < 0) ||
+			    (z_sched_prio_cmp(_kernel.cpus[target].current,
+					      _kernel.cpus[i].current) > 0)) {
+				target = i;
+			}
+		}
+	}
+
+	if (target >= 0) {
+		if (target != _current_cpu->id) {
+			flag_ipi(BIT(target));
+		}
+	} else {
+		target = home;
+	}
+
+	thread->base.rq_cpu = target;
+	_kernel.cpus[target].nr_ready++;
+}
+
+static inline void cpu_runq_leave(struct k_thread *thread)
+{
+	_kernel.cpus[thread->base.rq_cpu].nr_ready--;
+}
+
+/* Best thread in <from>'s queue that may run on <to>, or NULL */
+static struct k_thread *cpu_runq_pick(int from, int to)
+{
+	void *runq = &_kernel.cpus[from].ready_q.runq;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	struct k_thread *thread;
+
+	SYS_DLIST_FOR_EACH_CONTAINER((sys_dlist_t *)runq, thread, base.qnode_dlist) {
+		if ((thread->base.cpu_mask & BIT(to)) != 0) {
+			return thread;
+		}
+	}
+	return NULL;
+#else
+	ARG_UNUSED(to);
+	return _priq_run_best(runq);
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+static void cpu_runq_migrate(struct k_thread *thread, int cpu)
+{
+	_priq_run_remove(thread_runq(thread), thread);
+	_kernel.cpus[thread->base.rq_cpu].nr_ready--;
+
+	thread->base.rq_cpu = cpu;
+
+	_priq_run_add(thread_runq(thread), thread);
+	_kernel.cpus[cpu].nr_ready++;
+}
+
+/* Idle-time balancing: called when the local queue is empty.  If
+ * _current cannot keep running, or is yielding, pull the highest
+ * priority thread this CPU may run from the other queues (ties go to
+ * the longest queue).  Preemption of a running _current needs no pull,
+ * placement already put any thread that should preempt it here.
+ */
+static struct k_thread *cpu_runq_steal(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int self = _current_cpu->id;
+	int from = -1;
+	struct k_thread *best = NULL;
+	bool yielding = false;
+
+	if (!z_is_idle_thread_object(_current) &&
+	    !z_is_thread_prevented_from_running(_current)) {
+		if (!_current_cpu->swap_ok) {
+			return NULL;
+		}
+		yielding = true;
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *thread;
+
+		if ((i == self) || (_kernel.cpus[i].nr_ready == 0U)) {
+			continue;
+		}
+
+		thread = cpu_runq_pick(i, self);
+		if (thread == NULL) {
+			continue;
+		}
+
+		if ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0) ||
+		    ((z_sched_prio_cmp(thread, best) == 0) &&
+		     (_kernel.cpus[i].nr_ready > _kernel.cpus[from].nr_ready))) {
+			best = thread;
+			from = i;
+		}
+	}
+
+	/* A yielding thread only gives way to its equals or betters */
+	if ((best != NULL) && yielding && (z_sched_prio_cmp(best, _current) < 0)) {
+		best = NULL;
+	}
+
+	if (best != NULL) {
+		cpu_runq_migrate(best, self);
+	}
+
+	return best;
+}
+
+/* Periodic balancing, driven from the timer interrupt: every
+ * CONFIG_SCHED_CPU_RUNQ_BALANCE_MS move threads from the longest
+ * queue to the shortest until their lengths differ by at most one.
+ */
+void z_sched_cpu_runq_balance(int32_t ticks)
+{
+	if (balance_ticks == 0U) {
+		return;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		unsigned int num_cpus = arch_num_cpus();
+		int busiest = -1, idlest = -1;
+		uint32_t moves;
+
+		balance_elapsed += ticks;
+		if (balance_elapsed < balance_ticks) {
+			K_SPINLOCK_BREAK;
+		}
+		balance_elapsed = 0U;
+
+		for (int i = 0; i < num_cpus; i++) {
+			if (_kernel.cpus[i].current == NULL) {
+				continue;
+			}
+			if ((busiest < 0) ||
+			    (_kernel.cpus[i].nr_ready > _kernel.cpus[busiest].nr_ready)) {
+				busiest = i;
+			}
+			if ((idlest < 0) ||
+			    (_kernel.cpus[i].nr_ready < _kernel.cpus[idlest].nr_ready)) {
+				idlest = i;
+			}
+		}
+
+		if ((busiest < 0) || (busiest == idlest)) {
+			K_SPINLOCK_BREAK;
+		}
+
+		moves = (_kernel.cpus[busiest].nr_ready - _kernel.cpus[idlest].nr_ready) / 2U;
+
+		for (; moves > 0U; moves--) {
+			struct k_thread *thread = cpu_runq_pick(busiest, idlest);
+
+			if (thread == NULL) {
+				break;
+			}
+
+			cpu_runq_migrate(thread, idlest);
+			if ((idlest != _current_cpu->id) &&
+			    cpu_runq_preempts(idlest, thread)) {
+				flag_ipi(BIT(idlest));
+			}
+		}
+	}
+
+	signal_pending_ipi();
+}
+#else
+static inline void cpu_runq_place(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
 }
 
+static inline void cpu_runq_leave(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+}
+
+static inline struct k_thread *cpu_runq_steal(void)
+{
+	return NULL;
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+	cpu_runq_place(thread);
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -128,11 +417,18 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
 	_priq_run_remove(thread_runq(thread), thread);
+	cpu_runq_leave(thread);
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
-	return _priq_run_best(curr_cpu_runq());
+	struct k_thread *thread = _priq_run_best(curr_cpu_runq());
+
+	if (thread == NULL) {
+		thread = cpu_runq_steal();
+	}
+
+	return thread;
 }
 
 /* _current is never in the run queue until context switch on
@@ -382,6 +678,7 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		cbs_wakeup_locked(thread);
 		queue_thread(thread);
 		update_cache(0);
 
@@ -398,6 +695,53 @@ void z_ready_thread(struct k_thread *thread)
 	}
 }
 
+/* State of a batched wake.  Waking several threads with ready_thread()
+ * searches the run queue from its head, recomputes the next thread to
+ * run and flags IPIs once per thread.  A batch inserts threads taken
+ * from a wait queue, which come out by decreasing priority, after the
+ * previous one, and does the rest once when it is done.
+ */
+struct wake_batch {
+	struct k_thread *last;
+	atomic_val_t ipi_mask;
+	int woken;
+};
+
+static void batch_ready_thread(struct wake_batch *batch, struct k_thread *thread)
+{
+	batch->woken++;
+
+	if (z_is_thread_queued(thread) || !z_is_thread_ready(thread)) {
+		return;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
+
+	cbs_wakeup_locked(thread);
+	thread->base.thread_state |= _THREAD_QUEUED;
+	if (should_queue_thread(thread)) {
+		cpu_runq_place(thread);
+		if ((batch->last != NULL) &&
+		    (thread_runq(batch->last) == thread_runq(thread)) &&
+		    (z_sched_prio_cmp(thread, batch->last) <= 0)) {
+			_priq_run_add_after(thread_runq(thread), batch->last, thread);
+		} else {
+			_priq_run_add(thread_runq(thread), thread);
+		}
+		batch->last = thread;
+	}
+
+	batch->ipi_mask |= ipi_mask_create(thread);
+}
+
+static void batch_finish(struct wake_batch *batch)
+{
+	if (batch->woken != 0) {
+		update_cache(0);
+		flag_ipi(batch->ipi_mask);
+	}
+}
+
 void z_move_thread_to_end_of_prio_q(struct k_thread *thread)
 {
 	K_SPINLOCK(&_sched_spinlock) {
@@ -802,13 +1146,24 @@ static inline bool need_swap(void)
 #endif /* CONFIG_SMP */
 }
 
+/* Signal IPIs flagged by a reschedule point which does not switch. With
+ * CONFIG_IPI_COALESCE, in an ISR they are left for the interrupt exit,
+ * where z_get_next_switch_handle() sends all of them together.
+ */
+static inline void resched_signal_ipi(void)
+{
+	if (!IS_ENABLED(CONFIG_IPI_COALESCE) || !arch_is_in_isr()) {
+		signal_pending_ipi();
+	}
+}
+
 void z_reschedule(struct k_spinlock *lock, k_spinlock_key_t key)
 {
 	if (resched(key.key) && need_swap()) {
 		z_swap(lock, key);
 	} else {
 		k_spin_unlock(lock, key);
-		signal_pending_ipi();
+		resched_signal_ipi();
 	}
 }
 
@@ -818,7 +1173,7 @@ void z_reschedule_irqlock(uint32_t key)
 		z_swap_irqlock(key);
 	} else {
 		irq_unlock(key);
-		signal_pending_ipi();
+		resched_signal_ipi();
 	}
 }
 
@@ -935,10 +1290,6 @@ void *z_get_next_switch_handle(void *interrupted)
 			new_thread->base.cpu = cpu_id;
 			set_current(new_thread);
 
-#ifdef CONFIG_TIMESLICING
-			z_reset_time_slice(new_thread);
-#endif /* CONFIG_TIMESLICING */
-
 #ifdef CONFIG_SPIN_VALIDATE
 			/* Changed _current!  Update the spinlock
 			 * bookkeeping so the validation doesn't get
@@ -963,6 +1314,14 @@ void *z_get_next_switch_handle(void *interrupted)
 #endif
 				runq_add(old_thread);
 			}
+
+			/* After the requeue: with CONFIG_SCHED_DEADLINE_CBS
+			 * this charges old_thread, which may move it in
+			 * the run queue.
+			 */
+#ifdef CONFIG_TIMESLICING
+			z_reset_time_slice(new_thread);
+#endif /* CONFIG_TIMESLICING */
 		}
 		old_thread->switch_handle = interrupted;
 		ret = new_thread->switch_handle;
@@ -982,18 +1341,39 @@ void *z_get_next_switch_handle(void *interrupted)
 }
 #endif /* CONFIG_USE_SWITCH */
 
-int z_unpend_all(_wait_q_t *wait_q)
+/* Unpend and ready every thread on <wait_q> as one batch.  Ends with
+ * the same state as a z_unpend_thread()/z_ready_thread() loop.
+ */
+static int wake_all_locked(_wait_q_t *wait_q, bool set_value, int swap_retval,
+			   void *swap_data)
 {
-	int need_sched = 0;
+	struct wake_batch batch = { 0 };
 	struct k_thread *thread;
 
-	for (thread = z_waitq_head(wait_q); thread != NULL; thread = z_waitq_head(wait_q)) {
-		z_unpend_thread(thread);
-		z_ready_thread(thread);
-		need_sched = 1;
+	while ((thread = _priq_wait_best(&wait_q->waitq)) != NULL) {
+		if (set_value) {
+			z_thread_return_value_set_with_data(thread, swap_retval,
+							    swap_data);
+		}
+		unpend_thread_no_timeout(thread);
+		(void)z_abort_thread_timeout(thread);
+		batch_ready_thread(&batch, thread);
 	}
 
-	return need_sched;
+	batch_finish(&batch);
+
+	return batch.woken;
+}
+
+int z_unpend_all(_wait_q_t *wait_q)
+{
+	int woken = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		woken = wake_all_locked(wait_q, false, 0, NULL);
+	}
+
+	return (woken != 0) ? 1 : 0;
 }
 
 void init_ready_q(struct _ready_q *ready_q)
@@ -1005,7 +1385,7 @@ void init_ready_q(struct _ready_q *ready_q)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(ready_q->runq.queues); i++) {
 		sys_dlist_init(&ready_q->runq.queues[i]);
 	}
 #else
@@ -1015,13 +1395,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -1057,6 +1437,28 @@ static inline void z_vrfy_k_thread_priority_set(k_tid_t thread, int prio)
 #endif /* CONFIG_USERSPACE */
 
 #ifdef CONFIG_SCHED_DEADLINE
+/* The prio_deadline field changes the sorting order, so can't change
+ * it while the thread is in the run queue or pended on a wait queue
+ * (dlists actually are benign as long as we requeue it before we
+ * release the lock, but an rbtree will blow up if we break sorting!)
+ */
+static void deadline_set_locked(struct k_thread *thread, int32_t deadline)
+{
+	_wait_q_t *wait_q = thread->base.pended_on;
+
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+		thread->base.prio_deadline = deadline;
+		queue_thread(thread);
+	} else if (wait_q != NULL) {
+		_priq_wait_remove(&wait_q->waitq, thread);
+		thread->base.prio_deadline = deadline;
+		_priq_wait_add(&wait_q->waitq, thread);
+	} else {
+		thread->base.prio_deadline = deadline;
+	}
+}
+
 void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 
@@ -1065,20 +1467,8 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 	struct k_thread *thread = tid;
 	int32_t newdl = k_cycle_get_32() + deadline;
 
-	/* The prio_deadline field changes the sorting order, so can't
-	 * change it while the thread is in the run queue (dlists
-	 * actually are benign as long as we requeue it before we
-	 * release the lock, but an rbtree will blow up if we break
-	 * sorting!)
-	 */
 	K_SPINLOCK(&_sched_spinlock) {
-		if (z_is_thread_queued(thread)) {
-			dequeue_thread(thread);
-			thread->base.prio_deadline = newdl;
-			queue_thread(thread);
-		} else {
-			thread->base.prio_deadline = newdl;
-		}
+		deadline_set_locked(thread, newdl);
 	}
 }
 
@@ -1098,6 +1488,136 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_SCHED_DEADLINE */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Reserved bandwidth is tracked in units of 2^-CBS_BW_SHIFT CPUs */
+#define CBS_BW_SHIFT 20
+
+/* Sum of the bandwidth of all reservations, under _sched_spinlock */
+static uint64_t cbs_bandwidth;
+
+static inline uint64_t cbs_bw(struct k_thread *thread)
+{
+	if (thread->base.cbs_period == 0U) {
+		return 0;
+	}
+
+	return ((uint64_t)thread->base.cbs_runtime << CBS_BW_SHIFT) /
+	       thread->base.cbs_period;
+}
+
+/* CBS wakeup rule: a thread becoming ready keeps its current deadline
+ * and remaining budget only if serving that budget before the deadline
+ * would not exceed its reserved bandwidth.  Otherwise it starts a fresh
+ * period now.  Invoked with _sched_spinlock held, on a thread that is
+ * not queued.
+ */
+static void cbs_wakeup_locked(struct k_thread *thread)
+{
+	struct _thread_base *base = &thread->base;
+	uint32_t now = k_cycle_get_32();
+	int32_t left = (int32_t)((uint32_t)base->prio_deadline - now);
+
+	if (base->cbs_period == 0U) {
+		return;
+	}
+
+	if ((left <= 0) ||
+	    ((uint64_t)MAX(base->cbs_budget, 0) * base->cbs_period >=
+	     (uint64_t)left * base->cbs_runtime)) {
+		base->prio_deadline = (int32_t)(now + base->cbs_period);
+		base->cbs_budget = (int32_t)base->cbs_runtime;
+	}
+}
+
+static void cbs_release_locked(struct k_thread *thread)
+{
+	cbs_bandwidth -= cbs_bw(thread);
+	thread->base.cbs_runtime = 0U;
+	thread->base.cbs_period = 0U;
+	z_cbs_thread_exit(thread);
+}
+
+/* Charge <cycles> of execution to <thread>'s server.  Each time its
+ * budget runs out it is recharged and the deadline postponed by one
+ * period, which is what keeps an overrunning thread from starving the
+ * others.  Returns true if that happened.  Invoked with
+ * _sched_spinlock held.
+ */
+bool z_sched_cbs_charge(struct k_thread *thread, uint32_t cycles)
+{
+	struct _thread_base *base = &thread->base;
+	int64_t budget = (int64_t)base->cbs_budget - cycles;
+	uint32_t periods;
+
+	if ((base->cbs_period == 0U) || (budget > 0)) {
+		base->cbs_budget = (int32_t)budget;
+		return false;
+	}
+
+	periods = (uint32_t)(-budget / base->cbs_runtime) + 1U;
+	base->cbs_budget = (int32_t)(budget + (int64_t)periods * base->cbs_runtime);
+	deadline_set_locked(thread, base->prio_deadline + periods * base->cbs_period);
+
+	return true;
+}
+
+int k_thread_cbs_set(k_tid_t thread, uint32_t runtime_us, uint32_t period_us,
+		     k_thread_cbs_fn_t overrun, void *data)
+{
+	uint64_t runtime = k_us_to_cyc_ceil64(runtime_us);
+	uint64_t period = k_us_to_cyc_ceil64(period_us);
+	uint64_t limit = ((uint64_t)CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION *
+			  arch_num_cpus() << CBS_BW_SHIFT) / 100U;
+	uint64_t bw = 0;
+	int ret = 0;
+
+	if (runtime_us != 0U) {
+		if ((runtime_us > period_us) || (period > INT32_MAX)) {
+			return -EINVAL;
+		}
+		bw = (runtime << CBS_BW_SHIFT) / period;
+	}
+
+	K_SPINLOCK(&_sched_spinlock) {
+		bool queued = z_is_thread_queued(thread);
+		_wait_q_t *wait_q = thread->base.pended_on;
+
+		if ((cbs_bandwidth - cbs_bw(thread) + bw) > limit) {
+			ret = -EBUSY;
+			K_SPINLOCK_BREAK;
+		}
+		cbs_bandwidth = cbs_bandwidth - cbs_bw(thread) + bw;
+
+		/* Joining or leaving the EDF class changes the sort order */
+		if (queued) {
+			dequeue_thread(thread);
+		} else if (wait_q != NULL) {
+			_priq_wait_remove(&wait_q->waitq, thread);
+		}
+
+		thread->base.cbs_runtime = (uint32_t)runtime;
+		thread->base.cbs_period = (runtime_us != 0U) ? (uint32_t)period : 0U;
+		thread->base.cbs_budget = (int32_t)runtime;
+		thread->base.cbs_overrun = overrun;
+		thread->base.cbs_data = data;
+		thread->base.prio_deadline = (int32_t)(k_cycle_get_32() + (uint32_t)period);
+
+		if (queued) {
+			queue_thread(thread);
+		} else if (wait_q != NULL) {
+			_priq_wait_add(&wait_q->waitq, thread);
+		}
+
+		/* Restart budget accounting if it is running here */
+		if (thread == _current) {
+			z_reset_time_slice(thread);
+		}
+	}
+
+	return ret;
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 bool k_can_yield(void)
 {
 	return !(k_is_pre_kernel() || k_is_in_isr() ||
@@ -1339,6 +1859,7 @@ static void halt_thread(struct k_thread *thread, uint8_t new_state)
 			}
 			(void)z_abort_thread_timeout(thread);
 			unpend_all(&thread->join_queue);
+			cbs_release_locked(thread);
 
 			/* Edge case: aborting _current from within an
 			 * ISR that preempted it requires clearing the
@@ -1557,6 +2078,44 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+int z_sched_wake_batch(_wait_q_t *wait_q, int swap_retval, void *swap_data)
+{
+	int woken = 0;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		woken = wake_all_locked(wait_q, true, swap_retval, swap_data);
+	}
+
+	return woken;
+}
+
+#ifdef CONFIG_EVENTS
+void z_sched_wake_event_list(struct k_thread *head)
+{
+	struct wake_batch batch = { 0 };
+	struct k_thread *thread;
+
+	K_SPINLOCK(&_sched_spinlock) {
+		for (thread = head; thread != NULL; thread = thread->next_event_link) {
+			thread->no_wake_on_timeout = false;
+
+			if ((thread->base.thread_state &
+			     (_THREAD_DEAD | _THREAD_ABORTING)) != 0U) {
+				continue;
+			}
+
+			if (thread->base.pended_on != NULL) {
+				unpend_thread_no_timeout(thread);
+			}
+			z_mark_thread_as_started(thread);
+			batch_ready_thread(&batch, thread);
+		}
+
+		batch_finish(&batch);
+	}
+}
+#endif /* CONFIG_EVENTS */
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
@@ -773,6 +773,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif /* CONFIG_TIMESLICE_PER_THREAD */
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread_base->cbs_runtime = 0U;
+	thread_base->cbs_period = 0U;
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
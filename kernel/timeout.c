@@ -11,11 +11,10 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +35,229 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.  Each pending timeout stores its absolute
+ * expiry tick in dticks and sits in exactly one slot: level N holds
+ * timeouts that share all bit groups above N with the wheel position
+ * (curr_tick) but differ from it in group N, and is indexed by the
+ * expiry's group N bits.  A level N slot is cascaded to the lower
+ * levels when curr_tick reaches the start of the block it covers, so
+ * level 0 slots only ever contain timeouts expiring on that exact
+ * tick.  Timeouts beyond the reach of the top level are parked on an
+ * unsorted overflow list which is redistributed whenever the top level
+ * wraps around.
+ *
+ * Since levels and slots are a pure function of (expiry, curr_tick),
+ * insertion and removal are constant time, and the per level bitmaps
+ * make finding the next event independent of the number of timeouts.
+ */
+#define WHEEL_BITS   5
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1U)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_QUEUE_WHEEL_LEVELS
+
+BUILD_ASSERT(WHEEL_SLOTS <= 32, "slot bitmaps are 32 bit wide");
+BUILD_ASSERT(WHEEL_BITS * WHEEL_LEVELS < 63, "wheel span exceeds tick range");
+
+/* Slot lists are (re)initialized when their pending bit gets set, so
+ * they don't need static initialization.
+ */
+static sys_dlist_t wheel_slots[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint32_t wheel_pending[WHEEL_LEVELS];
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+static int wheel_level(uint64_t expiry, uint64_t base)
+{
+	uint64_t diff = expiry ^ base;
+
+	if (diff == 0U) {
+		return 0;
+	}
+
+	return (63 - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+}
+
+static inline unsigned int wheel_index(uint64_t expiry, int level)
+{
+	return (expiry >> (level * WHEEL_BITS)) & WHEEL_MASK;
+}
+
+static void wheel_insert(struct _timeout *to, uint64_t base)
+{
+	int level = wheel_level(to->dticks, base);
+	unsigned int idx;
+
+	if (level >= WHEEL_LEVELS) {
+		sys_dlist_append(&wheel_overflow, &to->node);
+		return;
+	}
+
+	idx = wheel_index(to->dticks, level);
+	if ((wheel_pending[level] & BIT(idx)) == 0U) {
+		sys_dlist_init(&wheel_slots[level][idx]);
+		wheel_pending[level] |= BIT(idx);
+	}
+	sys_dlist_append(&wheel_slots[level][idx], &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	int level = wheel_level(t->dticks, curr_tick);
+	unsigned int idx;
+
+	sys_dlist_remove(&t->node);
+
+	if (level < WHEEL_LEVELS) {
+		idx = wheel_index(t->dticks, level);
+		if (sys_dlist_is_empty(&wheel_slots[level][idx])) {
+			wheel_pending[level] &= ~BIT(idx);
+		}
+	}
+}
+
+/*
+ * Returns the tick of the next wheel event seen from position pos, in
+ * the level argument the level it belongs to (WHEEL_LEVELS for the
+ * overflow list).  For level 0 this is an exact expiry, for higher
+ * levels the tick at which the slot must be cascaded.
+ */
+static bool wheel_next_event(uint64_t pos, uint64_t *event, int *level)
+{
+	for (int i = 0; i < WHEEL_LEVELS; i++) {
+		if (wheel_pending[i] != 0U) {
+			int shift = (i + 1) * WHEEL_BITS;
+			uint64_t idx = u32_count_trailing_zeros(wheel_pending[i]);
+
+			*event = ((pos >> shift) << shift) |
+				 (idx << (i * WHEEL_BITS));
+			*level = i;
+			return true;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		int shift = WHEEL_LEVELS * WHEEL_BITS;
+
+		*event = ((pos >> shift) + 1U) << shift;
+		*level = WHEEL_LEVELS;
+		return true;
+	}
+
+	return false;
+}
+
+static void wheel_cascade(uint64_t pos, int level)
+{
+	sys_dlist_t *list = &wheel_overflow;
+	sys_dlist_t parked;
+	sys_dnode_t *node;
+
+	if (level == WHEEL_LEVELS) {
+		/* Overflowing timeouts may go straight back to the
+		 * overflow list, park them aside first.
+		 */
+		sys_dlist_init(&parked);
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&parked, node);
+		}
+		list = &parked;
+	} else {
+		unsigned int idx = wheel_index(pos, level);
+
+		/* Timeouts only move to lower levels from here */
+		list = &wheel_slots[level][idx];
+		wheel_pending[level] &= ~BIT(idx);
+	}
+
+	/* Draining in list order keeps timeouts expiring on the same
+	 * tick in insertion order.
+	 */
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node), pos);
+	}
+}
+
+static bool timeout_queue_add(struct _timeout *to, k_ticks_t ticks)
+{
+	uint64_t prev, next;
+	int level;
+	bool had_event = wheel_next_event(curr_tick, &prev, &level);
+
+	to->dticks = curr_tick + ticks;
+	wheel_insert(to, curr_tick);
+
+	(void)wheel_next_event(curr_tick, &next, &level);
+
+	return !had_event || (next < prev);
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	return timeout->dticks - curr_tick;
+}
+
+static bool timeout_queue_next(k_ticks_t *ticks)
+{
+	uint64_t event;
+	int level;
+
+	if (!wheel_next_event(curr_tick, &event, &level)) {
+		return false;
+	}
+
+	*ticks = event - curr_tick;
+	return true;
+}
+
+/*
+ * Returns the first timeout expiring within the ticks being announced,
+ * cascading the higher levels on the way.  The cascades are done from
+ * a private position ahead of curr_tick; this is fine since the caller
+ * either advances curr_tick to the returned expiry or, when nothing is
+ * left to expire, to the end of the announced interval, and no other
+ * cascade point lies in between.
+ */
+static struct _timeout *next_expired(k_ticks_t *dt)
+{
+	uint64_t limit = curr_tick + announce_remaining;
+	uint64_t pos = curr_tick;
+	uint64_t event;
+	int level;
+
+	while (wheel_next_event(pos, &event, &level) && (event <= limit)) {
+		if (level == 0) {
+			sys_dnode_t *node =
+				sys_dlist_peek_head(&wheel_slots[0][event & WHEEL_MASK]);
+
+			*dt = event - curr_tick;
+			return CONTAINER_OF(node, struct _timeout, node);
+		}
+
+		pos = event;
+		wheel_cascade(pos, level);
+	}
+
+	return NULL;
+}
+
+static void remove_expired(struct _timeout *t)
+{
+	remove_timeout(t);
+}
+
+static inline void timeout_queue_announce(k_ticks_t ticks)
+{
+	/* Expiries are absolute, nothing to adjust */
+	ARG_UNUSED(ticks);
+}
+
+#else /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +281,84 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static bool timeout_queue_add(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+/* must be locked */
+static k_ticks_t timeout_rem(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static bool timeout_queue_next(k_ticks_t *ticks)
+{
+	struct _timeout *to = first();
+
+	if (to == NULL) {
+		return false;
+	}
+
+	*ticks = to->dticks;
+	return true;
+}
+
+static struct _timeout *next_expired(k_ticks_t *dt)
+{
+	struct _timeout *t = first();
+
+	if ((t == NULL) || (t->dticks > announce_remaining)) {
+		return NULL;
+	}
+
+	*dt = t->dticks;
+	return t;
+}
+
+static void remove_expired(struct _timeout *t)
+{
+	t->dticks = 0;
+	remove_timeout(t);
+}
+
+static inline void timeout_queue_announce(k_ticks_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -82,15 +382,15 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t ticks;
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if (!timeout_queue_next(&ticks) ||
+	    ((int64_t)(ticks - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, ticks - ticks_elapsed);
 	}
 
 	return ret;
@@ -111,31 +411,16 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = MAX(1, Z_TICK_ABS(timeout.ticks) - curr_tick);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
-
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first() && announce_remaining == 0) {
+		if (timeout_queue_add(to, ticks) && announce_remaining == 0) {
 			sys_clock_set_timeout(next_timeout(), false);
 		}
 	}
@@ -155,21 +440,6 @@ int z_abort_timeout(struct _timeout *to)
 	return ret;
 }
 
-/* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
-{
-	k_ticks_t ticks = 0;
-
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks;
-}
-
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
@@ -226,15 +496,11 @@ void sys_clock_announce(int32_t ticks)
 	announce_remaining = ticks;
 
 	struct _timeout *t;
+	k_ticks_t dt;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
-
+	for (t = next_expired(&dt); t != NULL; t = next_expired(&dt)) {
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		remove_expired(t);
 
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
@@ -242,9 +508,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
+	timeout_queue_announce(announce_remaining);
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -256,6 +520,10 @@ void sys_clock_announce(int32_t ticks)
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
 #endif /* CONFIG_TIMESLICING */
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	z_sched_cpu_runq_balance(ticks);
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 int64_t sys_clock_tick_get(void)
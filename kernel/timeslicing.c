@@ -13,6 +13,16 @@ static int slice_max_prio = CONFIG_TIMESLICE_PRIORITY;
 static struct _timeout slice_timeouts[CONFIG_MP_MAX_NUM_CPUS];
 static bool slice_expired[CONFIG_MP_MAX_NUM_CPUS];
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Budget timer for each CPU, and the reserved thread being charged
+ * there since cbs_start.
+ */
+static struct _timeout cbs_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static bool cbs_expired[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread *cbs_current[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t cbs_start[CONFIG_MP_MAX_NUM_CPUS];
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 #ifdef CONFIG_SWAP_NONATOMIC
 /* If z_swap() isn't atomic, then it's possible for a timer interrupt
  * to try to timeslice away _current after it has already pended
@@ -65,10 +75,74 @@ static void slice_timeout(struct _timeout *timeout)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+static void cbs_timeout(struct _timeout *timeout)
+{
+	int cpu = ARRAY_INDEX(cbs_timeouts, timeout);
+
+	cbs_expired[cpu] = true;
+
+	if (cpu != _current_cpu->id) {
+		flag_ipi(IPI_CPU_MASK(cpu));
+	}
+}
+
+/* Charge the reserved thread that was running on this CPU, then start
+ * charging <thread> and arm the budget timer if it has a reservation.
+ * Returns true if <thread> itself was found to have overrun.
+ */
+static bool cbs_switch(struct k_thread *thread)
+{
+	int cpu = _current_cpu->id;
+	uint32_t now = k_cycle_get_32();
+	struct k_thread *prev = cbs_current[cpu];
+	bool overrun = false;
+
+	if (prev != NULL) {
+		overrun = z_sched_cbs_charge(prev, now - cbs_start[cpu]) &&
+			  (prev == thread);
+	}
+
+	z_abort_timeout(&cbs_timeouts[cpu]);
+	cbs_expired[cpu] = false;
+
+	if (thread->base.cbs_period != 0U) {
+		int32_t ticks = k_cyc_to_ticks_ceil32(MAX(thread->base.cbs_budget, 0));
+
+		cbs_current[cpu] = thread;
+		cbs_start[cpu] = now;
+		z_add_timeout(&cbs_timeouts[cpu], cbs_timeout,
+			      K_TICKS(MAX(ticks, 1) - 1));
+	} else {
+		cbs_current[cpu] = NULL;
+	}
+
+	return overrun;
+}
+
+void z_cbs_thread_exit(struct k_thread *thread)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (cbs_current[i] == thread) {
+			z_abort_timeout(&cbs_timeouts[i]);
+			cbs_current[i] = NULL;
+		}
+	}
+}
+#else
+static inline bool cbs_switch(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+	return false;
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 void z_reset_time_slice(struct k_thread *thread)
 {
 	int cpu = _current_cpu->id;
 
+	(void)cbs_switch(thread);
+
 	z_abort_timeout(&slice_timeouts[cpu]);
 	slice_expired[cpu] = false;
 	if (thread_is_sliceable(thread)) {
@@ -114,6 +188,20 @@ void z_time_slice(void)
 	pending_current = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (cbs_expired[_current_cpu->id] && cbs_switch(curr)) {
+		if (curr->base.cbs_overrun != NULL) {
+			k_spin_unlock(&_sched_spinlock, key);
+			curr->base.cbs_overrun(curr, curr->base.cbs_data);
+			key = k_spin_lock(&_sched_spinlock);
+		}
+		if (!z_is_thread_prevented_from_running(curr)) {
+			/* Its deadline moved: let an earlier one run */
+			move_thread_to_end_of_prio_q(curr);
+		}
+	}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 	if (slice_expired[_current_cpu->id] && thread_is_sliceable(curr)) {
 #ifdef CONFIG_TIMESLICE_PER_THREAD
 		if (curr->base.slice_expired) {
@@ -48,6 +48,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
 static struct k_spinlock lists_lock;       /* kobj dlist */
+static struct k_spinlock hash_lock;        /* kobj hash table writers */
 static struct k_spinlock objfree_lock;     /* k_object_free */
 
 #ifdef CONFIG_GEN_PRIV_STACKS
@@ -169,6 +170,9 @@ struct dyn_obj {
 	struct k_object kobj;
 	sys_dnode_t dobj_list;
 
+	/* Next object in the same hash bucket */
+	atomic_ptr_t hash_next;
+
 	/* The object itself */
 	void *data;
 };
@@ -184,8 +188,69 @@ extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
 /*
- * TODO: Write some hash table code that will replace obj_list.
+ * Hash table of allocated kernel objects, indexed by object address, for
+ * k_object_find().  Lookups take no lock: buckets are singly linked lists
+ * updated with atomic pointer stores under hash_lock, so a reader always
+ * sees a consistent chain.  An unlinked object may still be visited by a
+ * lookup in progress on another CPU, so it is only freed once every such
+ * lookup is done.  Each CPU's reader count is odd while a lookup runs on
+ * it, with interrupts locked.
  */
+#define DYN_HASH_BITS CONFIG_DYNAMIC_OBJECTS_HASH_BITS
+
+static atomic_ptr_t dyn_hash[BIT(DYN_HASH_BITS)];
+static atomic_t dyn_readers[CONFIG_MP_MAX_NUM_CPUS];
+
+static inline atomic_ptr_t *dyn_hash_bucket(const void *obj)
+{
+	/* Fibonacci hashing, objects are at least word aligned */
+	uint32_t h = (uint32_t)((uintptr_t)obj >> 2) * 2654435761U;
+
+	return &dyn_hash[h >> (32 - DYN_HASH_BITS)];
+}
+
+static void dyn_hash_add(struct dyn_obj *dyn)
+{
+	atomic_ptr_t *bucket = dyn_hash_bucket(dyn->kobj.name);
+	k_spinlock_key_t key = k_spin_lock(&hash_lock);
+
+	dyn->hash_next = atomic_ptr_get(bucket);
+	(void)atomic_ptr_set(bucket, dyn);
+
+	k_spin_unlock(&hash_lock, key);
+}
+
+static void dyn_hash_remove(struct dyn_obj *dyn)
+{
+	atomic_ptr_t *link = dyn_hash_bucket(dyn->kobj.name);
+	k_spinlock_key_t key = k_spin_lock(&hash_lock);
+	struct dyn_obj *node;
+
+	while ((node = atomic_ptr_get(link)) != NULL) {
+		if (node == dyn) {
+			(void)atomic_ptr_set(link, atomic_ptr_get(&dyn->hash_next));
+			break;
+		}
+		link = &node->hash_next;
+	}
+
+	k_spin_unlock(&hash_lock, key);
+
+#ifdef CONFIG_SMP
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		atomic_val_t seq = atomic_get(&dyn_readers[i]);
+
+		if ((seq & 1) == 0) {
+			continue;
+		}
+		while (atomic_get(&dyn_readers[i]) == seq) {
+			arch_spin_relax();
+		}
+	}
+#endif /* CONFIG_SMP */
+}
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -223,27 +288,24 @@ static size_t obj_align_get(enum k_objects otype)
 
 static struct dyn_obj *dyn_object_find(const void *obj)
 {
+	atomic_ptr_t *bucket = dyn_hash_bucket(obj);
 	struct dyn_obj *node;
-	k_spinlock_key_t key;
+	unsigned int key;
+	atomic_t *seq;
 
-	/* For any dynamically allocated kernel object, the object
-	 * pointer is just a member of the containing struct dyn_obj,
-	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
-	 */
-	key = k_spin_lock(&lists_lock);
+	key = arch_irq_lock();
+	seq = &dyn_readers[_current_cpu->id];
+	(void)atomic_inc(seq);
 
-	SYS_DLIST_FOR_EACH_CONTAINER(&obj_list, node, dobj_list) {
+	for (node = atomic_ptr_get(bucket); node != NULL;
+	     node = atomic_ptr_get(&node->hash_next)) {
 		if (node->kobj.name == obj) {
-			goto end;
+			break;
 		}
 	}
 
-	/* No object found */
-	node = NULL;
-
- end:
-	k_spin_unlock(&lists_lock, key);
+	(void)atomic_inc(seq);
+	arch_irq_unlock(key);
 
 	return node;
 }
@@ -376,6 +438,7 @@ static struct k_object *dynamic_object_create(enum k_objects otype, size_t align
 	k_spinlock_key_t key = k_spin_lock(&lists_lock);
 
 	sys_dlist_append(&obj_list, &dyn->dobj_list);
+	dyn_hash_add(dyn);
 	k_spin_unlock(&lists_lock, key);
 
 	return &dyn->kobj;
@@ -470,6 +533,7 @@ void k_object_free(void *obj)
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
 		sys_dlist_remove(&dyn->dobj_list);
+		dyn_hash_remove(dyn);
 
 		if (dyn->kobj.type == K_OBJ_THREAD) {
 			thread_idx_free(dyn->kobj.data.thread_id);
@@ -580,6 +644,7 @@ static void unref_check(struct k_object *ko, uintptr_t index)
 	}
 
 	sys_dlist_remove(&dyn->dobj_list);
+	dyn_hash_remove(dyn);
 	k_free(dyn->data);
 	k_free(dyn);
 out:
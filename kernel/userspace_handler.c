@@ -8,6 +8,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/kernel_structs.h>
 #include <zephyr/toolchain.h>
+#include <zephyr/sys/syscall_batch.h>
 
 static struct k_object *validate_kernel_object(const void *obj,
 					       enum k_objects otype,
@@ -87,3 +88,54 @@ static inline void *z_vrfy_k_object_alloc_size(enum k_objects otype, size_t size
 	return z_impl_k_object_alloc_size(otype, size);
 }
 #include <zephyr/syscalls/k_object_alloc_size_mrsh.c>
+
+int z_impl_k_syscall_batch(struct k_syscall_batch_entry *entries, size_t count)
+{
+	ARG_UNUSED(entries);
+	ARG_UNUSED(count);
+
+	/* The batched calls can only be made through their verification
+	 * handlers, which check permissions as for a user thread and need
+	 * a system call frame to oops.  A supervisor thread has neither,
+	 * and calls the kernel directly anyway.
+	 */
+	return -ENOTSUP;
+}
+
+static inline int z_vrfy_k_syscall_batch(struct k_syscall_batch_entry *entries,
+					 size_t count)
+{
+	struct k_syscall_batch_entry entry;
+	void *ssf = _current->syscall_frame;
+
+	if (count > CONFIG_SYSCALL_BATCH_MAX) {
+		return -EINVAL;
+	}
+
+	K_OOPS(K_SYSCALL_MEMORY_ARRAY_WRITE(entries, count, sizeof(*entries)));
+
+	for (size_t i = 0; i < count; i++) {
+		/* The caller may change entries meanwhile, work on a copy */
+		K_OOPS(k_usermode_from_copy(&entry, &entries[i], sizeof(entry)));
+
+		K_OOPS(K_SYSCALL_VERIFY_MSG((entry.id < K_SYSCALL_LIMIT) &&
+					    (entry.id != K_SYSCALL_K_SYSCALL_BATCH),
+					    "bad batched system call id %" PRIuPTR,
+					    entry.id));
+
+		/* Handlers clear the system call frame when they return */
+		entry.ret = _k_syscall_table[entry.id](entry.args[0], entry.args[1],
+						       entry.args[2], entry.args[3],
+						       entry.args[4], entry.args[5], ssf);
+		_current->syscall_frame = ssf;
+
+		/* The handler may have blocked, and the caller's memory
+		 * changed meanwhile: check it again to store the result.
+		 */
+		K_OOPS(k_usermode_to_copy(&entries[i].ret, &entry.ret,
+					  sizeof(entry.ret)));
+	}
+
+	return 0;
+}
+#include <zephyr/syscalls/k_syscall_batch_mrsh.c>
@@ -147,6 +147,310 @@ static void finalize_cancel_locked(struct k_work *work)
 	}
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+
+static inline bool queue_has_workers(const struct k_work_q *queue)
+{
+	return !sys_slist_is_empty(&queue->workers);
+}
+
+/* Record a flush of a work item processed by a queue with workers.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the work item that is either queued or running
+ * @param flusher an uninitialized/unused flusher object
+ */
+static void track_flusher_locked(struct k_work *work,
+				 struct z_work_flusher *flusher)
+{
+	init_flusher(flusher);
+	flusher->queued = flag_test(&work->flags, K_WORK_QUEUED_BIT);
+	sys_slist_append(&work->flushers, &flusher->work.node);
+}
+
+/* Note that the queued instance of a work item left its queue, so that
+ * flushes only wait for it to stop running.
+ *
+ * Invoked with work lock held.
+ */
+static void flushers_dequeue_locked(struct k_work *work)
+{
+	struct z_work_flusher *flusher;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&work->flushers, flusher, work.node) {
+		flusher->queued = false;
+	}
+}
+
+/* Release flushes waiting for a work item to stop running.
+ *
+ * Invoked with work lock held.
+ *
+ * Reschedules.
+ */
+static void flushers_finish_locked(struct k_work *work)
+{
+	struct z_work_flusher *flusher, *tmp;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&work->flushers, flusher, tmp,
+					  work.node) {
+		if (!flusher->queued) {
+			sys_slist_remove(&work->flushers, prev,
+					 &flusher->work.node);
+			finalize_flush_locked(&flusher->work);
+		} else {
+			prev = &flusher->work.node;
+		}
+	}
+}
+
+/* Remove a queued work item from the list it was submitted to.
+ *
+ * Invoked with work lock held.
+ *
+ * Reschedules.
+ */
+static void workers_remove_locked(struct k_work_q *queue,
+				  struct k_work *work)
+{
+	struct k_work_q_worker *worker;
+
+	if (!sys_slist_find_and_remove(&queue->pending, &work->node)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+			if (sys_slist_find_and_remove(&worker->pending,
+						      &work->node)) {
+				break;
+			}
+		}
+	}
+
+	/* Flushes of the removed instance are complete, unless they
+	 * still have to wait for a previous one to stop running.
+	 */
+	flushers_dequeue_locked(work);
+	if (!flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		flushers_finish_locked(work);
+	}
+}
+
+/* Find the worker running the current thread, if any.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work_q_worker *current_worker_locked(struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker;
+
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (_current == &worker->thread) {
+			return worker;
+		}
+	}
+
+	return NULL;
+}
+
+/* Select the worker to which new work should be submitted.
+ *
+ * Work submitted from a worker stays local, other submissions go to the
+ * worker pinned to the current CPU.  Idle workers steal from the others
+ * to balance the load.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the selected worker, or NULL for the queue thread.
+ */
+static struct k_work_q_worker *submit_worker_locked(struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker = current_worker_locked(queue);
+	struct k_work_q_worker *local = NULL;
+
+	if ((worker != NULL) ||
+	    (!k_is_in_isr() && (_current == &queue->thread))) {
+		return worker;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (worker->cpu == (int)_current_cpu->id) {
+			local = worker;
+			break;
+		}
+	}
+
+	return local;
+}
+
+/* Take the first work item of a list that is not already running.
+ *
+ * Items resubmitted while running must not be picked by another worker
+ * before they complete, to prevent handler re-entrancy.
+ *
+ * Invoked with work lock held.
+ */
+static sys_snode_t *take_work_locked(sys_slist_t *list)
+{
+	struct k_work *work;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, work, node) {
+		if (!flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+			sys_slist_remove(list, prev, &work->node);
+			return &work->node;
+		}
+		prev = &work->node;
+	}
+
+	return NULL;
+}
+
+/* Get the next work item for a worker, stealing it from the queue
+ * thread or the other workers if the worker has nothing pending.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue the worker belongs to
+ * @param self the worker, or NULL for the queue thread
+ */
+static sys_snode_t *steal_work_locked(struct k_work_q *queue,
+				      struct k_work_q_worker *self)
+{
+	struct k_work_q_worker *worker;
+	sys_snode_t *node;
+
+	node = take_work_locked((self != NULL) ? &self->pending
+				: &queue->pending);
+	if ((node == NULL) && (self != NULL)) {
+		node = take_work_locked(&queue->pending);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (node != NULL) {
+			break;
+		}
+		if (worker != self) {
+			node = take_work_locked(&worker->pending);
+		}
+	}
+
+	return node;
+}
+
+/* Wake an idle worker of a queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @return true if a worker was woken.
+ */
+static bool notify_workers_locked(struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (z_sched_wake(&worker->notifyq, 0, NULL)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Test whether the queue thread or any worker is running a work item.
+ *
+ * Invoked with work lock held.
+ */
+static bool queue_busy_locked(const struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker;
+
+	if (flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)) {
+		return true;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (worker->busy) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Test whether the queue thread or any worker has pending work.
+ *
+ * Invoked with work lock held.
+ */
+static bool queue_pending_locked(const struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker;
+
+	if (!sys_slist_is_empty(&queue->pending)) {
+		return true;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (!sys_slist_is_empty(&worker->pending)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#else /* CONFIG_WORKQUEUE_WORKERS */
+
+static inline bool queue_has_workers(const struct k_work_q *queue)
+{
+	ARG_UNUSED(queue);
+
+	return false;
+}
+
+static inline void track_flusher_locked(struct k_work *work,
+					struct z_work_flusher *flusher) { }
+static inline void flushers_dequeue_locked(struct k_work *work) { }
+static inline void flushers_finish_locked(struct k_work *work) { }
+static inline void workers_remove_locked(struct k_work_q *queue,
+					 struct k_work *work) { }
+
+static inline struct k_work_q_worker *current_worker_locked(struct k_work_q *queue)
+{
+	return NULL;
+}
+
+static inline struct k_work_q_worker *submit_worker_locked(struct k_work_q *queue)
+{
+	return NULL;
+}
+
+static inline sys_snode_t *steal_work_locked(struct k_work_q *queue,
+					     struct k_work_q_worker *self)
+{
+	return NULL;
+}
+
+static inline bool notify_workers_locked(struct k_work_q *queue)
+{
+	return false;
+}
+
+static inline bool queue_busy_locked(const struct k_work_q *queue)
+{
+	return flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+static inline bool queue_pending_locked(const struct k_work_q *queue)
+{
+	return !sys_slist_is_empty(&queue->pending);
+}
+
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 void k_work_init(struct k_work *work,
 		  k_work_handler_t handler)
 {
@@ -219,7 +523,12 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
-		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+		if (queue_has_workers(queue)) {
+			workers_remove_locked(queue, work);
+		} else {
+			(void)sys_slist_find_and_remove(&queue->pending,
+							&work->node);
+		}
 	}
 }
 
@@ -239,7 +548,8 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	bool rv = false;
 
 	if (queue != NULL) {
-		rv = z_sched_wake(&queue->notifyq, 0, NULL);
+		rv = z_sched_wake(&queue->notifyq, 0, NULL) ||
+		     notify_workers_locked(queue);
 	}
 
 	return rv;
@@ -273,6 +583,12 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 
 	int ret;
 	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	struct k_work_q_worker *worker = NULL;
+
+	if (queue_has_workers(queue)) {
+		worker = submit_worker_locked(queue);
+		chained = chained || (current_worker_locked(queue) != NULL);
+	}
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -290,9 +606,16 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
-		sys_slist_append(&queue->pending, &work->node);
+		sys_slist_append((worker != NULL) ? &worker->pending
+			       : &queue->pending, &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
+		/* Prefer waking the worker the work was submitted to, any
+		 * idle one will steal it otherwise.
+		 */
+		if ((worker == NULL) ||
+		    !z_sched_wake(&worker->notifyq, 0, NULL)) {
+			(void)notify_queue_locked(queue);
+		}
 	}
 
 	return ret;
@@ -455,8 +778,12 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
-		queue_flusher_locked(queue, work, flusher);
-		notify_queue_locked(queue);
+		if (queue_has_workers(queue)) {
+			track_flusher_locked(work, flusher);
+		} else {
+			queue_flusher_locked(queue, work, flusher);
+			notify_queue_locked(queue);
+		}
 	}
 
 	return need_flush;
@@ -612,13 +939,15 @@ bool k_work_cancel_sync(struct k_work *work,
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
+ * @param worker_ptr pointer to the worker structure, or NULL for the
+ * queue thread
  */
-static void work_queue_main(void *workq_ptr, void *p2, void *p3)
+static void work_queue_main(void *workq_ptr, void *worker_ptr, void *p3)
 {
-	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+	struct k_work_q_worker *worker = (struct k_work_q_worker *)worker_ptr;
 
 	while (true) {
 		sys_snode_t *node;
@@ -628,15 +957,25 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		if (queue_has_workers(queue)) {
+			node = steal_work_locked(queue, worker);
+		} else {
+			node = sys_slist_get(&queue->pending);
+		}
+
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			if (worker != NULL) {
+				worker->busy = true;
+			} else {
+				flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			}
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+			flushers_dequeue_locked(work);
 
 			/* Static code analysis tool can raise a false-positive violation
 			 * in the line below that 'work' is checked for null after being
@@ -651,7 +990,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
+		} else if (!queue_busy_locked(queue) &&
+			   !queue_pending_locked(queue) &&
+			   flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
@@ -661,6 +1002,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * We don't touch K_WORK_QUEUE_PLUGGABLE, so getting
 			 * here doesn't mean that the queue will allow new
 			 * submissions.
+			 *
+			 * With workers this has to wait for the last one
+			 * to go idle.
 			 */
 			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
 		} else {
@@ -677,7 +1021,9 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * work thread will be woken and we can check again.
 			 */
 
-			(void)z_sched_wait(&lock, key, &queue->notifyq,
+			(void)z_sched_wait(&lock, key,
+					   (worker != NULL) ? &worker->notifyq
+					   : &queue->notifyq,
 					   K_FOREVER, NULL);
 			continue;
 		}
@@ -701,8 +1047,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
 			finalize_cancel_locked(work);
 		}
+		flushers_finish_locked(work);
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		if (worker != NULL) {
+			worker->busy = false;
+		} else {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -742,6 +1093,9 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_slist_init(&queue->workers);
+#endif /* CONFIG_WORKQUEUE_WORKERS */
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -765,11 +1119,80 @@ void k_work_queue_start(struct k_work_q *queue,
 		queue->thread.base.user_options |= K_ESSENTIAL;
 	}
 
+#ifdef CONFIG_SCHED_CPU_MASK
+	if ((cfg != NULL) && (cfg->cpu_mask != 0U)) {
+		(void)k_thread_cpu_mask_clear(&queue->thread);
+
+		for (int cpu = 0; cpu < CONFIG_MP_MAX_NUM_CPUS; cpu++) {
+			if ((cfg->cpu_mask & BIT(cpu)) != 0U) {
+				(void)k_thread_cpu_mask_enable(&queue->thread, cpu);
+			}
+		}
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
 	k_thread_start(&queue->thread);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+int k_work_queue_add_worker(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack,
+			    size_t stack_size,
+			    int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+
+	k_spinlock_key_t key;
+
+	if ((cpu >= (int)arch_num_cpus()) ||
+	    ((cpu >= 0) && !IS_ENABLED(CONFIG_SCHED_CPU_MASK))) {
+		return -EINVAL;
+	}
+
+	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
+		return -ENODEV;
+	}
+
+	*worker = (struct k_work_q_worker) {
+		.queue = queue,
+		.cpu = cpu,
+	};
+	sys_slist_init(&worker->pending);
+	z_waitq_init(&worker->notifyq);
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, worker, NULL,
+			      k_thread_priority_get(&queue->thread), 0,
+			      K_FOREVER);
+
+#ifdef CONFIG_THREAD_NAME
+	k_thread_name_set(&worker->thread, k_thread_name_get(&queue->thread));
+#endif /* CONFIG_THREAD_NAME */
+
+	worker->thread.base.user_options |=
+		queue->thread.base.user_options & K_ESSENTIAL;
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&worker->thread, cpu);
+	}
+#endif /* CONFIG_SCHED_CPU_MASK */
+
+	key = k_spin_lock(&lock);
+	sys_slist_append(&queue->workers, &worker->node);
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+
+	return 0;
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -781,10 +1204,10 @@ int k_work_queue_drain(struct k_work_q *queue,
 	int ret = 0;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (((flags_get(&queue->flags)
-	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
+	if (queue_busy_locked(queue)
+	    || flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || queue_pending_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
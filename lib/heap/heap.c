@@ -37,11 +37,11 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_bucket_avail(h, bidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +70,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -160,7 +160,7 @@ static chunkid_t mem_to_chunkid(struct z_heap *h, void *p)
 	return (mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
 }
 
-void sys_heap_free(struct sys_heap *heap, void *mem)
+void z_heap_free(struct sys_heap *heap, void *mem, bool notify)
 {
 	if (mem == NULL) {
 		return; /* ISO C free() semantics */
@@ -190,13 +190,27 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
-				  chunksz_to_bytes(h, chunk_size(h, c)));
+	if (notify) {
+		heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
+					  chunksz_to_bytes(h, chunk_size(h, c)));
+	}
 #endif
 
 	free_chunk(h, c);
 }
 
+void sys_heap_free(struct sys_heap *heap, void *mem)
+{
+	z_heap_free(heap, mem, true);
+}
+
+size_t z_heap_block_bytes(struct sys_heap *heap, void *mem)
+{
+	struct z_heap *h = heap->heap;
+
+	return chunksz_to_bytes(h, chunk_size(h, mem_to_chunkid(h, mem)));
+}
+
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 {
 	struct z_heap *h = heap->heap;
@@ -208,6 +222,7 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifndef CONFIG_SYS_HEAP_TLSF
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -259,8 +274,62 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 
 	return 0;
 }
+#else
+/* Constant time good fit.  The request is rounded up to the next
+ * second level boundary, so that the first chunk of any bucket found
+ * from there is guaranteed to fit without searching the list.  That
+ * gives up at most 1/SL_COUNT of the chunk size to fragmentation.
+ */
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int fl = 31 - __builtin_clz(usable_sz);
+	uint32_t *sl_avail = bucket_sl_avail(h);
+	uint32_t slmap = 0;
+	int bi;
+
+	if (fl >= SL_LOG2) {
+		usable_sz += (1U << (fl - SL_LOG2)) - 1U;
+	}
+	bi = tlsf_idx(usable_sz);
+	fl = bi / SL_COUNT;
 
-void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+	if ((h->avail_buckets & BIT(fl)) != 0U) {
+		slmap = sl_avail[fl] & ~BIT_MASK(bi % SL_COUNT);
+	}
+
+	if (slmap == 0U) {
+		uint32_t flmap = (fl < 31) ? h->avail_buckets & ~BIT_MASK(fl + 1) : 0U;
+
+		if (flmap == 0U) {
+			/* Last resort: the unrounded bucket may still
+			 * hold a chunk that fits at its head.
+			 */
+			bi = bucket_idx(h, sz);
+			if (bucket_avail(h, bi) &&
+			    (chunk_size(h, h->buckets[bi].next) >= sz)) {
+				chunkid_t c = h->buckets[bi].next;
+
+				free_list_remove_bidx(h, c, bi);
+				return c;
+			}
+			return 0;
+		}
+		fl = __builtin_ctz(flmap);
+		slmap = sl_avail[fl];
+	}
+
+	bi = fl * SL_COUNT + __builtin_ctz(slmap);
+
+	chunkid_t c = h->buckets[bi].next;
+
+	free_list_remove_bidx(h, c, bi);
+	CHECK(chunk_size(h, c) >= sz);
+	return c;
+}
+#endif /* CONFIG_SYS_HEAP_TLSF */
+
+static void *heap_alloc(struct sys_heap *heap, size_t bytes, bool notify)
 {
 	struct z_heap *h = heap->heap;
 	void *mem;
@@ -290,15 +359,23 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
-				   chunksz_to_bytes(h, chunk_size(h, c)));
+	if (notify) {
+		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+					   chunksz_to_bytes(h, chunk_size(h, c)));
+	}
 #endif
 
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
 
-void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
+{
+	return heap_alloc(heap, bytes, true);
+}
+
+void *z_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes,
+			   bool notify)
 {
 	struct z_heap *h = heap->heap;
 	size_t gap, rew;
@@ -316,7 +393,7 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 		gap = MIN(rew, chunk_header_bytes(h));
 	} else {
 		if (align <= chunk_header_bytes(h)) {
-			return sys_heap_alloc(heap, bytes);
+			return heap_alloc(heap, bytes, notify);
 		}
 		rew = 0;
 		gap = chunk_header_bytes(h);
@@ -368,14 +445,21 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 #endif
 
 #ifdef CONFIG_SYS_HEAP_LISTENER
-	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
-				   chunksz_to_bytes(h, chunk_size(h, c)));
+	if (notify) {
+		heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+					   chunksz_to_bytes(h, chunk_size(h, c)));
+	}
 #endif
 
 	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
 	return mem;
 }
 
+void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	return z_heap_aligned_alloc(heap, align, bytes, true);
+}
+
 void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 			       size_t align, size_t bytes)
 {
@@ -508,6 +592,9 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 
 	struct z_heap *h = (struct z_heap *)addr;
 	heap->heap = h;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	heap->cache = NULL;
+#endif
 	h->end_chunk = heap_sz;
 	h->avail_buckets = 0;
 
@@ -518,14 +605,17 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 #endif
 
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
+	size_t bitmap_bytes = bucket_bitmap_bytes(h);
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
-				     nb_buckets * sizeof(struct z_heap_bucket));
+				     nb_buckets * sizeof(struct z_heap_bucket) +
+				     bitmap_bytes);
 
 	__ASSERT(chunk0_size + min_chunk_size(h) <= heap_sz, "heap size is too small");
 
 	for (int i = 0; i < nb_buckets; i++) {
 		h->buckets[i].next = 0;
 	}
+	memset(&h->buckets[nb_buckets], 0, bitmap_bytes);
 
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
@@ -68,6 +68,7 @@ struct z_heap_bucket {
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
+	/* One bit per non-empty bucket (per first level with TLSF) */
 	uint32_t avail_buckets;
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	size_t free_bytes;
@@ -247,12 +248,118 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT - chunk_header_bytes(h);
 }
 
+#ifndef CONFIG_SYS_HEAP_TLSF
+
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
 	return 31 - __builtin_clz(usable_sz);
 }
 
+/* Smallest chunk size stored in a bucket */
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	return (1U << bidx) - 1U + min_chunk_size(h);
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (h->avail_buckets & BIT(bidx)) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	if (avail) {
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_buckets &= ~BIT(bidx);
+	}
+}
+
+static inline size_t bucket_bitmap_bytes(struct z_heap *h)
+{
+	ARG_UNUSED(h);
+	return 0;
+}
+
+#else /* CONFIG_SYS_HEAP_TLSF */
+
+/* Two-level segregated fit: each power-of-two "first level" bucket
+ * is split into SL_COUNT "second level" buckets of equal size ranges.
+ * The bucket index is fl * SL_COUNT + sl, so bucket order still
+ * follows chunk size.  avail_buckets has a bit per non-empty first
+ * level, and a bitmap of non-empty second levels for each first level
+ * is stored right after the bucket array.  First levels smaller than
+ * SL_COUNT units only use their first few second level buckets.
+ */
+#define SL_LOG2  CONFIG_SYS_HEAP_TLSF_SL_LOG2
+#define SL_COUNT (1U << SL_LOG2)
+
+static inline int tlsf_idx(unsigned int usable_sz)
+{
+	int fl = 31 - __builtin_clz(usable_sz);
+	unsigned int sl;
+
+	if (fl < SL_LOG2) {
+		sl = usable_sz - (1U << fl);
+	} else {
+		sl = (usable_sz >> (fl - SL_LOG2)) - SL_COUNT;
+	}
+
+	return fl * SL_COUNT + sl;
+}
+
+static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
+{
+	return tlsf_idx(sz - min_chunk_size(h) + 1);
+}
+
+static inline chunksz_t bucket_min_size(struct z_heap *h, int bidx)
+{
+	unsigned int fl = bidx / SL_COUNT, sl = bidx % SL_COUNT;
+	unsigned int usable_sz;
+
+	if (fl < SL_LOG2) {
+		usable_sz = (1U << fl) + sl;
+	} else {
+		usable_sz = (SL_COUNT + sl) << (fl - SL_LOG2);
+	}
+
+	return usable_sz - 1U + min_chunk_size(h);
+}
+
+static inline uint32_t *bucket_sl_avail(struct z_heap *h)
+{
+	return (uint32_t *)&h->buckets[bucket_idx(h, h->end_chunk) + 1];
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (bucket_sl_avail(h)[bidx / SL_COUNT] & BIT(bidx % SL_COUNT)) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	uint32_t *sl_avail = &bucket_sl_avail(h)[bidx / SL_COUNT];
+
+	if (avail) {
+		*sl_avail |= BIT(bidx % SL_COUNT);
+		h->avail_buckets |= BIT(bidx / SL_COUNT);
+	} else {
+		*sl_avail &= ~BIT(bidx % SL_COUNT);
+		if (*sl_avail == 0U) {
+			h->avail_buckets &= ~BIT(bidx / SL_COUNT);
+		}
+	}
+}
+
+static inline size_t bucket_bitmap_bytes(struct z_heap *h)
+{
+	return (bucket_idx(h, h->end_chunk) / SL_COUNT + 1) * sizeof(uint32_t);
+}
+
+#endif /* CONFIG_SYS_HEAP_TLSF */
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
@@ -279,4 +386,14 @@ static inline void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 	}
 }
 
+/* Allocation and free with optional listener notification, for
+ * front-ends such as the block cache that report their own events.
+ */
+void *z_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes,
+			   bool notify);
+void z_heap_free(struct sys_heap *heap, void *mem, bool notify);
+
+/* Bytes accounted to an allocated block in the runtime statistics */
+size_t z_heap_block_bytes(struct sys_heap *heap, void *mem);
+
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_cache.h>
+#include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include "heap.h"
+
+#define NUM_CLASSES CONFIG_SYS_HEAP_CACHE_CLASSES
+#define BATCH       CONFIG_SYS_HEAP_CACHE_BATCH
+
+/* A cache bin holds at most two batches: one freshly refilled and one
+ * of frees waiting to be flushed.
+ */
+#define BIN_MAX (2 * BATCH)
+
+static inline size_t class_bytes(int cls)
+{
+	return (size_t)CHUNK_UNIT << cls;
+}
+
+/* Smallest class that can serve the request, or -1 */
+static int alloc_class(struct sys_heap_cache *cache, size_t align, size_t bytes)
+{
+	if ((bytes == 0U) || (bytes > class_bytes(NUM_CLASSES - 1)) ||
+	    (align > cache->align)) {
+		return -1;
+	}
+
+	if (bytes <= CHUNK_UNIT) {
+		return 0;
+	}
+
+	return 32 - __builtin_clz((uint32_t)bytes - 1U) - 3;
+}
+
+/* Largest class a freed block can serve, or -1.  The size of an
+ * allocated block is stable, so no heap lock is needed to read it.
+ */
+static int free_class(struct sys_heap *heap, void *mem)
+{
+	size_t sz = sys_heap_usable_size(heap, mem);
+
+	if ((sz < CHUNK_UNIT) || (sz >= 2U * class_bytes(NUM_CLASSES - 1)) ||
+	    (((uintptr_t)mem & (heap->cache->align - 1U)) != 0U)) {
+		return -1;
+	}
+
+	return 31 - __builtin_clz((uint32_t)sz) - 3;
+}
+
+/* The id may be stale if the caller migrates.  Bins are locked, so this
+ * only costs some sharing.
+ */
+static inline struct sys_heap_cache_cpu *local_cpu(struct sys_heap_cache *cache)
+{
+	return &cache->cpus[arch_curr_cpu()->id];
+}
+
+static inline void bin_push(struct sys_heap_cache_bin *bin, void *mem)
+{
+	*(void **)mem = bin->head;
+	bin->head = mem;
+	bin->count++;
+}
+
+static inline void *bin_pop(struct sys_heap_cache_bin *bin)
+{
+	void *mem = bin->head;
+
+	if (mem != NULL) {
+		bin->head = *(void **)mem;
+		bin->count--;
+	}
+
+	return mem;
+}
+
+static size_t list_bytes(struct sys_heap *heap, void *list)
+{
+	size_t bytes = 0;
+
+	for (; list != NULL; list = *(void **)list) {
+		bytes += z_heap_block_bytes(heap, list);
+	}
+
+	return bytes;
+}
+
+static inline void notify_alloc(struct sys_heap *heap, void *mem)
+{
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_alloc(HEAP_ID_FROM_POINTER(heap), mem,
+				   z_heap_block_bytes(heap, mem));
+#endif
+}
+
+static inline void notify_free(struct sys_heap *heap, void *mem)
+{
+#ifdef CONFIG_SYS_HEAP_LISTENER
+	heap_listener_notify_free(HEAP_ID_FROM_POINTER(heap), mem,
+				  z_heap_block_bytes(heap, mem));
+#endif
+}
+
+void sys_heap_cache_init(struct sys_heap_cache *cache, struct sys_heap *heap,
+			 size_t align)
+{
+	__ASSERT((align & (align - 1U)) == 0U, "align must be a power of 2");
+
+	*cache = (struct sys_heap_cache) {
+		.align = MAX(align, sizeof(void *)),
+	};
+	heap->cache = cache;
+}
+
+void *sys_heap_cache_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct sys_heap_cache *cache = heap->cache;
+	int cls = alloc_class(cache, align, bytes);
+	struct sys_heap_cache_cpu *cpu;
+	k_spinlock_key_t key;
+	void *mem;
+
+	if (cls < 0) {
+		return NULL;
+	}
+
+	cpu = local_cpu(cache);
+	key = k_spin_lock(&cpu->lock);
+	mem = bin_pop(&cpu->bins[cls]);
+	k_spin_unlock(&cpu->lock, key);
+
+	if (mem != NULL) {
+		atomic_sub(&cache->cached_bytes, z_heap_block_bytes(heap, mem));
+		notify_alloc(heap, mem);
+	}
+
+	return mem;
+}
+
+void *sys_heap_cache_refill(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct sys_heap_cache *cache = heap->cache;
+	int cls = alloc_class(cache, align, bytes);
+	struct sys_heap_cache_cpu *cpu;
+	struct sys_heap_cache_bin *bin;
+	k_spinlock_key_t key;
+	void *list = NULL;
+	void *mem;
+
+	if (cls < 0) {
+		mem = sys_heap_aligned_alloc(heap, align, bytes);
+		if (mem == NULL) {
+			sys_heap_cache_drain(heap);
+			mem = sys_heap_aligned_alloc(heap, align, bytes);
+		}
+		return mem;
+	}
+
+	mem = z_heap_aligned_alloc(heap, cache->align, class_bytes(cls), false);
+	if (mem == NULL) {
+		/* The memory may be sitting in the caches */
+		sys_heap_cache_drain(heap);
+		mem = z_heap_aligned_alloc(heap, cache->align,
+					   class_bytes(cls), false);
+		if (mem == NULL) {
+			return NULL;
+		}
+	}
+
+	for (int i = 1; i < BATCH; i++) {
+		void *extra = z_heap_aligned_alloc(heap, cache->align,
+						   class_bytes(cls), false);
+
+		if (extra == NULL) {
+			break;
+		}
+		*(void **)extra = list;
+		list = extra;
+	}
+
+	atomic_add(&cache->cached_bytes, list_bytes(heap, list));
+
+	cpu = local_cpu(cache);
+	bin = &cpu->bins[cls];
+	key = k_spin_lock(&cpu->lock);
+	while ((list != NULL) && (bin->count < BIN_MAX)) {
+		void *next = *(void **)list;
+
+		bin_push(bin, list);
+		list = next;
+	}
+	k_spin_unlock(&cpu->lock, key);
+
+	/* Frees raced in and filled the bin: give the rest back */
+	atomic_sub(&cache->cached_bytes, list_bytes(heap, list));
+	sys_heap_cache_flush(heap, list);
+
+	notify_alloc(heap, mem);
+
+	return mem;
+}
+
+void *sys_heap_cache_free(struct sys_heap *heap, void *mem)
+{
+	struct sys_heap_cache *cache = heap->cache;
+	struct sys_heap_cache_cpu *cpu;
+	struct sys_heap_cache_bin *bin;
+	k_spinlock_key_t key;
+	void *list = NULL;
+	int cls;
+
+	if (mem == NULL) {
+		return NULL;
+	}
+
+	notify_free(heap, mem);
+
+	cls = free_class(heap, mem);
+	if (cls < 0) {
+		*(void **)mem = NULL;
+		return mem;
+	}
+
+	atomic_add(&cache->cached_bytes, z_heap_block_bytes(heap, mem));
+
+	cpu = local_cpu(cache);
+	bin = &cpu->bins[cls];
+	key = k_spin_lock(&cpu->lock);
+	bin_push(bin, mem);
+	if (bin->count >= BIN_MAX) {
+		for (int i = 0; i < BATCH; i++) {
+			void *b = bin_pop(bin);
+
+			*(void **)b = list;
+			list = b;
+		}
+	}
+	k_spin_unlock(&cpu->lock, key);
+
+	atomic_sub(&cache->cached_bytes, list_bytes(heap, list));
+
+	return list;
+}
+
+void sys_heap_cache_flush(struct sys_heap *heap, void *list)
+{
+	while (list != NULL) {
+		void *next = *(void **)list;
+
+		z_heap_free(heap, list, false);
+		list = next;
+	}
+}
+
+void sys_heap_cache_drain(struct sys_heap *heap)
+{
+	struct sys_heap_cache *cache = heap->cache;
+	void *list = NULL;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct sys_heap_cache_cpu *cpu = &cache->cpus[i];
+		k_spinlock_key_t key = k_spin_lock(&cpu->lock);
+
+		for (int cls = 0; cls < NUM_CLASSES; cls++) {
+			void *mem;
+
+			while ((mem = bin_pop(&cpu->bins[cls])) != NULL) {
+				*(void **)mem = list;
+				list = mem;
+			}
+		}
+		k_spin_unlock(&cpu->lock, key);
+	}
+
+	atomic_sub(&cache->cached_bytes, list_bytes(heap, list));
+	sys_heap_cache_flush(heap, list);
+}
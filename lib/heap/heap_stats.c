@@ -5,6 +5,7 @@
  */
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/heap_cache.h>
 #include <zephyr/kernel.h>
 #include "heap.h"
 
@@ -19,6 +20,18 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	stats->allocated_bytes = heap->heap->allocated_bytes;
 	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Blocks in the caches are allocated from the heap but free
+	 * for its users.
+	 */
+	if (heap->cache != NULL) {
+		size_t cached = (size_t)atomic_get(&heap->cache->cached_bytes);
+
+		stats->free_bytes += cached;
+		stats->allocated_bytes -= cached;
+	}
+#endif
+
 	return 0;
 }
 
@@ -18,6 +18,10 @@ struct z_heap_stress_rec {
 	size_t blocks_alloced;
 	size_t bytes_alloced;
 	uint32_t target_percent;
+	uint64_t rand_state;
+	/* Bytes allocated from the heap by all threads */
+	atomic_t *heap_bytes;
+	size_t heap_total_bytes;
 };
 
 struct z_heap_stress_block {
@@ -29,15 +33,24 @@ struct z_heap_stress_block {
  *
  * Here to guarantee cross-platform test repeatability.
  */
-static uint32_t rand32(void)
-{
-	static uint64_t state = 123456789; /* seed */
+#define RAND_SEED 123456789
 
-	state = state * 2862933555777941757UL + 3037000493UL;
+static uint32_t rand32(struct z_heap_stress_rec *sr)
+{
+	sr->rand_state = sr->rand_state * 2862933555777941757UL + 3037000493UL;
 
-	return (uint32_t)(state >> 32);
+	return (uint32_t)(sr->rand_state >> 32);
 }
 
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+typedef uint64_t stress_cycles_t;
+#define stress_cycle_get() k_cycle_get_64()
+#else
+/* Wraps, so runs must stay shorter than 2^32 cycles */
+typedef uint32_t stress_cycles_t;
+#define stress_cycle_get() k_cycle_get_32()
+#endif
+
 static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
 {
 	/* Edge cases: no blocks allocated, and no space for a new one */
@@ -71,7 +84,7 @@ static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
 			free_chance = full_pct * (0x80000000U / target);
 		}
 
-		return rand32() > free_chance;
+		return rand32(sr) > free_chance;
 	}
 }
 
@@ -80,20 +93,69 @@ static bool rand_alloc_choice(struct z_heap_stress_rec *sr)
  */
 static size_t rand_alloc_size(struct z_heap_stress_rec *sr)
 {
-	ARG_UNUSED(sr);
-
 	/* Min scale of 4 means that the half of the requests in the
 	 * smallest size have an average size of 8
 	 */
-	int scale = 4 + __builtin_clz(rand32());
+	int scale = 4 + __builtin_clz(rand32(sr));
 
-	return rand32() & BIT_MASK(scale);
+	return rand32(sr) & BIT_MASK(scale);
 }
 
 /* Returns the index of a randomly chosen block to free */
 static size_t rand_free_choice(struct z_heap_stress_rec *sr)
 {
-	return rand32() % sr->blocks_alloced;
+	return rand32(sr) % sr->blocks_alloced;
+}
+
+static void stress_run(struct z_heap_stress_rec *sr, uint32_t op_count,
+		       struct z_heap_stress_result *result)
+{
+	*result = (struct z_heap_stress_result) {0};
+
+	for (uint32_t i = 0; i < op_count; i++) {
+		if (rand_alloc_choice(sr)) {
+			size_t sz = rand_alloc_size(sr);
+			uint32_t t0 = k_cycle_get_32();
+			void *p = sr->alloc_fn(sr->arg, sz);
+			uint32_t dt = k_cycle_get_32() - t0;
+
+			result->total_allocs++;
+			result->max_alloc_cycles = MAX(result->max_alloc_cycles, dt);
+			if (p != NULL) {
+				result->successful_allocs++;
+				sr->blocks[sr->blocks_alloced].ptr = p;
+				sr->blocks[sr->blocks_alloced].sz = sz;
+				sr->blocks_alloced++;
+				sr->bytes_alloced += sz;
+				atomic_add(sr->heap_bytes, sz);
+			} else if ((size_t)atomic_get(sr->heap_bytes) + sz <=
+				   sr->heap_total_bytes) {
+				result->fragmented_allocs++;
+			}
+		} else {
+			int b = rand_free_choice(sr);
+			void *p = sr->blocks[b].ptr;
+			size_t sz = sr->blocks[b].sz;
+
+			result->total_frees++;
+			sr->blocks[b] = sr->blocks[sr->blocks_alloced - 1];
+			sr->blocks_alloced--;
+			sr->bytes_alloced -= sz;
+			atomic_sub(sr->heap_bytes, sz);
+			sr->free_fn(sr->arg, p);
+		}
+		result->accumulated_in_use_bytes += atomic_get(sr->heap_bytes);
+	}
+}
+
+static void stress_rate(struct z_heap_stress_result *result,
+			stress_cycles_t start)
+{
+	uint64_t cycles = (stress_cycles_t)(stress_cycle_get() - start);
+
+	result->allocs_per_sec = (uint32_t)(((uint64_t)result->total_allocs *
+					     sys_clock_hw_cycles_per_sec()) /
+					    MAX(cycles, 1U));
 }
 
 /* General purpose heap stress test.  Takes function pointers to allow
@@ -112,6 +174,7 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 		     int target_percent,
 		     struct z_heap_stress_result *result)
 {
+	atomic_t heap_bytes = ATOMIC_INIT(0);
 	struct z_heap_stress_rec sr = {
 	       .alloc_fn = alloc_fn,
 	       .free_fn = free_fn,
@@ -120,34 +183,84 @@ void sys_heap_stress(void *(*alloc_fn)(void *arg, size_t bytes),
 	       .blocks = scratch_mem,
 	       .nblocks = scratch_bytes / sizeof(struct z_heap_stress_block),
 	       .target_percent = target_percent,
+	       .rand_state = RAND_SEED,
+	       .heap_bytes = &heap_bytes,
+	       .heap_total_bytes = total_bytes,
 	};
+	stress_cycles_t start = stress_cycle_get();
 
-	*result = (struct z_heap_stress_result) {0};
+	stress_run(&sr, op_count, result);
+	stress_rate(result, start);
+}
 
-	for (uint32_t i = 0; i < op_count; i++) {
-		if (rand_alloc_choice(&sr)) {
-			size_t sz = rand_alloc_size(&sr);
-			void *p = sr.alloc_fn(sr.arg, sz);
+#ifdef CONFIG_MULTITHREADING
+static K_THREAD_STACK_ARRAY_DEFINE(stress_stacks, CONFIG_SYS_HEAP_STRESS_THREADS,
+				   CONFIG_SYS_HEAP_STRESS_STACK_SIZE);
+static struct k_thread stress_threads[CONFIG_SYS_HEAP_STRESS_THREADS];
 
-			result->total_allocs++;
-			if (p != NULL) {
-				result->successful_allocs++;
-				sr.blocks[sr.blocks_alloced].ptr = p;
-				sr.blocks[sr.blocks_alloced].sz = sz;
-				sr.blocks_alloced++;
-				sr.bytes_alloced += sz;
-			}
-		} else {
-			int b = rand_free_choice(&sr);
-			void *p = sr.blocks[b].ptr;
-			size_t sz = sr.blocks[b].sz;
+static void stress_thread(void *p1, void *p2, void *p3)
+{
+	stress_run(p1, POINTER_TO_UINT(p2), p3);
+}
 
-			result->total_frees++;
-			sr.blocks[b] = sr.blocks[sr.blocks_alloced - 1];
-			sr.blocks_alloced--;
-			sr.bytes_alloced -= sz;
-			sr.free_fn(sr.arg, p);
-		}
-		result->accumulated_in_use_bytes += sr.bytes_alloced;
+/* Runs the same test from several threads at once, each on its own
+ * share of the scratch memory and of the target fill.  The allocator
+ * callbacks must be thread safe.
+ */
+void sys_heap_stress_threaded(void *(*alloc_fn)(void *arg, size_t bytes),
+			      void (*free_fn)(void *arg, void *p),
+			      void *arg, size_t total_bytes,
+			      uint32_t op_count,
+			      void *scratch_mem, size_t scratch_bytes,
+			      int target_percent, int num_threads,
+			      struct z_heap_stress_result *result)
+{
+	struct z_heap_stress_rec sr[CONFIG_SYS_HEAP_STRESS_THREADS];
+	struct z_heap_stress_result res[CONFIG_SYS_HEAP_STRESS_THREADS];
+	size_t share = scratch_bytes / num_threads;
+	atomic_t heap_bytes = ATOMIC_INIT(0);
+	int prio = k_thread_priority_get(k_current_get());
+	stress_cycles_t start;
+
+	__ASSERT((num_threads > 0) && (num_threads <= CONFIG_SYS_HEAP_STRESS_THREADS),
+		 "too many threads");
+
+	for (int i = 0; i < num_threads; i++) {
+		sr[i] = (struct z_heap_stress_rec) {
+			.alloc_fn = alloc_fn,
+			.free_fn = free_fn,
+			.arg = arg,
+			.total_bytes = total_bytes / num_threads,
+			.blocks = (void *)((uint8_t *)scratch_mem + i * share),
+			.nblocks = share / sizeof(struct z_heap_stress_block),
+			.target_percent = target_percent,
+			.rand_state = RAND_SEED + i,
+			.heap_bytes = &heap_bytes,
+			.heap_total_bytes = total_bytes,
+		};
+		k_thread_create(&stress_threads[i], stress_stacks[i],
+				K_THREAD_STACK_SIZEOF(stress_stacks[i]),
+				stress_thread, &sr[i], UINT_TO_POINTER(op_count),
+				&res[i], prio, 0, K_FOREVER);
+	}
+
+	start = stress_cycle_get();
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_start(&stress_threads[i]);
+	}
+
+	*result = (struct z_heap_stress_result) {0};
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&stress_threads[i], K_FOREVER);
+
+		result->total_allocs += res[i].total_allocs;
+		result->successful_allocs += res[i].successful_allocs;
+		result->total_frees += res[i].total_frees;
+		result->accumulated_in_use_bytes += res[i].accumulated_in_use_bytes;
+		result->fragmented_allocs += res[i].fragmented_allocs;
+		result->max_alloc_cycles = MAX(result->max_alloc_cycles,
+					       res[i].max_alloc_cycles);
 	}
+	stress_rate(result, start);
 }
+#endif /* CONFIG_MULTITHREADING */
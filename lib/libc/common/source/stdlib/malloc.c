@@ -15,6 +15,7 @@
 #include <zephyr/sys/mutex.h>
 #endif
 #include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/heap_cache.h>
 #include <zephyr/sys/libc-hooks.h>
 #include <zephyr/types.h>
 #ifdef CONFIG_MMU
@@ -137,29 +138,56 @@ malloc_unlock(void)
 #define malloc_unlock()
 #endif
 
-void *malloc(size_t size)
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+static struct sys_heap_cache z_malloc_cache;
+
+static inline void *
+malloc_cache_alloc(size_t alignment, size_t size)
 {
-	malloc_lock();
+	return sys_heap_cache_alloc(&z_malloc_heap, alignment, size);
+}
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
-	if (ret == NULL && size != 0) {
-		errno = ENOMEM;
-	}
+static inline void *
+malloc_heap_alloc(size_t alignment, size_t size)
+{
+	return sys_heap_cache_refill(&z_malloc_heap, alignment, size);
+}
 
-	malloc_unlock();
+static inline void *
+malloc_cache_free(void *ptr)
+{
+	return sys_heap_cache_free(&z_malloc_heap, ptr);
+}
 
-	return ret;
+static inline void
+malloc_heap_free(void *ptr)
+{
+	sys_heap_cache_flush(&z_malloc_heap, ptr);
+}
+#else
+#define malloc_cache_alloc(alignment, size) NULL
+#define malloc_heap_alloc(alignment, size) \
+	sys_heap_aligned_alloc(&z_malloc_heap, alignment, size)
+#define malloc_cache_free(ptr) (ptr)
+#define malloc_heap_free(ptr) sys_heap_free(&z_malloc_heap, ptr)
+#endif
+
+void *malloc(size_t size)
+{
+	return aligned_alloc(__alignof__(z_max_align_t), size);
 }
 
 void *aligned_alloc(size_t alignment, size_t size)
 {
+	void *ret = malloc_cache_alloc(alignment, size);
+
+	if (ret != NULL) {
+		return ret;
+	}
+
 	malloc_lock();
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
+	ret = malloc_heap_alloc(alignment, size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -235,6 +263,11 @@ static int malloc_prepare(void)
 
 	sys_heap_init(&z_malloc_heap, heap_base, heap_size);
 
+#ifdef CONFIG_COMMON_LIBC_MALLOC_CACHE
+	sys_heap_cache_init(&z_malloc_cache, &z_malloc_heap,
+			    __alignof__(z_max_align_t));
+#endif
+
 	return 0;
 }
 
@@ -257,8 +290,13 @@ void *realloc(void *ptr, size_t requested_size)
 
 void free(void *ptr)
 {
+	ptr = malloc_cache_free(ptr);
+	if (ptr == NULL) {
+		return;
+	}
+
 	malloc_lock();
-	sys_heap_free(&z_malloc_heap, ptr);
+	malloc_heap_free(ptr);
 	malloc_unlock();
 }
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/condvar.h>
+
+#ifdef CONFIG_USERSPACE
+/*
+ * The futex holds a sequence number, bumped by each signal or broadcast,
+ * so a waiter which released the mutex and was signalled before calling
+ * k_futex_wait() does not sleep. Waiters are counted so signalling with
+ * no waiter is just an atomic read.
+ */
+int sys_condvar_init(struct sys_condvar *condvar)
+{
+	if (condvar == NULL) {
+		return -EINVAL;
+	}
+
+	(void)atomic_clear(&condvar->seq.val);
+	(void)atomic_clear(&condvar->waiters);
+
+	return 0;
+}
+
+static int condvar_wake(struct sys_condvar *condvar, bool wake_all)
+{
+	int ret;
+
+	if (atomic_get(&condvar->waiters) == 0) {
+		return 0;
+	}
+
+	(void)atomic_inc(&condvar->seq.val);
+	ret = k_futex_wake(&condvar->seq, wake_all);
+
+	return (ret < 0) ? ret : 0;
+}
+
+int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	return condvar_wake(condvar, false);
+}
+
+int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	return condvar_wake(condvar, true);
+}
+
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout)
+{
+	atomic_val_t seq;
+	int ret;
+
+	(void)atomic_inc(&condvar->waiters);
+	seq = atomic_get(&condvar->seq.val);
+
+	ret = sys_mutex_unlock(mutex);
+	if (ret != 0) {
+		(void)atomic_dec(&condvar->waiters);
+		return ret;
+	}
+
+	ret = k_futex_wait(&condvar->seq, seq, timeout);
+	(void)atomic_dec(&condvar->waiters);
+
+	(void)sys_mutex_lock(mutex, K_FOREVER);
+
+	/* -EAGAIN: signalled before we could wait */
+	return (ret == -EAGAIN) ? 0 : ret;
+}
+#else
+int sys_condvar_init(struct sys_condvar *condvar)
+{
+	return k_condvar_init(&condvar->kernel_condvar);
+}
+
+int sys_condvar_signal(struct sys_condvar *condvar)
+{
+	return k_condvar_signal(&condvar->kernel_condvar);
+}
+
+int sys_condvar_broadcast(struct sys_condvar *condvar)
+{
+	int ret = k_condvar_broadcast(&condvar->kernel_condvar);
+
+	return (ret < 0) ? ret : 0;
+}
+
+int sys_condvar_wait(struct sys_condvar *condvar, struct sys_mutex *mutex,
+		     k_timeout_t timeout)
+{
+	int ret;
+
+	ret = k_condvar_wait(&condvar->kernel_condvar, &mutex->kernel_mutex,
+			     timeout);
+	if (ret == -EAGAIN) {
+		ret = -ETIMEDOUT;
+	}
+
+	return ret;
+}
+#endif
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/rwlock.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_USERSPACE
+/*
+ * Futex value: number of readers, or RWLOCK_WRITER when taken for
+ * writing, with RWLOCK_WAITERS set while threads sleep on the futex.
+ * Whoever releases the lock last wakes them all up to try again.
+ */
+#define RWLOCK_WRITER  BIT(30)
+#define RWLOCK_WAITERS BIT(29)
+#define RWLOCK_READERS (RWLOCK_WAITERS - 1)
+
+int sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	if (rwlock == NULL) {
+		return -EINVAL;
+	}
+
+	(void)atomic_clear(&rwlock->state.val);
+
+	return 0;
+}
+
+/* Take <rwlock> once it does not have any of the <busy> bits set */
+static int rwlock_take(struct sys_rwlock *rwlock, atomic_val_t busy,
+		       atomic_val_t inc, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	atomic_val_t v;
+	int ret;
+
+	for (;;) {
+		v = atomic_get(&rwlock->state.val);
+
+		if ((v & busy) == 0) {
+			if (atomic_cas(&rwlock->state.val, v, v + inc)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (((v & RWLOCK_WAITERS) == 0) &&
+		    !atomic_cas(&rwlock->state.val, v, v | RWLOCK_WAITERS)) {
+			continue;
+		}
+
+		ret = k_futex_wait(&rwlock->state, v | RWLOCK_WAITERS,
+				   sys_timepoint_timeout(end));
+		if ((ret != 0) && (ret != -EAGAIN)) {
+			return ret;
+		}
+	}
+}
+
+int sys_rwlock_rdlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return rwlock_take(rwlock, RWLOCK_WRITER, 1, timeout);
+}
+
+int sys_rwlock_wrlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return rwlock_take(rwlock, RWLOCK_WRITER | RWLOCK_READERS,
+			   RWLOCK_WRITER, timeout);
+}
+
+int sys_rwlock_unlock(struct sys_rwlock *rwlock)
+{
+	atomic_val_t v, new_v;
+
+	do {
+		v = atomic_get(&rwlock->state.val);
+
+		if ((v & RWLOCK_WRITER) != 0) {
+			new_v = 0;
+		} else if ((v & RWLOCK_READERS) != 0) {
+			new_v = v - 1;
+			if ((new_v & RWLOCK_READERS) == 0) {
+				new_v = 0;
+			}
+		} else {
+			return -EPERM;
+		}
+	} while (!atomic_cas(&rwlock->state.val, v, new_v));
+
+	if ((new_v == 0) && ((v & RWLOCK_WAITERS) != 0)) {
+		int ret = k_futex_wake(&rwlock->state, true);
+
+		return (ret < 0) ? ret : 0;
+	}
+
+	return 0;
+}
+#else
+#define RWLOCK_WRITER (-1)
+
+int sys_rwlock_init(struct sys_rwlock *rwlock)
+{
+	if (rwlock == NULL) {
+		return -EINVAL;
+	}
+
+	k_mutex_init(&rwlock->lock);
+	k_condvar_init(&rwlock->cond);
+	rwlock->state = 0;
+
+	return 0;
+}
+
+static int rwlock_take(struct sys_rwlock *rwlock, bool write,
+		       k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	int ret = 0;
+
+	(void)k_mutex_lock(&rwlock->lock, K_FOREVER);
+
+	while ((rwlock->state == RWLOCK_WRITER) || (write && (rwlock->state != 0))) {
+		ret = k_condvar_wait(&rwlock->cond, &rwlock->lock,
+				     sys_timepoint_timeout(end));
+		if (ret != 0) {
+			ret = -ETIMEDOUT;
+			break;
+		}
+	}
+
+	if (ret == 0) {
+		rwlock->state = write ? RWLOCK_WRITER : (rwlock->state + 1);
+	}
+
+	(void)k_mutex_unlock(&rwlock->lock);
+
+	return ret;
+}
+
+int sys_rwlock_rdlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return rwlock_take(rwlock, false, timeout);
+}
+
+int sys_rwlock_wrlock(struct sys_rwlock *rwlock, k_timeout_t timeout)
+{
+	return rwlock_take(rwlock, true, timeout);
+}
+
+int sys_rwlock_unlock(struct sys_rwlock *rwlock)
+{
+	int ret = 0;
+
+	(void)k_mutex_lock(&rwlock->lock, K_FOREVER);
+
+	if (rwlock->state == RWLOCK_WRITER) {
+		rwlock->state = 0;
+	} else if (rwlock->state > 0) {
+		rwlock->state--;
+	} else {
+		ret = -EPERM;
+	}
+
+	if ((ret == 0) && (rwlock->state == 0)) {
+		(void)k_condvar_broadcast(&rwlock->cond);
+	}
+
+	(void)k_mutex_unlock(&rwlock->lock);
+
+	return ret;
+}
+#endif
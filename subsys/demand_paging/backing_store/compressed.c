@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM backing store
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Evicted data pages are compressed into a pool managed by a sys_heap, so
+ * the backing store holds more pages than the RAM it takes, as long as
+ * the paged out data compresses.
+ *
+ * A location token is the index of an entry in a table holding the block
+ * and compressed length of each stored page, times the page size.
+ *
+ * The compressed size of a page is not known when its location is
+ * reserved, and k_mem_paging_backing_store_page_out() cannot fail. So a
+ * whole page is allocated from the pool when a location is handed out,
+ * then shrunk in place once the page has been compressed into it. A page
+ * which does not compress is kept as is.
+ *
+ * To honor the page_fault argument of
+ * k_mem_paging_backing_store_location_get(), one page worth of pool is
+ * held back for page faults, and handed out only when the pool has no
+ * other room left.
+ *
+ * Like the RAM backing store, locations are freed as soon as pages are
+ * paged back in, which returns their memory to the pool.
+ */
+
+#define NUM_SLOTS CONFIG_BACKING_STORE_COMPRESSED_PAGES
+
+BUILD_ASSERT(CONFIG_MMU_PAGE_SIZE <= UINT16_MAX + 1,
+	     "match offsets must fit in 16 bits");
+
+struct slot {
+	/* Pool block holding the page, NULL if the slot is free */
+	uint8_t *data;
+	/* Bytes used in the block, CONFIG_MMU_PAGE_SIZE if not compressed,
+	 * 0 until the page is stored
+	 */
+	size_t len;
+};
+
+static struct slot slots[NUM_SLOTS];
+static unsigned int free_slots;
+
+static char pool_mem[CONFIG_BACKING_STORE_COMPRESSED_POOL_SIZE] __aligned(sizeof(void *));
+static struct sys_heap pool;
+static void *fault_reserve;
+
+/* Page-outs may run with interrupts enabled, concurrently with location
+ * requests, so the pool and the table have their own lock.
+ */
+static struct k_spinlock pool_lock;
+
+#ifdef CONFIG_DEMAND_PAGING_STATS
+extern struct k_mem_paging_stats_t paging_stats;
+#endif
+
+/*
+ * LZ77 codec with an LZ4-like sequence format. Each sequence is a token
+ * byte holding the literal count and the match length minus
+ * LZ_MIN_MATCH in its high and low nibbles, with 15 meaning that more
+ * length bytes follow, then the literals, then a 16-bit little endian
+ * match offset. The last sequence carries literals only.
+ *
+ * Matches are found through a hash table of recent 4-byte sequences. It
+ * is only used under the backing store serialization, so a single static
+ * table is enough.
+ */
+#define LZ_MIN_MATCH 4U
+#define LZ_HASH_BITS 10U
+
+static uint16_t lz_table[BIT(LZ_HASH_BITS)];
+
+static inline uint32_t lz_read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	(void)memcpy(&v, p, sizeof(v));
+
+	return v;
+}
+
+static inline uint32_t lz_hash(uint32_t v)
+{
+	return (v * 2654435761U) >> (32U - LZ_HASH_BITS);
+}
+
+static uint8_t *lz_put_len(uint8_t *op, const uint8_t *oend, size_t len)
+{
+	for (; len >= 255U; len -= 255U) {
+		if (op >= oend) {
+			return NULL;
+		}
+		*op++ = 255U;
+	}
+
+	if (op >= oend) {
+		return NULL;
+	}
+	*op++ = (uint8_t)len;
+
+	return op;
+}
+
+/* A zero match_len ends the stream */
+static uint8_t *lz_put_seq(uint8_t *op, const uint8_t *oend, const uint8_t *lit,
+			   size_t lit_len, size_t match_len, size_t offset)
+{
+	size_t mlen = (match_len != 0U) ? (match_len - LZ_MIN_MATCH) : 0U;
+	uint8_t *token = op++;
+
+	if (op > oend) {
+		return NULL;
+	}
+	*token = (uint8_t)((MIN(lit_len, 15U) << 4) | MIN(mlen, 15U));
+
+	if (lit_len >= 15U) {
+		op = lz_put_len(op, oend, lit_len - 15U);
+		if (op == NULL) {
+			return NULL;
+		}
+	}
+
+	if ((size_t)(oend - op) < lit_len) {
+		return NULL;
+	}
+	(void)memcpy(op, lit, lit_len);
+	op += lit_len;
+
+	if (match_len == 0U) {
+		return op;
+	}
+
+	if ((oend - op) < 2) {
+		return NULL;
+	}
+	*op++ = (uint8_t)(offset & 0xFFU);
+	*op++ = (uint8_t)(offset >> 8);
+
+	if (mlen >= 15U) {
+		op = lz_put_len(op, oend, mlen - 15U);
+	}
+
+	return op;
+}
+
+/* Returns the compressed length, or 0 if it exceeds dst_size */
+static size_t lz_compress(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_size)
+{
+	const uint8_t *ip = src;
+	const uint8_t *anchor = src;
+	const uint8_t *iend = src + len;
+	const uint8_t *ilimit = iend - LZ_MIN_MATCH;
+	uint8_t *op = dst;
+	const uint8_t *oend = dst + dst_size;
+
+	(void)memset(lz_table, 0, sizeof(lz_table));
+
+	while (ip <= ilimit) {
+		uint32_t seq = lz_read32(ip);
+		uint32_t h = lz_hash(seq);
+		const uint8_t *ref = src + lz_table[h];
+		const uint8_t *mp;
+
+		lz_table[h] = (uint16_t)(ip - src);
+
+		if ((ref >= ip) || (lz_read32(ref) != seq)) {
+			ip++;
+			continue;
+		}
+
+		mp = ip + LZ_MIN_MATCH;
+		ref += LZ_MIN_MATCH;
+		while ((mp < iend) && (*mp == *ref)) {
+			mp++;
+			ref++;
+		}
+
+		op = lz_put_seq(op, oend, anchor, ip - anchor, mp - ip, mp - ref);
+		if (op == NULL) {
+			return 0;
+		}
+
+		ip = mp;
+		anchor = ip;
+	}
+
+	op = lz_put_seq(op, oend, anchor, iend - anchor, 0, 0);
+
+	return (op != NULL) ? (size_t)(op - dst) : 0U;
+}
+
+static inline size_t lz_get_len(const uint8_t **ip, size_t len)
+{
+	uint8_t b;
+
+	do {
+		b = *(*ip)++;
+		len += b;
+	} while (b == 255U);
+
+	return len;
+}
+
+static void lz_decompress(const uint8_t *src, size_t len, uint8_t *dst, size_t dst_size)
+{
+	const uint8_t *ip = src;
+	const uint8_t *iend = src + len;
+	uint8_t *op = dst;
+
+	while (ip < iend) {
+		uint8_t token = *ip++;
+		size_t lit_len = token >> 4;
+		size_t mlen = token & 0xFU;
+		const uint8_t *ref;
+		size_t offset;
+
+		if (lit_len == 15U) {
+			lit_len = lz_get_len(&ip, lit_len);
+		}
+		(void)memcpy(op, ip, lit_len);
+		ip += lit_len;
+		op += lit_len;
+
+		if (ip >= iend) {
+			break;
+		}
+
+		offset = ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+		if (mlen == 15U) {
+			mlen = lz_get_len(&ip, mlen);
+		}
+		mlen += LZ_MIN_MATCH;
+
+		/* Matches may overlap their own output */
+		for (ref = op - offset; mlen > 0U; mlen--) {
+			*op++ = *ref++;
+		}
+	}
+
+	__ASSERT(op == dst + dst_size, "corrupted page, %zu of %zu bytes",
+		 (size_t)(op - dst), dst_size);
+}
+
+static struct slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location < (NUM_SLOTS * CONFIG_MMU_PAGE_SIZE),
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static inline void stats_update(long pages, long incompressible, long bytes)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.compression.pages += pages;
+	paging_stats.compression.incompressible += incompressible;
+	paging_stats.compression.bytes += bytes;
+#endif
+}
+
+int k_mem_paging_backing_store_location_get(struct k_mem_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+	unsigned int i;
+	void *block;
+
+	if ((!page_fault && free_slots == 1) || free_slots == 0) {
+		k_spin_unlock(&pool_lock, key);
+		return -ENOMEM;
+	}
+
+	block = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	if (block == NULL) {
+		if (!page_fault || fault_reserve == NULL) {
+			k_spin_unlock(&pool_lock, key);
+			return -ENOMEM;
+		}
+		block = fault_reserve;
+		fault_reserve = NULL;
+	}
+
+	for (i = 0; slots[i].data != NULL; i++) {
+	}
+
+	slots[i].data = block;
+	slots[i].len = 0;
+	free_slots--;
+	*location = i * CONFIG_MMU_PAGE_SIZE;
+
+	k_spin_unlock(&pool_lock, key);
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+
+	sys_heap_free(&pool, slot->data);
+	free_slots++;
+
+	if (slot->len != 0U) {
+		stats_update(-1, (slot->len == CONFIG_MMU_PAGE_SIZE) ? -1 : 0,
+			     -(long)slot->len);
+	}
+
+	slot->data = NULL;
+	slot->len = 0;
+
+	if (fault_reserve == NULL) {
+		fault_reserve = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	}
+
+	k_spin_unlock(&pool_lock, key);
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	k_spinlock_key_t key;
+	size_t len;
+
+	/* Stop as soon as compression saves less than a word */
+	len = lz_compress(K_MEM_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE, slot->data,
+			  CONFIG_MMU_PAGE_SIZE - sizeof(void *));
+	if (len == 0U) {
+		(void)memcpy(slot->data, K_MEM_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE);
+	}
+
+	key = k_spin_lock(&pool_lock);
+	if (len == 0U) {
+		slot->len = CONFIG_MMU_PAGE_SIZE;
+		stats_update(1, 1, CONFIG_MMU_PAGE_SIZE);
+	} else {
+		/* Shrinking a block never moves it, but do not rely on it */
+		slot->data = sys_heap_realloc(&pool, slot->data, len);
+		__ASSERT(slot->data != NULL, "shrinking a pool block failed");
+		slot->len = len;
+		stats_update(1, 0, (long)len);
+	}
+	k_spin_unlock(&pool_lock, key);
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+
+	if (slot->len == CONFIG_MMU_PAGE_SIZE) {
+		(void)memcpy(K_MEM_SCRATCH_PAGE, slot->data, CONFIG_MMU_PAGE_SIZE);
+	} else {
+		lz_decompress(slot->data, slot->len, K_MEM_SCRATCH_PAGE,
+			      CONFIG_MMU_PAGE_SIZE);
+	}
+}
+
+void k_mem_paging_backing_store_page_finalize(struct k_mem_page_frame *pf,
+					      uintptr_t location)
+{
+#ifdef CONFIG_DEMAND_MAPPING
+	/* ignore those */
+	if (location == ARCH_UNPAGED_ANON_ZERO || location == ARCH_UNPAGED_ANON_UNINIT) {
+		return;
+	}
+#endif
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	sys_heap_init(&pool, pool_mem, sizeof(pool_mem));
+	fault_reserve = sys_heap_alloc(&pool, CONFIG_MMU_PAGE_SIZE);
+	__ASSERT(fault_reserve != NULL, "pool smaller than a page");
+	free_slots = NUM_SLOTS;
+}
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK-Pro eviction algorithm for demand paging.
+ *
+ * Theory of Operation:
+ *
+ * - Evictable page frames are either cold or hot, and kept on a cold and a
+ *   hot clock. A clock is a queue: the hand is its head, and moving the hand
+ *   past a page frame moves it to the tail.
+ *
+ * - Page frames made evictable with k_mem_paging_eviction_add() start cold.
+ *   The first time the cold hand reaches a cold page frame that was
+ *   accessed, typically by the access which paged it in, it enters its test
+ *   period. If it is accessed again before the cold hand comes back, it is
+ *   promoted to hot. Otherwise it is evicted.
+ *
+ * - A page evicted during its test period is remembered by virtual address
+ *   in a small ring of non-resident pages. If it is paged in again while
+ *   still there, it comes back hot, and the share of cold pages is
+ *   increased, since its reuse distance was just above what the cold clock
+ *   holds. When a non-resident page falls off the ring, that share is
+ *   decreased.
+ *
+ * - Whenever there are more hot pages than the target allows, the hot hand
+ *   demotes hot page frames which were not accessed since it last passed.
+ *
+ * Pages touched once, as in a scan through a large buffer, only ever go
+ * through the cold clock, so they do not push the working set out of
+ * memory.
+ *
+ * Accesses are detected through the ARCH_DATA_PAGE_ACCESSED flag, which is
+ * cleared each time a hand passes, and through
+ * k_mem_paging_eviction_accessed() on architectures which fault on accesses
+ * to pages whose flag was cleared.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel/mm/demand_paging.h>
+#include <zephyr/spinlock.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/*
+ * As with the LRU algorithm, queues are linked through an array of page
+ * frame indexes. Slots 0 and 1 are the cold and hot list heads, page frame
+ * indexes are offset by 2.
+ */
+#define PF_IDX_BITS ROUND_UP(LOG2CEIL(K_MEM_NUM_PAGE_FRAMES + 2), 8)
+
+#define COLD 0U
+#define HOT  1U
+
+struct cp_pf_idx {
+	uint32_t next : PF_IDX_BITS;
+	uint32_t prev : PF_IDX_BITS;
+} __packed;
+
+/* Page frame state */
+#define CP_QUEUED BIT(0)
+#define CP_HOT    BIT(1)
+#define CP_TEST   BIT(2)
+#define CP_REF    BIT(3)
+
+#define NUM_GHOSTS CONFIG_EVICTION_CLOCK_PRO_NON_RESIDENT
+
+static struct cp_pf_idx cp_queue[K_MEM_NUM_PAGE_FRAMES + 2];
+static uint8_t cp_state[K_MEM_NUM_PAGE_FRAMES + 2];
+static uint32_t cp_count[2];
+static uint32_t cold_target;
+
+/* Non-resident pages in their test period, as virtual address | 1 */
+static uintptr_t ghosts[NUM_GHOSTS];
+static uint32_t ghost_pos;
+
+static struct k_spinlock cp_lock;
+
+static inline uint32_t pf_to_idx(struct k_mem_page_frame *pf)
+{
+	return (pf - k_mem_page_frames) + 2;
+}
+
+static inline struct k_mem_page_frame *idx_to_pf(uint32_t idx)
+{
+	return &k_mem_page_frames[idx - 2];
+}
+
+static inline uint32_t cp_head(uint32_t list)
+{
+	return cp_queue[list].next;
+}
+
+static inline void cp_append(uint32_t list, uint32_t idx)
+{
+	uint32_t tail = cp_queue[list].prev;
+
+	cp_queue[idx].next = list;
+	cp_queue[idx].prev = tail;
+	cp_queue[tail].next = idx;
+	cp_queue[list].prev = idx;
+	cp_count[list]++;
+}
+
+static inline void cp_unlink(uint32_t idx)
+{
+	uint32_t next = cp_queue[idx].next;
+	uint32_t prev = cp_queue[idx].prev;
+
+	cp_queue[prev].next = next;
+	cp_queue[next].prev = prev;
+	cp_count[((cp_state[idx] & CP_HOT) != 0U) ? HOT : COLD]--;
+}
+
+static inline void cp_move(uint32_t idx, uint8_t state)
+{
+	cp_unlink(idx);
+	cp_state[idx] = state | CP_QUEUED;
+	cp_append(((state & CP_HOT) != 0U) ? HOT : COLD, idx);
+}
+
+/* Whether the page frame was accessed since the last call */
+static bool cp_referenced(uint32_t idx)
+{
+	void *addr = k_mem_page_frame_to_virt(idx_to_pf(idx));
+	uintptr_t flags = arch_page_info_get(addr, NULL, true);
+	bool ref = ((flags & ARCH_DATA_PAGE_ACCESSED) != 0U) ||
+		   ((cp_state[idx] & CP_REF) != 0U);
+
+	cp_state[idx] &= ~CP_REF;
+
+	return ref;
+}
+
+static inline uintptr_t ghost_tag(void *addr)
+{
+	return POINTER_TO_UINT(addr) | 1U;
+}
+
+static void ghost_put(void *addr)
+{
+	if ((ghosts[ghost_pos] != 0U) && (cold_target > 1U)) {
+		/* A test period ended without the page being reused */
+		cold_target--;
+	}
+
+	ghosts[ghost_pos] = ghost_tag(addr);
+	ghost_pos = (ghost_pos + 1U) % NUM_GHOSTS;
+}
+
+static bool ghost_take(void *addr)
+{
+	uintptr_t tag = ghost_tag(addr);
+
+	for (uint32_t i = 0; i < NUM_GHOSTS; i++) {
+		if (ghosts[i] == tag) {
+			ghosts[i] = 0U;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Demote hot page frames until the hot clock is within its target */
+static void cp_run_hot_hand(void)
+{
+	uint32_t total = cp_count[COLD] + cp_count[HOT];
+	uint32_t hot_target = total - MIN(cold_target, total);
+	uint32_t budget = 2U * cp_count[HOT];
+
+	while (cp_count[HOT] > hot_target) {
+		uint32_t idx = cp_head(HOT);
+
+		if ((budget > 0U) && cp_referenced(idx)) {
+			cp_move(idx, CP_HOT);
+			budget--;
+		} else {
+			cp_move(idx, 0U);
+		}
+	}
+}
+
+void k_mem_paging_eviction_add(struct k_mem_page_frame *pf)
+{
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&cp_lock);
+
+	__ASSERT(k_mem_page_frame_is_evictable(pf), "");
+	__ASSERT((cp_state[pf_idx] & CP_QUEUED) == 0U, "");
+
+	if (ghost_take(k_mem_page_frame_to_virt(pf))) {
+		if (cold_target < K_MEM_NUM_PAGE_FRAMES) {
+			cold_target++;
+		}
+		cp_state[pf_idx] = CP_QUEUED | CP_HOT;
+		cp_append(HOT, pf_idx);
+		cp_run_hot_hand();
+	} else {
+		cp_state[pf_idx] = CP_QUEUED;
+		cp_append(COLD, pf_idx);
+	}
+
+	k_spin_unlock(&cp_lock, key);
+}
+
+void k_mem_paging_eviction_remove(struct k_mem_page_frame *pf)
+{
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&cp_lock);
+
+	__ASSERT((cp_state[pf_idx] & CP_QUEUED) != 0U, "");
+	cp_unlink(pf_idx);
+	cp_state[pf_idx] = 0U;
+	k_spin_unlock(&cp_lock, key);
+}
+
+void k_mem_paging_eviction_accessed(uintptr_t phys)
+{
+	struct k_mem_page_frame *pf = k_mem_phys_to_page_frame(phys);
+	uint32_t pf_idx = pf_to_idx(pf);
+	k_spinlock_key_t key = k_spin_lock(&cp_lock);
+
+	if ((cp_state[pf_idx] & CP_QUEUED) != 0U) {
+		cp_state[pf_idx] |= CP_REF;
+	}
+	k_spin_unlock(&cp_lock, key);
+}
+
+struct k_mem_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	k_spinlock_key_t key = k_spin_lock(&cp_lock);
+	uint32_t budget = 2U * (cp_count[COLD] + cp_count[HOT]);
+	struct k_mem_page_frame *pf = NULL;
+	uint32_t idx;
+	uintptr_t flags;
+	void *addr;
+
+	if ((cp_count[COLD] + cp_count[HOT]) == 0U) {
+		goto out;
+	}
+
+	for (;;) {
+		if (cp_count[COLD] == 0U) {
+			/* Everything is hot: demote the next hot page frame */
+			cp_move(cp_head(HOT), 0U);
+		}
+
+		idx = cp_head(COLD);
+		if ((budget == 0U) || !cp_referenced(idx)) {
+			break;
+		}
+		budget--;
+
+		if ((cp_state[idx] & CP_TEST) != 0U) {
+			cp_move(idx, CP_HOT);
+			cp_run_hot_hand();
+		} else {
+			cp_move(idx, CP_TEST);
+		}
+	}
+
+	pf = idx_to_pf(idx);
+	addr = k_mem_page_frame_to_virt(pf);
+	if ((cp_state[idx] & CP_TEST) != 0U) {
+		ghost_put(addr);
+	}
+
+	flags = arch_page_info_get(addr, NULL, false);
+	__ASSERT(k_mem_page_frame_is_evictable(pf), "");
+	*dirty_ptr = ((flags & ARCH_DATA_PAGE_DIRTY) != 0);
+
+out:
+	k_spin_unlock(&cp_lock, key);
+
+	return pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+	cp_queue[COLD].next = COLD;
+	cp_queue[COLD].prev = COLD;
+	cp_queue[HOT].next = HOT;
+	cp_queue[HOT].prev = HOT;
+	cold_target = MAX(K_MEM_NUM_PAGE_FRAMES / 4U, 1U);
+}
@@ -136,6 +136,19 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 		 (IS_ENABLED(CONFIG_LOG_MEM_UTILIZATION) ?
 		  MPSC_PBUF_MAX_UTILIZATION : 0)
 };
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* Each CPU logs into its own slice of buf32, so producers on different CPUs
+ * never share a buffer lock. Slices are kept message aligned.
+ */
+#define CPU_BUF_WLEN ROUND_DOWN(ARRAY_SIZE(buf32) / CONFIG_MP_MAX_NUM_CPUS, \
+				MAX(1U, Z_LOG_MSG_ALIGNMENT / sizeof(int)))
+
+static struct mpsc_pbuf_buffer cpu_log_buffer[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Message claimed from each CPU buffer which waits to be merged. */
+static union log_msg_generic *cpu_log_msg[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 #endif
 
 /* Check that default tag can fit in tag buffer. */
@@ -639,8 +652,89 @@ void z_log_msg_init(void)
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = &buf32[i * CPU_BUF_WLEN];
+		config.size = CPU_BUF_WLEN;
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+		cpu_log_msg[i] = NULL;
+	}
+	curr_log_buffer = &cpu_log_buffer[0];
+#endif
+}
+
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* The caller may migrate right after the CPU id is read. The message then
+ * lands in another CPU's buffer, which is still correct as each buffer keeps
+ * its own lock.
+ */
+static inline struct mpsc_pbuf_buffer *local_buffer(void)
+{
+	return &cpu_log_buffer[arch_curr_cpu()->id];
+}
+
+/* A message may be committed on another CPU than the one it was allocated
+ * on, so its buffer is found from its address.
+ */
+static inline struct mpsc_pbuf_buffer *msg_buffer(const struct log_msg *msg)
+{
+	size_t idx = ((const uint32_t *)msg - buf32) / CPU_BUF_WLEN;
+
+	__ASSERT_NO_MSG(idx < ARRAY_SIZE(cpu_log_buffer));
+
+	return &cpu_log_buffer[idx];
+}
+
+/* True if timestamp <a> is older than <b>, allowing for wraparound. */
+static inline bool timestamp_before(log_timestamp_t a, log_timestamp_t b)
+{
+#ifdef CONFIG_LOG_TIMESTAMP_64BIT
+	return (int64_t)(a - b) < 0;
+#else
+	return (int32_t)(a - b) < 0;
+#endif
 }
 
+/* Messages in a CPU buffer are in allocation order, which matches timestamp
+ * order unless an interrupt logged between allocation and commit. Merging by
+ * the timestamp of the head of each buffer is therefore enough.
+ */
+static union log_msg_generic *cpu_msg_claim_oldest(void)
+{
+	union log_msg_generic *msg = NULL;
+	log_timestamp_t t_min = 0;
+	int chosen = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		log_timestamp_t t;
+
+		if (cpu_log_msg[i] == NULL) {
+			cpu_log_msg[i] =
+				(union log_msg_generic *)mpsc_pbuf_claim(&cpu_log_buffer[i]);
+			if (cpu_log_msg[i] == NULL) {
+				continue;
+			}
+		}
+
+		t = log_msg_get_timestamp(&cpu_log_msg[i]->log);
+		if ((msg == NULL) || timestamp_before(t, t_min)) {
+			t_min = t;
+			msg = cpu_log_msg[i];
+			chosen = i;
+		}
+	}
+
+	if (msg != NULL) {
+		cpu_log_msg[chosen] = NULL;
+		curr_log_buffer = &cpu_log_buffer[chosen];
+	}
+
+	return msg;
+}
+#endif /* CONFIG_LOG_PER_CPU_BUFFERS */
+
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 {
 	if (!IS_ENABLED(CONFIG_LOG_MODE_DEFERRED)) {
@@ -656,7 +750,11 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	return msg_alloc(local_buffer(), wlen);
+#else
 	return msg_alloc(&log_buffer, wlen);
+#endif
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -678,7 +776,11 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	msg_commit(msg_buffer(msg), msg);
+#else
 	msg_commit(&log_buffer, msg);
+#endif
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -760,6 +862,11 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 
 union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	ARG_UNUSED(backoff);
+
+	return cpu_msg_claim_oldest();
+#else
 	size_t len;
 
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
@@ -770,6 +877,7 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	}
 
 	return z_log_msg_local_claim();
+#endif
 }
 
 static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generic *msg)
@@ -795,6 +903,15 @@ static bool msg_pending(struct mpsc_pbuf_buffer *buffer)
 
 bool z_log_msg_pending(void)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		if ((cpu_log_msg[i] != NULL) || msg_pending(&cpu_log_buffer[i])) {
+			return true;
+		}
+	}
+
+	return false;
+#else
 	size_t len;
 	int i = 0;
 
@@ -821,6 +938,7 @@ bool z_log_msg_pending(void)
 	}
 
 	return false;
+#endif
 }
 
 void z_log_msg_enqueue(const struct log_link *link, const void *data, size_t len)
@@ -880,7 +998,21 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	*buf_size = 0;
+	*usage = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		uint32_t size;
+		uint32_t now;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &size, &now);
+		*buf_size += size;
+		*usage += now;
+	}
+#else
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+#endif
 
 	return 0;
 }
@@ -893,7 +1025,27 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* Every CPU buffer has the same size, so the busiest one tells how
+	 * large the whole buffer must be.
+	 */
+	*max = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		uint32_t cpu_max;
+		int err = mpsc_pbuf_get_max_utilization(&cpu_log_buffer[i], &cpu_max);
+
+		if (err < 0) {
+			return err;
+		}
+
+		*max = MAX(*max, cpu_max * ARRAY_SIZE(cpu_log_buffer));
+	}
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
@@ -17,6 +17,8 @@
 LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/net/net_core.h>
@@ -116,6 +118,116 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+/*
+ * Received UDP and TCP packets are demultiplexed through hash tables
+ * instead of walking conn_used: conn_demux_exact holds the connections
+ * bound to both ports and to a remote address, hashed by all of them,
+ * conn_demux_port the other connections bound to a local port, hashed
+ * by it, and conn_demux_wild everything else.
+ *
+ * The tables are only changed with conn_lock held, between
+ * conn_demux_write_begin() and conn_demux_write_end(). Lookups do not
+ * take the lock: like a seqlock, they check conn_demux_gen did not
+ * change while they were walking the lists, and look again with the lock
+ * held if it did. Connections are never freed, so a lookup racing with a
+ * writer can only read stale entries, never invalid memory.
+ */
+static atomic_ptr_t conn_demux_exact[CONFIG_NET_CONN_HASH_BUCKETS];
+static atomic_ptr_t conn_demux_port[CONFIG_NET_CONN_HASH_BUCKETS];
+static atomic_ptr_t conn_demux_wild;
+static atomic_t conn_demux_gen;
+static uint32_t conn_demux_order;
+
+static uint32_t conn_demux_hash(uint16_t proto, uint16_t local_port,
+				uint16_t remote_port, const uint8_t *addr,
+				size_t len)
+{
+	uint32_t hash = ((uint32_t)remote_port << 16 | local_port) ^ proto;
+
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ addr[i]) * 16777619U;
+	}
+
+	hash ^= hash >> 16;
+	hash *= 0x45d9f3bU;
+	hash ^= hash >> 16;
+
+	return hash % CONFIG_NET_CONN_HASH_BUCKETS;
+}
+
+static atomic_ptr_t *conn_demux_bucket_get(struct net_conn *conn)
+{
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	const uint8_t *addr;
+	size_t len;
+
+	if ((conn->family != AF_INET && conn->family != AF_INET6 &&
+	     conn->family != AF_UNSPEC) || local_port == 0U) {
+		return &conn_demux_wild;
+	}
+
+	if (remote_port == 0U || !(conn->flags & NET_CONN_REMOTE_ADDR_SPEC)) {
+		return &conn_demux_port[conn_demux_hash(conn->proto, local_port,
+							0U, NULL, 0)];
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    conn->remote_addr.sa_family == AF_INET6) {
+		addr = net_sin6(&conn->remote_addr)->sin6_addr.s6_addr;
+		len = sizeof(struct in6_addr);
+	} else {
+		addr = (const uint8_t *)&net_sin(&conn->remote_addr)->sin_addr;
+		len = sizeof(struct in_addr);
+	}
+
+	return &conn_demux_exact[conn_demux_hash(conn->proto, local_port,
+						 remote_port, addr, len)];
+}
+
+static void conn_demux_write_begin(void)
+{
+	(void)atomic_inc(&conn_demux_gen);
+	barrier_dmem_fence_full();
+}
+
+static void conn_demux_write_end(void)
+{
+	barrier_dmem_fence_full();
+	(void)atomic_inc(&conn_demux_gen);
+}
+
+/* Must be called with conn_lock held, in a write section */
+static void conn_demux_add(struct net_conn *conn)
+{
+	atomic_ptr_t *bucket = conn_demux_bucket_get(conn);
+
+	conn->demux_bucket = bucket;
+	(void)atomic_ptr_set(&conn->demux_next, atomic_ptr_get(bucket));
+	(void)atomic_ptr_set(bucket, conn);
+}
+
+/* Must be called with conn_lock held, in a write section. The removed
+ * connection keeps pointing to its successor so a concurrent lookup
+ * standing on it can carry on.
+ */
+static void conn_demux_del(struct net_conn *conn)
+{
+	atomic_ptr_t *prev = conn->demux_bucket;
+	struct net_conn *cur;
+
+	while ((cur = atomic_ptr_get(prev)) != NULL) {
+		if (cur == conn) {
+			(void)atomic_ptr_set(prev, atomic_ptr_get(&conn->demux_next));
+			break;
+		}
+
+		prev = &cur->demux_next;
+	}
+
+	conn->demux_bucket = NULL;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -140,7 +252,11 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn->demux_order = ++conn_demux_order;
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_demux_write_begin();
+	conn_demux_add(conn);
+	conn_demux_write_end();
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -420,14 +536,14 @@ int net_conn_register(uint16_t proto, uint8_t family,
 		goto error;
 	}
 
+	conn->v6only = net_context_is_v6only_set(context);
+
 	if (handle) {
 		*handle = (struct net_conn_handle *)conn;
 	}
 
 	conn_set_used(conn);
 
-	conn->v6only = net_context_is_v6only_set(context);
-
 	conn_register_debug(conn, remote_port, local_port);
 
 	return 0;
@@ -452,6 +568,9 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_demux_write_begin();
+	conn_demux_del(conn);
+	conn_demux_write_end();
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -476,9 +595,17 @@ int net_conn_update(struct net_conn_handle *handle,
 		return -ENOENT;
 	}
 
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_demux_write_begin();
+
 	net_conn_change_callback(conn, cb, user_data);
 
+	conn_demux_del(conn);
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_demux_add(conn);
+
+	conn_demux_write_end();
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -634,6 +761,187 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_OK;
 }
 
+static bool conn_ip_addr_match(struct net_conn *conn, struct net_pkt *pkt,
+			       union net_ip_header *ip_hdr,
+			       uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && net_pkt_family(pkt) == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping */
+	}
+
+	return true;
+}
+
+/* Same checks as in the net_conn_input() loop, for unicast TCP/UDP */
+static bool conn_demux_match(struct net_conn *conn, struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr, uint8_t proto,
+			     uint16_t src_port, uint16_t dst_port)
+{
+	struct net_context *context = conn->context;
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	if (context != NULL && net_context_is_bound_to_iface(context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(context)) {
+		return false;
+	}
+
+	if (conn->family != AF_UNSPEC && conn->family != pkt_family) {
+		if (!IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6) ||
+		    !(conn->family == AF_INET6 && pkt_family == AF_INET &&
+		      !conn->v6only)) {
+			return false;
+		}
+	}
+
+	if (conn->proto != proto) {
+		return false;
+	}
+
+	return conn_ip_addr_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+/* Best ranked connection for a unicast TCP/UDP packet, the most recently
+ * registered one on a tie, as when walking conn_used. Stops after
+ * CONFIG_NET_MAX_CONN entries in case a concurrent update made us go
+ * around in circles, the caller then notices the generation change.
+ */
+static struct net_conn *conn_demux_lookup(struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  uint8_t proto,
+					  uint16_t src_port, uint16_t dst_port)
+{
+	atomic_ptr_t *buckets[3];
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	uint32_t best_order = 0U;
+	int count = 0;
+	const uint8_t *addr;
+	size_t len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		addr = ip_hdr->ipv6->src;
+		len = sizeof(struct in6_addr);
+	} else {
+		addr = ip_hdr->ipv4->src;
+		len = sizeof(struct in_addr);
+	}
+
+	buckets[0] = &conn_demux_exact[conn_demux_hash(proto, dst_port, src_port,
+						       addr, len)];
+	buckets[1] = &conn_demux_port[conn_demux_hash(proto, dst_port, 0U,
+						      NULL, 0)];
+	buckets[2] = &conn_demux_wild;
+
+	for (size_t i = 0; i < ARRAY_SIZE(buckets); i++) {
+		struct net_conn *conn;
+
+		/* Only fully specified connections can have the top rank,
+		 * and those are all in the exact match table.
+		 */
+		if (best_rank == NET_CONN_RANK(0xff)) {
+			break;
+		}
+
+		for (conn = atomic_ptr_get(buckets[i]);
+		     conn != NULL && count < CONFIG_NET_MAX_CONN;
+		     conn = atomic_ptr_get(&conn->demux_next), count++) {
+			int16_t rank;
+
+			if (!conn_demux_match(conn, pkt, ip_hdr, proto,
+					      src_port, dst_port)) {
+				continue;
+			}
+
+			rank = NET_CONN_RANK(conn->flags);
+			if (rank > best_rank ||
+			    (rank == best_rank &&
+			     (int32_t)(conn->demux_order - best_order) > 0)) {
+				best_match = conn;
+				best_rank = rank;
+				best_order = conn->demux_order;
+			}
+		}
+	}
+
+	return best_match;
+}
+
+/* Lock-free lookup, falling back to a locked one if it raced with a
+ * registration, removal or update. The callback and its user data are
+ * read along, as the connection may change as soon as we are done.
+ */
+static struct net_conn *conn_demux_find(struct net_pkt *pkt,
+					union net_ip_header *ip_hdr,
+					uint8_t proto,
+					uint16_t src_port, uint16_t dst_port,
+					net_conn_cb_t *cb, void **user_data)
+{
+	struct net_conn *conn;
+	atomic_val_t gen;
+
+	gen = atomic_get(&conn_demux_gen);
+	if ((gen & 1) == 0) {
+		barrier_dmem_fence_full();
+
+		conn = conn_demux_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+		if (conn != NULL) {
+			*cb = conn->cb;
+			*user_data = conn->user_data;
+		}
+
+		barrier_dmem_fence_full();
+
+		if (atomic_get(&conn_demux_gen) == gen) {
+			return conn;
+		}
+	}
+
+	k_mutex_lock(&conn_lock, K_FOREVER);
+
+	conn = conn_demux_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+	if (conn != NULL) {
+		*cb = conn->cb;
+		*user_data = conn->user_data;
+	}
+
+	k_mutex_unlock(&conn_lock);
+
+	return conn;
+}
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -708,6 +1016,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	/* Unicast TCP/UDP packets are delivered to a single connection,
+	 * which the demux tables find without walking all of them.
+	 */
+	if (IS_ENABLED(CONFIG_NET_IP) && (pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    ((IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) ||
+	     (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP)) &&
+	    !is_mcast_pkt) {
+		best_match = conn_demux_find(pkt, ip_hdr, proto, src_port, dst_port,
+					     &cb, &user_data);
+		goto deliver;
+	}
+
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
@@ -798,43 +1118,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 			/* Is the candidate connection matching the packet's TCP/UDP
 			 * address and port?
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			if (!conn_ip_addr_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -885,6 +1170,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_unlock(&conn_lock);
 
+deliver:
 	if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) && pkt_family == AF_PACKET) {
 		if (raw_pkt_continue) {
 			/* When there is open connection different than
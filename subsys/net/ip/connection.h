@@ -15,6 +15,7 @@
 
 #include <zephyr/types.h>
 
+#include <zephyr/sys/atomic.h>
 #include <zephyr/sys/util.h>
 
 #include <zephyr/net/net_context.h>
@@ -54,6 +55,15 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Next connection in the same demux hash bucket */
+	atomic_ptr_t demux_next;
+
+	/** Demux hash bucket this connection is linked in */
+	atomic_ptr_t *demux_bucket;
+
+	/** Registration order, newer connections win rank ties */
+	uint32_t demux_order;
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
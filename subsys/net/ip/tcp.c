@@ -58,11 +58,15 @@ static int tcp_tx_window =
 	CONFIG_NET_PKT_BUF_TX_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
+#define TCP_RTO_MAX_MS 60000
+
+/* Timestamps older than 24 days are not used to reject segments (RFC 7323) */
+#define TCP_PAWS_IDLE_MS (24U * 24U * 60U * 60U * MSEC_PER_SEC)
 
 /* Define the number of MSS sections the congestion window is initialized at */
 #define TCP_CONGESTION_INITIAL_WIN 1
@@ -70,13 +74,18 @@ static int tcp_tx_window =
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
-static K_MUTEX_DEFINE(tcp_lock);
+/* Only protects the membership of tcp_conns, the connections themselves
+ * are protected by their own lock.
+ */
+static struct k_spinlock tcp_conns_lock;
 
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
-static struct k_work_q tcp_work_q;
-static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
+static struct k_work_q tcp_work_q[CONFIG_NET_TCP_WORKQ_COUNT];
+static K_KERNEL_STACK_ARRAY_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_COUNT,
+				   CONFIG_NET_TCP_WORKQ_STACK_SIZE);
+static atomic_t tcp_work_q_next;
 
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt);
 static bool is_destination_local(struct net_pkt *pkt);
@@ -420,11 +429,22 @@ out:
 
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = (uint32_t)tcp_rto;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
 	uint32_t gain;
 	uint8_t gain8;
-	uint32_t rto;
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+	/* RFC 6298: RTO = SRTT + 4 * RTTVAR, but never below tcp_rto */
+	if (conn->srtt != 0U) {
+		rto = MAX((conn->srtt >> 3) + conn->rttvar, rto);
+	}
+#endif
+
+#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	/* Compute a randomized rto 1 and 1.5 times the base rto */
 
 	/* Getting random is computational expensive, so only use 8 bits */
 	sys_rand_get(&gain8, sizeof(uint8_t));
@@ -432,14 +452,43 @@ static void tcp_derive_rto(struct tcp *conn)
 	gain = (uint32_t)gain8;
 	gain += 1 << 9;
 
-	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+#endif
+
+	conn->rto = (uint16_t)MIN(rto, TCP_RTO_MAX_MS);
 #else
 	ARG_UNUSED(conn);
 #endif
 }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+/* Feed a round trip time sample into SRTT and RTTVAR, as in RFC 6298 */
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	rtt = MAX(rtt, 1U);
+
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt += delta;
+		if (delta < 0) {
+			delta = -delta;
+		}
+		delta -= (int32_t)(conn->rttvar >> 2);
+		conn->rttvar += delta;
+	}
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2);
+
+	tcp_derive_rto(conn);
+}
+#endif
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
 /* Implementation according to RFC6582 */
@@ -480,17 +529,17 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 /* For every duplicate ack increment the cwnd by mss */
 static void tcp_new_reno_dup_ack(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	uint32_t new_win = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
 
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
 		if (conn->ca.cwnd < conn->ca.ssthresh) {
@@ -499,7 +548,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -513,30 +562,171 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+TCP_CA_DEFINE(reno,
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT "cubic"
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CA_DEFAULT "bbr"
+#else
+#define TCP_CA_DEFAULT "reno"
+#endif
+
+static const struct tcp_ca_ops *tcp_ca_default;
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strlen(ops->name) == len &&
+		    strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL || len == 0) {
+		return -EINVAL;
+	}
+
+	/* Accept the name with or without its terminating NUL */
+	ops = tcp_ca_find(value, strnlen(value, len));
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops == conn->ca.ops) {
+		return 0;
+	}
+
+	conn->ca.ops = ops;
+
+	/* Otherwise the algorithm is set up once the connection is established */
+	if (conn->state == TCP_ESTABLISHED || conn->state == TCP_CLOSE_WAIT) {
+		tcp_ca_init(conn);
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(name_len, *len);
+	memcpy(value, conn->ca.ops->name, name_len);
+	*len = name_len;
+
+	return 0;
 }
+
+#if defined(CONFIG_NET_TCP_PACING)
+static void tcp_pacing_timeout(struct k_work *work);
+
+static void tcp_pacing_init(struct tcp *conn)
+{
+	conn->pacing_stamp = k_uptime_ticks();
+	conn->pacing_credit = 0U;
+	k_work_init_delayable(&conn->pacing_timer, tcp_pacing_timeout);
+}
+
+/* Token bucket filled at the rate requested by the congestion control
+ * algorithm. Returns true if a segment may be sent now, otherwise the
+ * pacing timer will resume the transmission once enough credit is there.
+ */
+static bool tcp_pacing_allow(struct tcp *conn, uint32_t len)
+{
+	uint32_t rate;
+	uint64_t credit;
+	uint64_t max_credit;
+	int64_t now;
+	uint64_t wait_us;
+
+	if (conn->ca.ops->pacing_rate == NULL) {
+		return true;
+	}
+
+	rate = conn->ca.ops->pacing_rate(conn);
+	if (rate == 0U) {
+		return true;
+	}
+
+	now = k_uptime_ticks();
+	credit = conn->pacing_credit +
+		 k_ticks_to_us_floor64(now - conn->pacing_stamp) * rate /
+		 USEC_PER_SEC;
+
+	/* Allow bursts of up to two ticks, the timer cannot do better */
+	max_credit = MAX(2U * conn_mss(conn),
+			 k_ticks_to_us_ceil64(2) * rate / USEC_PER_SEC);
+	conn->pacing_credit = MIN(credit, max_credit);
+	conn->pacing_stamp = now;
+
+	if (conn->pacing_credit >= len) {
+		conn->pacing_credit -= len;
+		return true;
+	}
+
+	if (!k_work_delayable_is_pending(&conn->pacing_timer)) {
+		wait_us = DIV_ROUND_UP((uint64_t)(len - conn->pacing_credit) *
+				       USEC_PER_SEC, rate);
+		k_work_reschedule_for_queue(conn->work_q, &conn->pacing_timer,
+					    K_USEC(wait_us));
+	}
+
+	return false;
+}
+
+static void tcp_pacing_stop(struct tcp *conn)
+{
+	(void)k_work_cancel_delayable(&conn->pacing_timer);
+}
+#else
+#define tcp_pacing_init(...)
+#define tcp_pacing_allow(...) true
+#define tcp_pacing_stop(...)
+#endif /* CONFIG_NET_TCP_PACING */
+
 #else
 
 static void tcp_ca_init(struct tcp *conn) { }
@@ -549,6 +739,12 @@ static void tcp_ca_dup_ack(struct tcp *conn) { }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len) { }
 
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+#define tcp_pacing_init(...)
+#define tcp_pacing_allow(...) true
+#define tcp_pacing_stop(...)
+
 #endif
 
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
@@ -581,7 +777,7 @@ static void keep_alive_timer_restart(struct tcp *conn)
 	}
 
 	conn->keep_cur = 0;
-	k_work_reschedule_for_queue(&tcp_work_q, &conn->keepalive_timer,
+	k_work_reschedule_for_queue(conn->work_q, &conn->keepalive_timer,
 				    K_SECONDS(conn->keep_idle));
 }
 
@@ -754,6 +950,7 @@ static void tcp_send_queue_flush(struct tcp *conn)
 static void tcp_conn_release(struct k_work *work)
 {
 	struct tcp *conn = CONTAINER_OF(work, struct tcp, conn_release);
+	k_spinlock_key_t key;
 	struct net_pkt *pkt;
 
 #if defined(CONFIG_NET_TEST)
@@ -805,15 +1002,16 @@ static void tcp_conn_release(struct k_work *work)
 	(void)k_work_cancel_delayable(&conn->send_timer);
 	(void)k_work_cancel_delayable(&conn->recv_queue_timer);
 	keep_alive_timer_stop(conn);
+	tcp_pacing_stop(conn);
 
 	k_mutex_unlock(&conn->lock);
 
 	net_context_unref(conn->context);
 	conn->context = NULL;
 
-	k_mutex_lock(&tcp_lock, K_FOREVER);
+	key = k_spin_lock(&tcp_conns_lock);
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
-	k_mutex_unlock(&tcp_lock);
+	k_spin_unlock(&tcp_conns_lock, key);
 
 	k_mem_slab_free(&tcp_conns_slab, (void *)conn);
 }
@@ -847,7 +1045,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	 * that all pending TCP works are cancelled properly, when the context
 	 * is released.
 	 */
-	k_work_submit_to_queue(&tcp_work_q, &conn->conn_release);
+	k_work_submit_to_queue(conn->work_q, &conn->conn_release);
 
 	return ref_count;
 }
@@ -946,10 +1144,10 @@ static bool tcp_send_process_no_lock(struct tcp *conn)
 	}
 
 	if (conn->in_retransmission) {
-		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_timer,
+		k_work_reschedule_for_queue(conn->work_q, &conn->send_timer,
 					    K_MSEC(TCP_RTO_MS));
 	} else if (local && !sys_slist_is_empty(&conn->send_queue)) {
-		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_timer,
+		k_work_reschedule_for_queue(conn->work_q, &conn->send_timer,
 					    K_NO_WAIT);
 	}
 
@@ -995,7 +1193,7 @@ static void tcp_send_timer_cancel(struct tcp *conn)
 		conn->in_retransmission = false;
 	} else {
 		conn->send_retries = tcp_retries;
-		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_timer,
+		k_work_reschedule_for_queue(conn->work_q, &conn->send_timer,
 					    K_MSEC(TCP_RTO_MS));
 	}
 }
@@ -1096,9 +1294,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -1143,9 +1338,54 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr =
+				ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->tsopt_found = true;
+			break;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_count =
+				MIN((opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE,
+				    NET_TCP_MAX_SACK_BLOCKS);
+
+			for (int i = 0; i < recv_options->sack_count; i++) {
+				uint8_t *block = options + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start =
+					ntohl(UNALIGNED_GET((uint32_t *)block));
+				recv_options->sack[i].end =
+					ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1336,8 +1576,190 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+static uint8_t tcp_rcv_wscale(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	return conn->rcv_wscale;
+#else
+	ARG_UNUSED(conn);
+
+	return 0U;
+#endif
+}
+
+static uint8_t tcp_snd_wscale(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	return conn->snd_wscale;
+#else
+	ARG_UNUSED(conn);
+
+	return 0U;
+#endif
+}
+
+/* Decide which options to offer in our SYN or SYN-ACK */
+static void tcp_options_offer(struct tcp *conn)
+{
+	conn->wscale_ok = IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE);
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS);
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK);
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	/* Use the smallest shift that lets us advertise the whole window */
+	conn->snd_wscale = 0U;
+	conn->rcv_wscale = 0U;
+
+	while (conn->rcv_wscale < NET_TCP_MAX_WINDOW_SCALE &&
+	       (conn->recv_win_max >> conn->rcv_wscale) > UINT16_MAX) {
+		conn->rcv_wscale++;
+	}
+#endif
+}
+
+/* Keep the offered options that the peer has sent in its SYN or SYN-ACK */
+static void tcp_options_agree(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	conn->wscale_ok = conn->wscale_ok && opts->wnd_found;
+	conn->ts_ok = conn->ts_ok && opts->tsopt_found;
+	conn->sack_ok = conn->sack_ok && opts->sack_perm_found;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->wscale_ok) {
+		conn->snd_wscale = opts->window;
+	} else {
+		conn->rcv_wscale = 0U;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok) {
+		conn->ts_recent = opts->tsval;
+		conn->ts_recent_stamp = k_uptime_get_32();
+	}
+#endif
+
+	NET_DBG("conn: %p wscale %d/%d ts %d sack %d", conn,
+		conn->wscale_ok ? tcp_snd_wscale(conn) : -1,
+		conn->wscale_ok ? tcp_rcv_wscale(conn) : -1,
+		conn->ts_ok, conn->sack_ok);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Report the out-of-order data held in the receive queue. The queue holds a
+ * single contiguous run of data, so there is at most one block to send.
+ */
+static size_t tcp_sack_option_add(struct tcp *conn, uint8_t *buf)
+{
+	uint32_t start;
+
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	start = tcp_get_seq(conn->queue_recv_data->buffer);
+
+	buf[0] = NET_TCP_NOP_OPT;
+	buf[1] = NET_TCP_NOP_OPT;
+	buf[2] = NET_TCP_SACK_OPT;
+	buf[3] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+	UNALIGNED_PUT(htonl(start), (uint32_t *)(buf + 4));
+	UNALIGNED_PUT(htonl(start + net_pkt_get_len(conn->queue_recv_data)),
+		      (uint32_t *)(buf + 8));
+
+	return 4 + NET_TCP_SACK_BLOCK_SIZE;
+}
+#endif
+
+/* The whole TCP option space. Each option is padded to 32 bits, and an
+ * option which does not fit in what is left of it is not sent.
+ */
+#define TCP_OPTIONS_MAX_LEN 40
+
+static inline bool tcp_option_fits(size_t len, size_t opt_len)
+{
+	if (len + opt_len > TCP_OPTIONS_MAX_LEN) {
+		NET_DBG("No room for a %zu byte option after %zu bytes",
+			opt_len, len);
+		return false;
+	}
+
+	return true;
+}
+
+/* Write the options to send with a segment, return their length */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	size_t len = 0;
+
+	if (flags & RST) {
+		return 0;
+	}
+
+	if (conn->send_options.mss_found &&
+	    tcp_option_fits(len, NET_TCP_MSS_SIZE)) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)buf);
+		len += NET_TCP_MSS_SIZE;
+	}
+
+	if ((flags & SYN) && conn->wscale_ok && tcp_option_fits(len, 4)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_OPT;
+		buf[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+		buf[len++] = tcp_rcv_wscale(conn);
+	}
+
+	if ((flags & SYN) && conn->sack_ok && tcp_option_fits(len, 4)) {
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_OPT;
+		buf[len++] = NET_TCP_SACK_PERM_SIZE;
+	}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	if (conn->ts_ok && tcp_option_fits(len, 2 + NET_TCP_TIMESTAMP_SIZE)) {
+		uint32_t tsecr = (flags & ACK) ? conn->ts_recent : 0U;
+
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_NOP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_OPT;
+		buf[len++] = NET_TCP_TIMESTAMP_SIZE;
+		UNALIGNED_PUT(htonl(k_uptime_get_32()), (uint32_t *)(buf + len));
+		UNALIGNED_PUT(htonl(tsecr), (uint32_t *)(buf + len + 4));
+		len += 8;
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (!(flags & SYN) && (flags & ACK) && conn->sack_ok &&
+	    tcp_option_fits(len, 4 + NET_TCP_SACK_BLOCK_SIZE)) {
+		len += tcp_sack_option_add(conn, buf + len);
+	}
+#endif
+
+	return len;
+}
+
+/* The window of a SYN segment is never scaled (RFC 7323, 2.2) */
+static uint16_t tcp_adv_window(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+	if (!(flags & SYN)) {
+		win >>= tcp_rcv_wscale(conn);
+	}
+
+	return MIN(win, UINT16_MAX);
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
@@ -1351,14 +1773,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + opts_len / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_window(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1416,25 +1834,6 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
-{
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
-
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
-	}
-
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
-
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
-
-	return net_pkt_set_data(pkt, &mss_opt_access);
-}
-
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1539,14 +1938,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[TCP_OPTIONS_MAX_LEN];
+	size_t opts_len = tcp_options_build(conn, flags, opts);
+	size_t alloc_len = sizeof(struct tcphdr) + opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1565,14 +1962,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1601,7 +1998,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		 * thread to finish with any state-machine changes before
 		 * sending the packet, or it might lead to state inconsistencies
 		 */
-		k_work_schedule_for_queue(&tcp_work_q,
+		k_work_schedule_for_queue(conn->work_q,
 					  &conn->send_timer, K_NO_WAIT);
 	} else if (tcp_send_process_no_lock(conn)) {
 		tcp_conn_close(conn, -ETIMEDOUT);
@@ -1734,42 +2131,29 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of send_data, starting offset bytes after conn->seq */
+static int tcp_send_segment(struct tcp *conn, int offset, int len)
 {
-	int ret = 0;
-	int len;
+	bool resend = (conn->data_mode == TCP_DATA_MODE_RESEND) ||
+		      (offset < conn->unacked_len);
 	struct net_pkt *pkt;
-
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
-	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
-	}
+	int ret;
 
 	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -1784,12 +2168,227 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack_block_cnt = 0U;
+	conn->in_recovery = false;
+}
+
+static void tcp_sack_block_del(struct tcp *conn, int i)
+{
+	memmove(&conn->sack_blocks[i], &conn->sack_blocks[i + 1],
+		(conn->sack_block_cnt - i - 1) * sizeof(conn->sack_blocks[0]));
+	conn->sack_block_cnt--;
+}
+
+/* Merge a SACKed range into the scoreboard, which is kept sorted and
+ * without overlaps. When it is full the highest range is forgotten, as the
+ * holes below the lowest ranges are the ones to retransmit first.
+ */
+static void tcp_sack_block_add(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *blocks = conn->sack_blocks;
+	int i;
+
+	for (i = 0; i < conn->sack_block_cnt; ) {
+		if (net_tcp_seq_cmp(end, blocks[i].start) < 0 ||
+		    net_tcp_seq_cmp(start, blocks[i].end) > 0) {
+			i++;
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(blocks[i].start, start) < 0) {
+			start = blocks[i].start;
+		}
+
+		if (net_tcp_seq_cmp(blocks[i].end, end) > 0) {
+			end = blocks[i].end;
+		}
+
+		tcp_sack_block_del(conn, i);
+	}
+
+	for (i = 0; i < conn->sack_block_cnt; i++) {
+		if (net_tcp_seq_cmp(start, blocks[i].start) < 0) {
+			break;
+		}
+	}
+
+	if (conn->sack_block_cnt == ARRAY_SIZE(conn->sack_blocks)) {
+		if (i == conn->sack_block_cnt) {
+			return;
+		}
+
+		conn->sack_block_cnt--;
+	}
+
+	memmove(&blocks[i + 1], &blocks[i],
+		(conn->sack_block_cnt - i) * sizeof(blocks[0]));
+	blocks[i].start = start;
+	blocks[i].end = end;
+	conn->sack_block_cnt++;
+}
+
+/* Record the SACK blocks of an incoming segment */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < opts->sack_count; i++) {
+		struct tcp_sack_block *block = &opts->sack[i];
+
+		/* Ignore blocks which are not about data in flight */
+		if (net_tcp_seq_cmp(block->start, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(block->end, block->start) <= 0 ||
+		    net_tcp_seq_cmp(block->end, snd_max) > 0) {
+			continue;
+		}
+
+		tcp_sack_block_add(conn, block->start, block->end);
+	}
+}
+
+/* Forget the ranges covered by a cumulative ACK */
+static void tcp_sack_trim(struct tcp *conn)
+{
+	while (conn->sack_block_cnt > 0 &&
+	       net_tcp_seq_cmp(conn->sack_blocks[0].start, conn->seq) < 0) {
+		if (net_tcp_seq_cmp(conn->sack_blocks[0].end, conn->seq) <= 0) {
+			tcp_sack_block_del(conn, 0);
+		} else {
+			conn->sack_blocks[0].start = conn->seq;
+		}
+	}
+}
+
+/* Retransmit up to an MSS from the first hole in the scoreboard that has
+ * not been retransmitted yet during this recovery. Only holes below a
+ * SACKed range are considered lost.
+ */
+static int tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t next = conn->sack_rexmit_next;
+	int len;
+	int ret;
+
+	if (net_tcp_seq_cmp(next, conn->seq) < 0) {
+		next = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sack_block_cnt; i++) {
+		struct tcp_sack_block *block = &conn->sack_blocks[i];
+
+		if (net_tcp_seq_cmp(next, block->start) < 0) {
+			len = MIN(block->start - next, conn_mss(conn));
+
+			NET_DBG("conn: %p retransmit hole seq %u len %d",
+				conn, next, len);
+
+			ret = tcp_send_segment(conn, next - conn->seq, len);
+			if (ret == 0) {
+				conn->sack_rexmit_next = next + len;
+			}
+
+			return ret;
+		}
+
+		if (net_tcp_seq_cmp(next, block->end) < 0) {
+			next = block->end;
+		}
+	}
+
+	return -ENODATA;
+}
+
+/* Start a SACK based recovery, return false if the peer has not SACKed
+ * anything and a plain fast retransmit should be done instead.
+ */
+static bool tcp_sack_recovery_start(struct tcp *conn)
+{
+	if (!conn->sack_ok || conn->sack_block_cnt == 0) {
+		return false;
+	}
+
+	conn->in_recovery = true;
+	conn->recovery_point = conn->seq + conn->unacked_len;
+	conn->sack_rexmit_next = conn->seq;
+
+	(void)tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+static bool tcp_sack_in_recovery(struct tcp *conn)
+{
+	return conn->in_recovery;
+}
+
+/* A cumulative ACK either ends the recovery, or lets the next hole out */
+static void tcp_sack_acked(struct tcp *conn)
+{
+	tcp_sack_trim(conn);
+
+	if (!conn->in_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->recovery_point) >= 0) {
+		conn->in_recovery = false;
+		return;
+	}
+
+	(void)tcp_sack_retransmit(conn);
+}
+#else
+static inline void tcp_sack_reset(struct tcp *conn) { }
+
+static inline void tcp_sack_update(struct tcp *conn) { }
+
+static inline bool tcp_sack_recovery_start(struct tcp *conn) { return false; }
+
+static inline bool tcp_sack_in_recovery(struct tcp *conn) { return false; }
+
+static inline int tcp_sack_retransmit(struct tcp *conn) { return -ENODATA; }
+
+static inline void tcp_sack_acked(struct tcp *conn) { }
+#endif
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1815,6 +2414,11 @@ static int tcp_send_queued_data(struct tcp *conn)
 			}
 		}
 
+		if (!tcp_pacing_allow(conn, MIN(tcp_unsent_len(conn),
+						conn_mss(conn)))) {
+			break;
+		}
+
 		ret = tcp_send_data(conn);
 		if (ret < 0) {
 			break;
@@ -1831,13 +2435,29 @@ static int tcp_send_queued_data(struct tcp *conn)
 
 	if (subscribe) {
 		conn->send_data_retries = 0;
-		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+		k_work_reschedule_for_queue(conn->work_q, &conn->send_data_timer,
 					    K_MSEC(TCP_RTO_MS));
 	}
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_PACING)
+static void tcp_pacing_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, pacing_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->state != TCP_UNUSED) {
+		(void)tcp_send_queued_data(conn);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1884,6 +2504,9 @@ static void tcp_resend_data(struct k_work *work)
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
+	/* The peer may have discarded the data it SACKed (RFC 2018, 8) */
+	tcp_sack_reset(conn);
+
 	ret = tcp_send_data(conn);
 	conn->send_data_retries++;
 	if (ret == 0) {
@@ -1891,7 +2514,7 @@ static void tcp_resend_data(struct k_work *work)
 			NET_DBG("TCP connection in %s close, "
 				"not disposing yet (waiting %dms)",
 				"active", tcp_max_timeout_ms);
-			k_work_reschedule_for_queue(&tcp_work_q,
+			k_work_reschedule_for_queue(conn->work_q,
 						    &conn->fin_timer,
 						    FIN_TIMEOUT);
 
@@ -1924,7 +2547,7 @@ static void tcp_resend_data(struct k_work *work)
 		}
 	}
 
-	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+	k_work_reschedule_for_queue(conn->work_q, &conn->send_data_timer,
 				    K_MSEC(exp_tcp_rto));
 
  out:
@@ -1995,7 +2618,7 @@ static void tcp_setup_last_ack_timer(struct tcp *conn)
 	NET_DBG("TCP connection in %s close, "
 		"not disposing yet (waiting %dms)",
 		"passive", LAST_ACK_TIMEOUT_MS);
-	k_work_reschedule_for_queue(&tcp_work_q,
+	k_work_reschedule_for_queue(conn->work_q,
 				    &conn->fin_timer,
 				    LAST_ACK_TIMEOUT);
 }
@@ -2030,7 +2653,7 @@ static void tcp_send_keepalive_probe(struct k_work *work)
 	}
 
 	NET_DBG("conn: %p keepalive probe", conn);
-	k_work_reschedule_for_queue(&tcp_work_q, &conn->keepalive_timer,
+	k_work_reschedule_for_queue(conn->work_q, &conn->keepalive_timer,
 				    K_SECONDS(conn->keep_intvl));
 
 
@@ -2063,7 +2686,7 @@ static void tcp_send_zwp(struct k_work *work)
 		}
 
 		(void)k_work_reschedule_for_queue(
-			&tcp_work_q, &conn->persist_timer, K_MSEC(timeout));
+			conn->work_q, &conn->persist_timer, K_MSEC(timeout));
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -2088,9 +2711,25 @@ static void tcp_conn_ref(struct tcp *conn)
 	NET_DBG("conn: %p, ref_count: %d", conn, ref_count);
 }
 
+/* Take a reference unless the connection is already being released */
+static bool tcp_conn_get(struct tcp *conn)
+{
+	atomic_val_t ref_count;
+
+	do {
+		ref_count = atomic_get(&conn->ref_count);
+		if (ref_count == 0) {
+			return false;
+		}
+	} while (!atomic_cas(&conn->ref_count, ref_count, ref_count + 1));
+
+	return true;
+}
+
 static struct tcp *tcp_conn_alloc(void)
 {
 	struct tcp *conn = NULL;
+	k_spinlock_key_t key;
 	int ret;
 
 	ret = k_mem_slab_alloc(&tcp_conns_slab, (void **)&conn, K_NO_WAIT);
@@ -2137,7 +2776,8 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = UINT32_MAX;
+	conn->ca.ops = tcp_ca_default;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2147,6 +2787,9 @@ static struct tcp *tcp_conn_alloc(void)
 
 	sys_slist_init(&conn->send_queue);
 
+	conn->work_q = &tcp_work_q[(uint32_t)atomic_inc(&tcp_work_q_next) %
+				   ARRAY_SIZE(tcp_work_q)];
+
 	k_work_init_delayable(&conn->send_timer, tcp_send_process);
 	k_work_init_delayable(&conn->timewait_timer, tcp_timewait_timeout);
 	k_work_init_delayable(&conn->fin_timer, tcp_fin_timeout);
@@ -2156,12 +2799,13 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
 	k_work_init(&conn->conn_release, tcp_conn_release);
 	keep_alive_timer_init(conn);
+	tcp_pacing_init(conn);
 
 	tcp_conn_ref(conn);
 
-	k_mutex_lock(&tcp_lock, K_FOREVER);
+	key = k_spin_lock(&tcp_conns_lock);
 	sys_slist_append(&tcp_conns, &conn->next);
-	k_mutex_unlock(&tcp_lock);
+	k_spin_unlock(&tcp_conns_lock, key);
 out:
 	NET_DBG("conn: %p", conn);
 
@@ -2195,42 +2839,42 @@ int net_tcp_get(struct net_context *context)
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
-{
-	union tcp_endpoint ep_tmp;
-
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
-	}
-
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
-}
-
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
+static bool tcp_conn_cmp(struct tcp *conn, union tcp_endpoint *src,
+			 union tcp_endpoint *dst)
 {
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
+	return !memcmp(&conn->src, dst, tcp_endpoint_len(conn->src.sa.sa_family)) &&
+		!memcmp(&conn->dst, src, tcp_endpoint_len(conn->dst.sa.sa_family));
 }
 
+/* Returns the connection of the packet with a reference held, which the
+ * caller must drop with tcp_conn_unref().
+ */
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	bool found = false;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	struct tcp *found = NULL;
 	struct tcp *conn;
-	struct tcp *tmp;
+	k_spinlock_key_t key;
 
-	k_mutex_lock(&tcp_lock, K_FOREVER);
+	/* Parse the packet once, outside of the lock */
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_SRC) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_DST) < 0) {
+		return NULL;
+	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
+	key = k_spin_lock(&tcp_conns_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conns, conn, next) {
+		if (tcp_conn_cmp(conn, &src, &dst) && tcp_conn_get(conn)) {
+			found = conn;
 			break;
 		}
 	}
 
-	k_mutex_unlock(&tcp_lock);
+	k_spin_unlock(&tcp_conns_lock, key);
 
-	return found ? conn : NULL;
+	return found;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -2250,7 +2894,9 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 
 	conn = tcp_conn_search(pkt);
 	if (conn) {
-		goto in;
+		verdict = tcp_in(conn, pkt);
+		(void)tcp_conn_unref(conn);
+		goto out;
 	}
 
 	th = th_get(pkt);
@@ -2272,7 +2918,7 @@ in:
 	} else {
 		net_tcp_reply_rst(pkt);
 	}
-
+out:
 	return verdict;
 }
 
@@ -2541,7 +3187,7 @@ static enum tcp_state tcp_enter_time_wait(struct tcp *conn)
 	/* Entering TIME-WAIT, so cancel the timer and start the TIME-WAIT timer */
 	k_work_cancel_delayable(&conn->fin_timer);
 	k_work_reschedule_for_queue(
-		&tcp_work_q, &conn->timewait_timer,
+		conn->work_q, &conn->timewait_timer,
 		K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 	return TCP_TIME_WAIT;
 }
@@ -2702,7 +3348,7 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 
 		if (!k_work_delayable_is_pending(&conn->recv_queue_timer)) {
 			k_work_reschedule_for_queue(
-				&tcp_work_q, &conn->recv_queue_timer,
+				conn->work_q, &conn->recv_queue_timer,
 				K_MSEC(CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT));
 		}
 	}
@@ -2726,7 +3372,7 @@ static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 	 * as described in RFC 813.
 	 */
 	if (tcp_short_window(conn) || !psh) {
-		k_work_schedule_for_queue(&tcp_work_q, &conn->ack_timer,
+		k_work_schedule_for_queue(conn->work_q, &conn->ack_timer,
 					  ACK_DELAY);
 	} else {
 		k_work_cancel_delayable(&conn->ack_timer);
@@ -2772,7 +3418,7 @@ static void tcp_check_sock_options(struct tcp *conn)
 					     &rcvbuf_opt, NULL);
 	}
 
-	if (sndbuf_opt > 0 && sndbuf_opt != conn->send_win_max) {
+	if (sndbuf_opt > 0 && (uint32_t)sndbuf_opt != conn->send_win_max) {
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
 		conn->send_win_max = sndbuf_opt;
@@ -2783,12 +3429,12 @@ static void tcp_check_sock_options(struct tcp *conn)
 		k_mutex_unlock(&conn->lock);
 	}
 
-	if (rcvbuf_opt > 0 && rcvbuf_opt != conn->recv_win_max) {
+	if (rcvbuf_opt > 0 && (uint32_t)rcvbuf_opt != conn->recv_win_max) {
 		int diff;
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
-		diff = rcvbuf_opt - conn->recv_win_max;
+		diff = rcvbuf_opt - (int)conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
 
@@ -2796,6 +3442,41 @@ static void tcp_check_sock_options(struct tcp *conn)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* PAWS (RFC 7323, 5): reject a segment whose timestamp is older than the
+ * last one accepted, unless the connection has been idle for so long that
+ * the timestamp clock may have wrapped.
+ */
+static bool tcp_paws_reject(struct tcp *conn, struct tcphdr *th)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t now = k_uptime_get_32();
+
+	if (!conn->ts_ok || !opts->tsopt_found ||
+	    conn->state == TCP_LISTEN || conn->state == TCP_SYN_SENT) {
+		return false;
+	}
+
+	if ((int32_t)(opts->tsval - conn->ts_recent) < 0 &&
+	    (now - conn->ts_recent_stamp) < TCP_PAWS_IDLE_MS) {
+		return true;
+	}
+
+	/* Echo the timestamp of the oldest segment we have not acked yet */
+	if (net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+		conn->ts_recent = opts->tsval;
+		conn->ts_recent_stamp = now;
+	}
+
+	return false;
+}
+#else
+static inline bool tcp_paws_reject(struct tcp *conn, struct tcphdr *th)
+{
+	return false;
+}
+#endif
+
 /* TCP state machine, everything happens here */
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -2867,6 +3548,16 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (th) {
+		/* Apart from the MSS, options only apply to the segment
+		 * carrying them.
+		 */
+		conn->recv_options.wnd_found = false;
+		conn->recv_options.sack_perm_found = false;
+		conn->recv_options.tsopt_found = false;
+		conn->recv_options.sack_count = 0U;
+	}
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2891,8 +3582,21 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (th && tcp_paws_reject(conn, th)) {
+		NET_DBG("conn: %p, DROP: old timestamp", conn);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		k_mutex_unlock(&conn->lock);
+		return NET_DROP;
+	}
+
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+		/* The window of a SYN segment is never scaled */
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= tcp_snd_wscale(conn);
+		}
+
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2904,7 +3608,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			if (!k_work_delayable_is_pending(&conn->persist_timer)) {
 				conn->zwp_retries = 0;
 				(void)k_work_reschedule_for_queue(
-					&tcp_work_q, &conn->persist_timer,
+					conn->work_q, &conn->persist_timer,
 					K_MSEC(TCP_RTO_MS));
 			}
 		} else {
@@ -2926,6 +3630,8 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_options_offer(conn);
+			tcp_options_agree(conn);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
@@ -2934,12 +3640,13 @@ next_state:
 
 			/* Close the connection if we do not receive ACK on time.
 			 */
-			k_work_reschedule_for_queue(&tcp_work_q,
+			k_work_reschedule_for_queue(conn->work_q,
 						    &conn->establish_timer,
 						    ACK_TIMEOUT);
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+			tcp_options_offer(conn);
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
@@ -2962,6 +3669,9 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca.ops = conn->accepted_conn->ca.ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3051,6 +3761,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_agree(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3134,6 +3845,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3151,18 +3866,27 @@ next_state:
 				conn->dup_ack_cnt = 0;
 			}
 
-			/* Only do fast retransmit when not already in a resend state */
-			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
-			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+			if (tcp_sack_in_recovery(conn)) {
+				/* Each further duplicate ACK lets one more hole out */
+				if (len == 0) {
+					(void)tcp_sack_retransmit(conn);
+				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				   (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				/* Only do fast retransmit when not already in a resend state.
+				 * With SACK only the holes are resent, otherwise apply a
+				 * fast retransmit of the first unacknowledged segment.
+				 */
+				if (!tcp_sack_recovery_start(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
@@ -3214,6 +3938,15 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#ifdef CONFIG_NET_TCP_TIMESTAMPS
+			if (conn->ts_ok && conn->recv_options.tsopt_found &&
+			    conn->recv_options.tsecr != 0U) {
+				tcp_rtt_update(conn, k_uptime_get_32() -
+						     conn->recv_options.tsecr);
+			}
+#endif
+			tcp_sack_acked(conn);
+
 			/* Receipt of an acknowledgment that covers a sequence number
 			 * not previously acknowledged indicates that the connection
 			 * makes a "forward progress".
@@ -3229,7 +3962,7 @@ next_state:
 			}
 			conn->data_mode = TCP_DATA_MODE_SEND;
 			if (conn->send_data_total > 0) {
-				k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+				k_work_reschedule_for_queue(conn->work_q, &conn->send_data_timer,
 					    K_MSEC(TCP_RTO_MS));
 			}
 
@@ -3238,7 +3971,7 @@ next_state:
 				tcp_send_timer_cancel(conn);
 				next = TCP_FIN_WAIT_1;
 
-				k_work_reschedule_for_queue(&tcp_work_q,
+				k_work_reschedule_for_queue(conn->work_q,
 							    &conn->fin_timer,
 							    FIN_TIMEOUT);
 
@@ -3647,7 +4380,7 @@ int net_tcp_put(struct net_context *context)
 
 			/* How long to wait until all the data has been sent?
 			 */
-			k_work_reschedule_for_queue(&tcp_work_q,
+			k_work_reschedule_for_queue(conn->work_q,
 						    &conn->send_data_timer,
 						    K_MSEC(TCP_RTO_MS));
 		} else {
@@ -3656,7 +4389,7 @@ int net_tcp_put(struct net_context *context)
 			NET_DBG("TCP connection in %s close, "
 				"not disposing yet (waiting %dms)",
 				"active", tcp_max_timeout_ms);
-			k_work_reschedule_for_queue(&tcp_work_q,
+			k_work_reschedule_for_queue(conn->work_q,
 						    &conn->fin_timer,
 						    FIN_TIMEOUT);
 
@@ -4135,7 +4868,8 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 	enum net_verdict verdict = NET_DROP;
 
 	if (th) {
-		struct tcp *conn = tcp_conn_search(pkt);
+		struct tcp *found = tcp_conn_search(pkt);
+		struct tcp *conn = found;
 
 		if (conn == NULL && SYN == th_flags(th)) {
 			struct net_context *context =
@@ -4155,6 +4889,10 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn->iface = pkt->iface;
 			verdict = tcp_in(conn, pkt);
 		}
+
+		if (found) {
+			(void)tcp_conn_unref(found);
+		}
 	}
 
 	return verdict;
@@ -4209,6 +4947,29 @@ static void tcp_to_json(struct tcp *conn, void *data, size_t *data_len)
 	tp_encode(&tp, data, data_len);
 }
 
+/* Returns the first connection with a reference held, which the caller
+ * must drop with tcp_conn_unref().
+ */
+static struct tcp *tp_conn_first(void)
+{
+	struct tcp *found = NULL;
+	struct tcp *conn;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&tcp_conns_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conns, conn, next) {
+		if (tcp_conn_get(conn)) {
+			found = conn;
+			break;
+		}
+	}
+
+	k_spin_unlock(&tcp_conns_lock, key);
+
+	return found;
+}
+
 enum net_verdict tp_input(struct net_conn *net_conn,
 			  struct net_pkt *pkt,
 			  union net_ip_header *ip_hdr,
@@ -4217,7 +4978,8 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 {
 	struct net_udp_hdr *uh = net_udp_get_hdr(pkt, NULL);
 	size_t data_len = ntohs(uh->len) - sizeof(*uh);
-	struct tcp *conn = tcp_conn_search(pkt);
+	struct tcp *found = tcp_conn_search(pkt);
+	struct tcp *conn = found;
 	size_t json_len = 0;
 	struct tp *tp;
 	struct tp_new *tp_new;
@@ -4280,8 +5042,15 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 			{
 				struct net_context *context;
 
-				conn = (void *)sys_slist_peek_head(&tcp_conns);
+				conn = tp_conn_first();
 				context = conn->context;
+
+				/* Closing drops all the references, ours too */
+				if (found == conn) {
+					(void)tcp_conn_unref(found);
+					found = NULL;
+				}
+
 				while (tcp_conn_close(conn, 0))
 					;
 				tcp_free(context);
@@ -4292,9 +5061,10 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 			tp_seq_stat();
 		}
 		if (is("CLOSE2", tp->op)) {
-			struct tcp *conn =
-				(void *)sys_slist_peek_head(&tcp_conns);
+			struct tcp *conn = tp_conn_first();
+
 			net_tcp_put(conn->context);
+			(void)tcp_conn_unref(conn);
 		}
 		if (is("RECV", tp->op)) {
 #define HEXSTR_SIZE 64
@@ -4310,8 +5080,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 		}
 		if (is("SEND", tp->op)) {
 			ssize_t len = tp_str_to_hex(buf, sizeof(buf), tp->data);
-			struct tcp *conn =
-				(void *)sys_slist_peek_head(&tcp_conns);
+			struct tcp *conn = tp_conn_first();
 
 			tp_output(pkt->family, pkt->iface, buf, 1);
 			responded = true;
@@ -4319,6 +5088,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 			{
 				net_tcp_queue(conn->context, buf, len);
 			}
+			(void)tcp_conn_unref(conn);
 		}
 		break;
 	case TP_CONFIG_REQUEST:
@@ -4331,8 +5101,9 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 		break;
 	case TP_INTROSPECT_REQUEST:
 		json_len = sizeof(buf);
-		conn = (void *)sys_slist_peek_head(&tcp_conns);
+		conn = tp_conn_first();
 		tcp_to_json(conn, buf, &json_len);
+		(void)tcp_conn_unref(conn);
 		break;
 	case TP_DEBUG_STOP:
 	case TP_DEBUG_CONTINUE:
@@ -4349,6 +5120,10 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 		tp_output(pkt->family, pkt->iface, buf, 1);
 	}
 
+	if (found != NULL) {
+		(void)tcp_conn_unref(found);
+	}
+
 	return verdict;
 }
 
@@ -4376,20 +5151,37 @@ static void test_cb_register(sa_family_t family, uint8_t proto, uint16_t remote_
 
 void net_tcp_foreach(net_tcp_cb_t cb, void *user_data)
 {
+	struct tcp *prev = NULL;
 	struct tcp *conn;
-	struct tcp *tmp;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&tcp_conns_lock);
+
+	/* The reference held on the current connection keeps it in the list
+	 * while the lock is released for the callback.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&tcp_conns, conn, next) {
+		if (!tcp_conn_get(conn)) {
+			continue;
+		}
 
-	k_mutex_lock(&tcp_lock, K_FOREVER);
+		k_spin_unlock(&tcp_conns_lock, key);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		if (atomic_get(&conn->ref_count) > 0) {
-			k_mutex_unlock(&tcp_lock);
-			cb(conn, user_data);
-			k_mutex_lock(&tcp_lock, K_FOREVER);
+		if (prev != NULL) {
+			(void)tcp_conn_unref(prev);
 		}
+
+		cb(conn, user_data);
+		prev = conn;
+
+		key = k_spin_lock(&tcp_conns_lock);
 	}
 
-	k_mutex_unlock(&tcp_lock);
+	k_spin_unlock(&tcp_conns_lock, key);
+
+	if (prev != NULL) {
+		(void)tcp_conn_unref(prev);
+	}
 }
 
 uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
@@ -4470,6 +5262,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4507,6 +5302,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4533,6 +5331,34 @@ struct k_sem *net_tcp_conn_sem_get(struct net_context *context)
 	return &conn->connect_sem;
 }
 
+static void tcp_work_q_start(int idx, int prio)
+{
+	char name[sizeof("tcp_work") + 2];
+	struct k_work_queue_config cfg = {
+		.name = name,
+	};
+
+	if (idx == 0) {
+		snprintk(name, sizeof(name), "tcp_work");
+	} else {
+		snprintk(name, sizeof(name), "tcp_work%d", idx);
+	}
+
+#if defined(CONFIG_SCHED_CPU_MASK) && defined(CONFIG_SMP)
+	/* Pin each queue to its own CPU before its thread gets to run */
+	if (CONFIG_NET_TCP_WORKQ_COUNT > 1) {
+		cfg.cpu_mask = BIT(idx % arch_num_cpus());
+	}
+#endif
+
+	k_work_queue_start(&tcp_work_q[idx], work_q_stack[idx],
+			   K_KERNEL_STACK_SIZEOF(work_q_stack[idx]),
+			   prio, &cfg);
+
+	NET_DBG("Workq %d started. Thread ID: %p", idx,
+		k_work_queue_thread_get(&tcp_work_q[idx]));
+}
+
 void net_tcp_init(void)
 {
 	int i;
@@ -4553,11 +5379,13 @@ void net_tcp_init(void)
 #define THREAD_PRIORITY K_PRIO_PREEMPT(CONFIG_NET_TCP_WORKER_PRIO)
 #endif
 
-	/* Use private workqueue in order not to block the system work queue.
+	/* Use private workqueues in order not to block the system work queue.
+	 * The connections are spread over them, so that several connections
+	 * can be processed at the same time on SMP.
 	 */
-	k_work_queue_start(&tcp_work_q, work_q_stack,
-			   K_KERNEL_STACK_SIZEOF(work_q_stack), THREAD_PRIORITY,
-			   NULL);
+	for (i = 0; i < ARRAY_SIZE(tcp_work_q); i++) {
+		tcp_work_q_start(i, THREAD_PRIORITY);
+	}
 
 	/* Compute the largest possible retransmission timeout */
 	tcp_max_timeout_ms = 0;
@@ -4574,6 +5402,9 @@ void net_tcp_init(void)
 		tcp_max_timeout_ms += tcp_max_timeout_ms >> 1;
 	}
 
-	k_thread_name_set(&tcp_work_q.thread, "tcp_work");
-	NET_DBG("Workq started. Thread ID: %p", &tcp_work_q.thread);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	tcp_ca_default = tcp_ca_find(TCP_CA_DEFAULT, strlen(TCP_CA_DEFAULT));
+	NET_ASSERT(tcp_ca_default != NULL, "No %s congestion control",
+		   TCP_CA_DEFAULT);
+#endif
 }
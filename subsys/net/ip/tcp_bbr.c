@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Congestion control based on a model of the path, after BBR
+ * (draft-cardwell-iccrg-bbr-congestion-control). The delivery rate and the
+ * round trip time are sampled once per round trip, as the stack does not
+ * keep per segment transmission times, and the sending rate is enforced by
+ * the pacing of tcp.c.
+ */
+
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "tcp_internal.h"
+
+#define BBR_UNIT 1000U
+
+/* 2 / ln(2), to double the sending rate every round trip */
+#define BBR_HIGH_GAIN 2885U
+#define BBR_DRAIN_GAIN (BBR_UNIT * BBR_UNIT / BBR_HIGH_GAIN)
+#define BBR_CWND_GAIN 2000U
+
+/* Rounds without a 25% bandwidth increase before the pipe is full */
+#define BBR_FULL_BW_ROUNDS 3
+#define BBR_FULL_BW_THRESH 1250U
+
+#define BBR_BW_FILTER_LEN 3
+#define BBR_MIN_RTT_EXPIRY_MS 10000
+#define BBR_PROBE_RTT_MS 200
+#define BBR_MIN_CWND_SEGS 4U
+#define BBR_INITIAL_WIN 4U
+
+enum tcp_bbr_mode {
+	BBR_STARTUP,
+	BBR_DRAIN,
+	BBR_PROBE_BW,
+	BBR_PROBE_RTT,
+};
+
+static const uint16_t bbr_pacing_gain[] = {
+	1250, 750, 1000, 1000, 1000, 1000, 1000, 1000,
+};
+
+struct tcp_bbr {
+	int64_t round_start;       /* start of the current round, us */
+	int64_t min_rtt_stamp;     /* when min_rtt_us was measured, ms */
+	int64_t probe_rtt_done;    /* end of PROBE_RTT, ms */
+	uint32_t bw[BBR_BW_FILTER_LEN]; /* delivery rate of the last rounds */
+	uint32_t min_rtt_us;
+	uint32_t round_end_seq;    /* the round ends when this is acked */
+	uint32_t delivered;        /* bytes acked during the current round */
+	uint32_t full_bw;
+	uint32_t prior_cwnd;       /* cwnd to restore after PROBE_RTT */
+	uint8_t mode;
+	uint8_t cycle_idx;
+	uint8_t bw_idx;
+	uint8_t full_bw_cnt : 2;
+	uint8_t full_bw_reached : 1;
+	uint8_t round_started : 1;
+};
+
+BUILD_ASSERT(sizeof(struct tcp_bbr) <= TCP_CA_PRIV_SIZE);
+
+static void tcp_bbr_log(struct tcp *conn, char *step)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	NET_DBG("conn: %p, ca %s, mode=%u, cwnd=%u, min_rtt=%u us",
+		conn, step, bbr->mode, conn->ca.cwnd, bbr->min_rtt_us);
+}
+
+static uint32_t tcp_bbr_max_bw(struct tcp_bbr *bbr)
+{
+	uint32_t bw = 0U;
+
+	for (int i = 0; i < BBR_BW_FILTER_LEN; i++) {
+		bw = MAX(bw, bbr->bw[i]);
+	}
+
+	return bw;
+}
+
+static uint32_t tcp_bbr_pacing_gain(struct tcp_bbr *bbr)
+{
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		return BBR_HIGH_GAIN;
+	case BBR_DRAIN:
+		return BBR_DRAIN_GAIN;
+	case BBR_PROBE_BW:
+		return bbr_pacing_gain[bbr->cycle_idx];
+	default:
+		return BBR_UNIT;
+	}
+}
+
+/* Bandwidth delay product scaled by gain, in bytes */
+static uint32_t tcp_bbr_bdp(struct tcp *conn, uint32_t gain)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	uint64_t bdp;
+
+	bdp = (uint64_t)tcp_bbr_max_bw(bbr) * bbr->min_rtt_us / USEC_PER_SEC;
+	bdp = bdp * gain / BBR_UNIT;
+
+	return (uint32_t)CLAMP(bdp, BBR_MIN_CWND_SEGS * conn_mss(conn),
+			       NET_TCP_MAX_WIN);
+}
+
+static void tcp_bbr_init(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	memset(bbr, 0, sizeof(*bbr));
+	bbr->mode = BBR_STARTUP;
+	bbr->min_rtt_us = UINT32_MAX;
+	bbr->min_rtt_stamp = k_uptime_get();
+
+	conn->ca.cwnd = conn_mss(conn) * BBR_INITIAL_WIN;
+	conn->ca.ssthresh = NET_TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_bbr_log(conn, "init");
+}
+
+static void tcp_bbr_enter_probe_bw(struct tcp_bbr *bbr)
+{
+	bbr->mode = BBR_PROBE_BW;
+	/* Do not start with the draining phase */
+	bbr->cycle_idx = 2;
+}
+
+static void tcp_bbr_check_full_bw(struct tcp_bbr *bbr)
+{
+	uint32_t bw = tcp_bbr_max_bw(bbr);
+
+	if (bbr->full_bw_reached) {
+		return;
+	}
+
+	if ((uint64_t)bw * BBR_UNIT >= (uint64_t)bbr->full_bw * BBR_FULL_BW_THRESH) {
+		bbr->full_bw = bw;
+		bbr->full_bw_cnt = 0U;
+		return;
+	}
+
+	if (++bbr->full_bw_cnt >= BBR_FULL_BW_ROUNDS) {
+		bbr->full_bw_reached = true;
+	}
+}
+
+/* Called at the end of each round trip */
+static void tcp_bbr_update_mode(struct tcp *conn, int64_t now_ms)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	tcp_bbr_check_full_bw(bbr);
+
+	switch (bbr->mode) {
+	case BBR_STARTUP:
+		if (bbr->full_bw_reached) {
+			bbr->mode = BBR_DRAIN;
+		}
+		break;
+	case BBR_DRAIN:
+		if ((uint32_t)conn->unacked_len <= tcp_bbr_bdp(conn, BBR_UNIT)) {
+			tcp_bbr_enter_probe_bw(bbr);
+		}
+		break;
+	case BBR_PROBE_BW:
+		bbr->cycle_idx = (bbr->cycle_idx + 1) % ARRAY_SIZE(bbr_pacing_gain);
+		break;
+	case BBR_PROBE_RTT:
+		if (now_ms >= bbr->probe_rtt_done) {
+			bbr->min_rtt_stamp = now_ms;
+			conn->ca.cwnd = MAX(conn->ca.cwnd, bbr->prior_cwnd);
+			if (bbr->full_bw_reached) {
+				tcp_bbr_enter_probe_bw(bbr);
+			} else {
+				bbr->mode = BBR_STARTUP;
+			}
+		}
+		return;
+	}
+
+	/* Drain the queue once in a while to measure the real round trip */
+	if (now_ms - bbr->min_rtt_stamp > BBR_MIN_RTT_EXPIRY_MS) {
+		bbr->mode = BBR_PROBE_RTT;
+		bbr->prior_cwnd = conn->ca.cwnd;
+		bbr->probe_rtt_done = now_ms + BBR_PROBE_RTT_MS;
+	}
+}
+
+static void tcp_bbr_round_end(struct tcp *conn, int64_t now_us)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	int64_t now_ms = now_us / USEC_PER_MSEC;
+	uint64_t elapsed = now_us - bbr->round_start;
+	uint32_t rtt_us;
+
+	if (elapsed == 0U) {
+		return;
+	}
+
+	rtt_us = (uint32_t)MIN(elapsed, UINT32_MAX);
+	if (rtt_us <= bbr->min_rtt_us) {
+		bbr->min_rtt_us = rtt_us;
+		bbr->min_rtt_stamp = now_ms;
+	}
+
+	bbr->bw_idx = (bbr->bw_idx + 1) % BBR_BW_FILTER_LEN;
+	bbr->bw[bbr->bw_idx] = (uint32_t)MIN((uint64_t)bbr->delivered *
+					     USEC_PER_SEC / elapsed,
+					     UINT32_MAX);
+
+	tcp_bbr_update_mode(conn, now_ms);
+}
+
+static void tcp_bbr_set_cwnd(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+
+	if (bbr->mode == BBR_PROBE_RTT) {
+		conn->ca.cwnd = BBR_MIN_CWND_SEGS * conn_mss(conn);
+		return;
+	}
+
+	if (tcp_bbr_max_bw(bbr) == 0U) {
+		/* No model yet, grow as in slow start */
+		conn->ca.cwnd = MIN(cwnd + acked_len, NET_TCP_MAX_WIN);
+		return;
+	}
+
+	target = tcp_bbr_bdp(conn, bbr->full_bw_reached ? BBR_CWND_GAIN :
+						      BBR_HIGH_GAIN);
+
+	if (bbr->full_bw_reached) {
+		cwnd = MIN(cwnd + acked_len, target);
+	} else if (cwnd < target) {
+		cwnd += acked_len;
+	}
+
+	conn->ca.cwnd = CLAMP(cwnd, BBR_MIN_CWND_SEGS * conn_mss(conn),
+			      NET_TCP_MAX_WIN);
+}
+
+static void tcp_bbr_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+	int64_t now_us = k_ticks_to_us_floor64(k_uptime_ticks());
+
+	bbr->delivered += acked_len;
+
+	if (bbr->round_started &&
+	    net_tcp_seq_cmp(conn->seq + acked_len, bbr->round_end_seq) >= 0) {
+		tcp_bbr_round_end(conn, now_us);
+		bbr->round_started = false;
+	}
+
+	if (!bbr->round_started) {
+		/* The round ends once everything in flight now is acked */
+		bbr->round_started = true;
+		bbr->round_start = now_us;
+		bbr->round_end_seq = conn->seq + conn->unacked_len;
+		bbr->delivered = 0U;
+	}
+
+	tcp_bbr_set_cwnd(conn, acked_len);
+	tcp_bbr_log(conn, "pkts_acked");
+}
+
+static void tcp_bbr_fast_retransmit(struct tcp *conn)
+{
+	/* The model is not affected by losses, only keep what is in flight */
+	conn->ca.cwnd = MAX((uint32_t)conn->unacked_len,
+			    BBR_MIN_CWND_SEGS * conn_mss(conn));
+	tcp_bbr_log(conn, "fast_retransmit");
+}
+
+static void tcp_bbr_timeout(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	bbr->round_started = false;
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_bbr_log(conn, "timeout");
+}
+
+static void tcp_bbr_dup_ack(struct tcp *conn)
+{
+	ARG_UNUSED(conn);
+}
+
+static uint32_t tcp_bbr_pacing_rate(struct tcp *conn)
+{
+	struct tcp_bbr *bbr = tcp_ca_priv(conn);
+
+	return (uint32_t)MIN((uint64_t)tcp_bbr_max_bw(bbr) *
+			     tcp_bbr_pacing_gain(bbr) / BBR_UNIT,
+			     UINT32_MAX);
+}
+
+TCP_CA_DEFINE(bbr,
+	.init = tcp_bbr_init,
+	.fast_retransmit = tcp_bbr_fast_retransmit,
+	.timeout = tcp_bbr_timeout,
+	.dup_ack = tcp_bbr_dup_ack,
+	.pkts_acked = tcp_bbr_pkts_acked,
+	.pacing_rate = tcp_bbr_pacing_rate,
+);
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control, according to RFC 9438 */
+
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "tcp_internal.h"
+
+/* Multiplicative decrease factor beta = 0.7 and scaling constant C = 0.4 */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+#define CUBIC_C_NUM 4
+#define CUBIC_C_DEN 10
+
+/* Additive increase of the Reno-friendly estimate,
+ * alpha = 3 * (1 - beta) / (1 + beta) = 9 / 17
+ */
+#define CUBIC_ALPHA_NUM 9
+#define CUBIC_ALPHA_DEN 17
+
+#define CUBIC_INITIAL_WIN 2
+
+/* Limit t - K so that C * (t - K)^3 * mss cannot overflow */
+#define CUBIC_MAX_DELTA_MS 30000
+
+struct tcp_cubic {
+	uint32_t w_max;       /* window before the last reduction, bytes */
+	uint32_t origin;      /* plateau of the cubic function, bytes */
+	uint32_t k_ms;        /* time to reach the plateau, ms */
+	uint32_t w_est;       /* Reno-friendly window estimate, bytes */
+	int64_t epoch_start;  /* start of the avoidance epoch, 0 if none */
+};
+
+BUILD_ASSERT(sizeof(struct tcp_cubic) <= TCP_CA_PRIV_SIZE);
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, w_max=%u, k=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh, cubic->w_max,
+		cubic->k_ms);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+
+	memset(cubic, 0, sizeof(*cubic));
+
+	conn->ca.cwnd = conn_mss(conn) * CUBIC_INITIAL_WIN;
+	conn->ca.ssthresh = NET_TCP_MAX_WIN;
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_cubic_log(conn, "init");
+}
+
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	uint32_t flight = MAX((uint32_t)conn->unacked_len, conn_mss(conn));
+
+	/* Fast convergence, release bandwidth to new flows */
+	if (conn->ca.cwnd < cubic->w_max) {
+		cubic->w_max = (uint32_t)((uint64_t)conn->ca.cwnd *
+					  (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+					  (2 * CUBIC_BETA_DEN));
+	} else {
+		cubic->w_max = conn->ca.cwnd;
+	}
+
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				(uint32_t)((uint64_t)flight * CUBIC_BETA_NUM /
+					   CUBIC_BETA_DEN));
+	cubic->epoch_start = 0;
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_dup_ack(struct tcp *conn)
+{
+	uint32_t new_win = conn->ca.cwnd;
+
+	new_win += conn_mss(conn);
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
+	tcp_cubic_log(conn, "dup_ack");
+}
+
+static void tcp_cubic_epoch_start(struct tcp *conn, int64_t now)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	uint32_t mss = conn_mss(conn);
+
+	cubic->epoch_start = now;
+	cubic->w_est = conn->ca.cwnd;
+
+	if (conn->ca.cwnd < cubic->w_max) {
+		/* K = cbrt((W_max - cwnd) / C), in segments and seconds */
+		cubic->k_ms = cubic_cbrt((uint64_t)(cubic->w_max - conn->ca.cwnd) *
+					 CUBIC_C_DEN * 1000000000ULL /
+					 (CUBIC_C_NUM * mss));
+		cubic->origin = cubic->w_max;
+	} else {
+		cubic->k_ms = 0U;
+		cubic->origin = conn->ca.cwnd;
+	}
+}
+
+/* W_cubic(t) = C * (t - K)^3 + W_max */
+static uint32_t tcp_cubic_target(struct tcp *conn, int64_t now)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	int64_t delta = now - cubic->epoch_start - cubic->k_ms;
+	int64_t offset;
+	int64_t target;
+
+	delta = CLAMP(delta, -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+	offset = CUBIC_C_NUM * delta * delta * delta * conn_mss(conn) /
+		 (CUBIC_C_DEN * 1000000000LL);
+	target = (int64_t)cubic->origin + offset;
+
+	return (uint32_t)CLAMP(target, conn_mss(conn), NET_TCP_MAX_WIN);
+}
+
+static void tcp_cubic_avoid(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_cubic *cubic = tcp_ca_priv(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	int64_t now = k_uptime_get();
+	uint32_t target;
+	uint64_t inc;
+
+	if (cubic->epoch_start == 0) {
+		tcp_cubic_epoch_start(conn, now);
+	}
+
+	/* Do not grow more than 1.5 times per round trip */
+	target = MIN(tcp_cubic_target(conn, now), cwnd + cwnd / 2);
+
+	if (target > cwnd) {
+		inc = (uint64_t)(target - cwnd) * acked_len / cwnd;
+	} else {
+		/* Plateau, probe very slowly */
+		inc = (uint64_t)conn_mss(conn) * acked_len / (100U * cwnd);
+	}
+
+	cubic->w_est += (uint32_t)((uint64_t)CUBIC_ALPHA_NUM * acked_len *
+				   conn_mss(conn) / (CUBIC_ALPHA_DEN * cwnd));
+
+	cwnd = (uint32_t)MIN(cwnd + MAX(inc, 1U), NET_TCP_MAX_WIN);
+
+	/* In the Reno-friendly region, grow at least as fast as Reno would */
+	conn->ca.cwnd = MAX(cwnd, MIN(cubic->w_est, NET_TCP_MAX_WIN));
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	uint32_t new_win = conn->ca.cwnd;
+
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		if (conn->ca.cwnd < conn->ca.ssthresh) {
+			new_win += MIN(acked_len, conn_mss(conn));
+			conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
+		} else {
+			tcp_cubic_avoid(conn, acked_len);
+		}
+	} else {
+		/* Check if it is still in fast recovery mode */
+		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
+			conn->ca.pending_fast_retransmit_bytes = 0;
+			conn->ca.cwnd = conn->ca.ssthresh;
+		} else {
+			conn->ca.pending_fast_retransmit_bytes -= acked_len;
+			conn->ca.cwnd = MAX(conn->ca.cwnd - MIN(acked_len, conn->ca.cwnd),
+					    conn_mss(conn));
+		}
+	}
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+TCP_CA_DEFINE(cubic,
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_cubic_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+);
@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/sys/iterable_sections.h>
+
 #include "tp.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
@@ -146,7 +148,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -192,10 +194,6 @@ enum th_flags {
 	CWR = BIT(7),
 };
 
-struct tcp_mss_option {
-	uint32_t option;
-};
-
 enum tcp_state {
 	TCP_UNUSED = 0,
 	TCP_LISTEN,
@@ -227,31 +225,103 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest shift count allowed in a window scale option (RFC 7323) */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+
+/* A SACK option carries at most 4 blocks in 40 bytes of options */
+#define NET_TCP_MAX_SACK_BLOCKS 4
+
+/* Number of SACKed ranges remembered per connection */
+#define NET_TCP_SACK_SCOREBOARD_SIZE 4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint8_t window; /* window scale shift count */
+	uint8_t sack_count;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool tsopt_found : 1;
 };
 
+struct tcp;
+typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/** Congestion control algorithm, registered with TCP_CA_DEFINE() */
+struct tcp_ca_ops {
+	/** Name, as used with the TCP_CONGESTION socket option */
+	const char *name;
+	/** The connection is established, set up cwnd and the private state */
+	void (*init)(struct tcp *conn);
+	/** Duplicate ACKs indicate a loss, a fast retransmit has been done */
+	void (*fast_retransmit)(struct tcp *conn);
+	/** The retransmission timer has expired */
+	void (*timeout)(struct tcp *conn);
+	/** A duplicate ACK has been received */
+	void (*dup_ack)(struct tcp *conn);
+	/** acked_len new bytes have been acknowledged, conn->seq is not
+	 * updated yet.
+	 */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+#if defined(CONFIG_NET_TCP_PACING)
+	/** Optional, rate to send at in bytes per second, 0 to not pace */
+	uint32_t (*pacing_rate)(struct tcp *conn);
+#endif
 };
+
+#define TCP_CA_DEFINE(_name, ...)					\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops, tcp_ca_##_name) = { \
+		.name = #_name,						\
+		__VA_ARGS__						\
+	}
+
+#if defined(CONFIG_NET_TCP_CA_BBR)
+#define TCP_CA_PRIV_SIZE 64
+#elif defined(CONFIG_NET_TCP_CA_CUBIC)
+#define TCP_CA_PRIV_SIZE 24
 #endif
 
-struct tcp;
-typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
+struct tcp_congestion_avoidance {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#if defined(TCP_CA_PRIV_SIZE)
+	/* State of the algorithm, see tcp_ca_priv() */
+	uint64_t priv[TCP_CA_PRIV_SIZE / sizeof(uint64_t)];
+#endif
+};
+
+#define tcp_ca_priv(_conn) ((void *)(_conn)->ca.priv)
+#endif
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
@@ -281,7 +351,13 @@ struct tcp { /* TCP connection */
 	struct k_work_delayable send_data_timer;
 	struct k_work_delayable timewait_timer;
 	struct k_work_delayable persist_timer;
+	struct k_work_q *work_q; /* runs all the work items below */
 	struct k_work_delayable ack_timer;
+#if defined(CONFIG_NET_TCP_PACING)
+	struct k_work_delayable pacing_timer;
+	int64_t pacing_stamp;   /* uptime in ticks of the last credit update */
+	uint32_t pacing_credit; /* bytes which may be sent right away */
+#endif
 #if defined(CONFIG_NET_TCP_KEEPALIVE)
 	struct k_work_delayable keepalive_timer;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
@@ -314,20 +390,36 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent;       /* last timestamp received from the peer */
+	uint32_t ts_recent_stamp; /* uptime in ms when ts_recent was updated */
+	uint32_t srtt;            /* smoothed RTT in ms, scaled by 8 */
+	uint32_t rttvar;          /* RTT variation in ms, scaled by 4 */
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack_blocks[NET_TCP_SACK_SCOREBOARD_SIZE];
+	uint32_t recovery_point;  /* highest seq sent when recovery started */
+	uint32_t sack_rexmit_next; /* where to look for the next hole */
+	uint8_t sack_block_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_congestion_avoidance ca;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
+#endif
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t snd_wscale; /* shift applied to the windows we receive */
+	uint8_t rcv_wscale; /* shift applied to the windows we send */
 #endif
 	uint8_t zwp_retries;
 	bool in_retransmission : 1;
@@ -338,6 +430,13 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+	/* Options offered in our SYN, and then agreed on by the peer */
+	bool wscale_ok : 1;
+	bool ts_ok : 1;
+	bool sack_ok : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool in_recovery : 1;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
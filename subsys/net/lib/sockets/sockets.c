@@ -402,90 +402,97 @@ ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+static void msghdr_free_copy(struct msghdr *msg_copy, size_t iovlen)
 {
-	struct msghdr msg_copy;
 	size_t i;
-	int ret;
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
+
+	if (msg_copy->msg_iov != NULL) {
+		for (i = 0; i < iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
+
+		k_free(msg_copy->msg_iov);
+	}
+}
+
+static int sendmsg_copy_from_user(struct msghdr *msg_copy,
+				  const struct msghdr *msg)
+{
+	size_t i;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
+
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       msg_copy->msg_iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
 		goto fail;
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
+	/* So that only what was allocated here is freed on failure */
+	memset(msg_copy->msg_iov, 0, msg_copy->msg_iovlen * sizeof(struct iovec));
+
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
 							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+		if (!msg_copy->msg_name) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
 	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
+		msg_copy->msg_control = k_usermode_alloc_from_copy(msg->msg_control,
 							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+		if (!msg_copy->msg_control) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
-
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
-
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
-	}
+	return 0;
 
-	k_free(msg_copy.msg_iov);
+fail:
+	msghdr_free_copy(msg_copy, msg_copy->msg_iovlen);
 
-	return ret;
+	return -1;
+}
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
-	}
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (sendmsg_copy_from_user(&msg_copy, msg) < 0) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
-		}
+	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+				   flags);
 
-		k_free(msg_copy.msg_iov);
-	}
+	msghdr_free_copy(&msg_copy, msg_copy.msg_iovlen);
 
-	return -1;
+	return ret;
 }
 #include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
@@ -557,33 +564,24 @@ ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 }
 
 #ifdef CONFIG_USERSPACE
-ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+/* The original iovlen is returned in iovlen, as the receive functions
+ * shrink msg_iovlen to the number of vectors filled.
+ */
+static int recvmsg_copy_from_user(struct msghdr *msg_copy, struct msghdr *msg,
+				  size_t *iovlen)
 {
-	struct msghdr msg_copy;
-	size_t iovlen;
 	size_t i;
-	int ret;
 
-	if (msg == NULL) {
-		errno = EINVAL;
-		return -1;
-	}
+	K_OOPS(k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
 
-	if (msg->msg_iov == NULL) {
-		errno = ENOMEM;
-		return -1;
-	}
-
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	*iovlen = msg_copy->msg_iovlen;
 
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
-
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
+	msg_copy->msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
+				       *iovlen * sizeof(struct iovec));
+	if (!msg_copy->msg_iov) {
 		errno = ENOMEM;
 		goto fail;
 	}
@@ -592,24 +590,24 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 	 * next loop fails, we do not try to free non allocated memory
 	 * in fail branch.
 	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	memset(msg_copy->msg_iov, 0, *iovlen * sizeof(struct iovec));
 
-	for (i = 0; i < iovlen; i++) {
+	for (i = 0; i < *iovlen; i++) {
 		/* TODO: In practice we do not need to copy the actual data
 		 * in msghdr when receiving data but currently there is no
 		 * ready made function to do just that (unless we want to call
 		 * relevant malloc function here ourselves). So just use
 		 * the copying variant for now.
 		 */
-		msg_copy.msg_iov[i].iov_base =
+		msg_copy->msg_iov[i].iov_base =
 			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
 						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msg_copy->msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
 	if (msg->msg_namelen > 0) {
@@ -618,9 +616,9 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 			goto fail;
 		}
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
+		msg_copy->msg_name = k_usermode_alloc_from_copy(msg->msg_name,
 							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
+		if (msg_copy->msg_name == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
@@ -632,98 +630,350 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 			goto fail;
 		}
 
-		msg_copy.msg_control =
+		msg_copy->msg_control =
 			k_usermode_alloc_from_copy(msg->msg_control,
 						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
+		if (msg_copy->msg_control == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
+	return 0;
+
+fail:
+	msghdr_free_copy(msg_copy, *iovlen);
+
+	return -1;
+}
+
+static void recvmsg_copy_to_user(struct msghdr *msg, struct msghdr *msg_copy,
+				 size_t iovlen)
+{
+	size_t i;
+
+	if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_name,
+					  msg_copy->msg_name,
+					  msg_copy->msg_namelen));
+	}
+
+	if (msg->msg_controllen > 0 &&
+	    msg->msg_control != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_control,
+					  msg_copy->msg_control,
+					  msg_copy->msg_controllen));
+
+		msg->msg_controllen = msg_copy->msg_controllen;
+	} else {
+		msg->msg_controllen = 0U;
+	}
+
+	k_usermode_to_copy(&msg->msg_iovlen,
+			   &msg_copy->msg_iovlen,
+			   sizeof(msg->msg_iovlen));
+
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(msg_copy->msg_iovlen <= iovlen);
+
+	for (i = 0; i < iovlen; i++) {
+		if (i < msg_copy->msg_iovlen) {
+			K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_len));
+			K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
+						  &msg_copy->msg_iov[i].iov_len,
+						  sizeof(msg->msg_iov[i].iov_len)));
+		} else {
+			/* Clear out those vectors that we could not populate */
+			msg->msg_iov[i].iov_len = 0;
+		}
+	}
+
+	k_usermode_to_copy(&msg->msg_flags,
+			   &msg_copy->msg_flags,
+			   sizeof(msg->msg_flags));
+}
+
+ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	struct msghdr msg_copy;
+	size_t iovlen;
+	int ret;
+
+	if (msg == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (msg->msg_iov == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	if (recvmsg_copy_from_user(&msg_copy, msg, &iovlen) < 0) {
+		return -1;
+	}
+
 	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
 
 	/* Do not copy anything back if there was an error or nothing was
 	 * received.
 	 */
 	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
-		}
+		recvmsg_copy_to_user(msg, &msg_copy, iovlen);
+	}
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+	/* Note that we need to free according to original iovlen */
+	msghdr_free_copy(&msg_copy, iovlen);
 
-			msg->msg_controllen = msg_copy.msg_controllen;
-		} else {
-			msg->msg_controllen = 0U;
-		}
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t len;
+	void *obj;
+	int count;
 
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
 
-		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
+	if (vtable->sendmmsg == NULL && vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (vtable->sendmmsg != NULL) {
+		count = vtable->sendmmsg(obj, msgvec, vlen, flags);
+	} else {
+		for (i = 0; i < vlen; i++) {
+			len = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+			if (len < 0) {
+				break;
 			}
+
+			msgvec[i].msg_len = len;
 		}
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+		count = (i == 0 && vlen > 0) ? -1 : (int)i;
 	}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	k_mutex_unlock(lock);
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+	for (i = 0; (int)i < count; i++) {
+		sock_obj_core_update_send_stats(sock, msgvec[i].msg_len);
 	}
 
-	k_free(msg_copy.msg_iov);
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	unsigned int copied;
+	unsigned int i;
+	int ret = -1;
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
+	}
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (copied = 0; copied < vlen; copied++) {
+		if (sendmsg_copy_from_user(&msgvec_copy[copied].msg_hdr,
+					   &msgvec[copied].msg_hdr) < 0) {
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; (int)i < ret; i++) {
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len,
+					  &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (i = 0; i < copied; i++) {
+		msghdr_free_copy(&msgvec_copy[i].msg_hdr,
+				 msgvec_copy[i].msg_hdr.msg_iovlen);
+	}
+
+	k_free(msgvec_copy);
 
 	return ret;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags, struct timespec *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t wait = K_FOREVER;
+	struct k_mutex *lock;
+	k_timepoint_t end;
+	unsigned int i;
+	ssize_t len;
+	void *obj;
+	int count;
+
+	if (timeout != NULL) {
+		if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+		    timeout->tv_nsec >= (long)NSEC_PER_SEC) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		wait = K_USEC((uint64_t)timeout->tv_sec * USEC_PER_SEC +
+			      timeout->tv_nsec / NSEC_PER_USEC);
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
+	if (vtable->recvmmsg == NULL && vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if (vtable->recvmmsg != NULL) {
+		count = vtable->recvmmsg(obj, msgvec, vlen, flags,
+					 timeout != NULL ? &wait : NULL);
+	} else {
+		/* Without native support the timeout can only be checked
+		 * between messages.
+		 */
+		end = sys_timepoint_calc(wait);
+
+		for (i = 0; i < vlen; i++) {
+			len = vtable->recvmsg(obj, &msgvec[i].msg_hdr,
+					      flags & ~ZSOCK_MSG_WAITFORONE);
+			if (len < 0) {
+				break;
+			}
+
+			msgvec[i].msg_len = len;
+
+			if ((flags & ZSOCK_MSG_WAITFORONE) ||
+			    sys_timepoint_expired(end)) {
+				flags |= ZSOCK_MSG_DONTWAIT;
 			}
 		}
 
-		k_free(msg_copy.msg_iov);
+		count = (i == 0 && vlen > 0) ? -1 : (int)i;
 	}
 
-	return -1;
+	k_mutex_unlock(lock);
+
+	for (i = 0; (int)i < count; i++) {
+		sock_obj_core_update_recv_stats(sock, msgvec[i].msg_len);
+	}
+
+	return count;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					struct timespec *timeout)
+{
+	struct mmsghdr *msgvec_copy;
+	struct mmsghdr *orig;
+	struct timespec timeout_copy;
+	unsigned int copied = 0;
+	unsigned int i;
+	int ret = -1;
+
+	if (timeout != NULL) {
+		K_OOPS(k_usermode_from_copy(&timeout_copy, timeout,
+					    sizeof(timeout_copy)));
+	}
+
+	vlen = MIN(vlen, ZSOCK_MMSG_VLEN_MAX);
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags,
+					     timeout != NULL ? &timeout_copy : NULL);
+	}
+
+	msgvec_copy = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+
+	/* Only used to keep the original iovlen of each message, which the
+	 * receive functions shrink to the number of vectors filled.
+	 */
+	orig = k_usermode_alloc_from_copy(msgvec, vlen * sizeof(*msgvec));
+	if (msgvec_copy == NULL || orig == NULL) {
+		errno = ENOMEM;
+		goto out;
+	}
+
+	for (copied = 0; copied < vlen; copied++) {
+		struct msghdr *msg = &msgvec[copied].msg_hdr;
+
+		if (msg->msg_iov == NULL) {
+			errno = ENOMEM;
+			goto out;
+		}
+
+		if (recvmsg_copy_from_user(&msgvec_copy[copied].msg_hdr, msg,
+					   &orig[copied].msg_hdr.msg_iovlen) < 0) {
+			goto out;
+		}
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags,
+				    timeout != NULL ? &timeout_copy : NULL);
+
+	for (i = 0; (int)i < ret; i++) {
+		recvmsg_copy_to_user(&msgvec[i].msg_hdr, &msgvec_copy[i].msg_hdr,
+				     orig[i].msg_hdr.msg_iovlen);
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len,
+					  &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
+	}
+
+out:
+	for (i = 0; i < copied; i++) {
+		msghdr_free_copy(&msgvec_copy[i].msg_hdr,
+				 orig[i].msg_hdr.msg_iovlen);
+	}
+
+	k_free(orig);
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
 /* As this is limited function, we don't follow POSIX signature, with
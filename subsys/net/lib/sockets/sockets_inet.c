@@ -1037,27 +1037,23 @@ static int update_msg_controllen(struct msghdr *msg)
 	return 0;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       struct msghdr *msg,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+static ssize_t zsock_recv_dgram_timed(struct net_context *ctx,
+				      struct msghdr *msg,
+				      void *buf,
+				      size_t max_len,
+				      int flags,
+				      struct sockaddr *src_addr,
+				      socklen_t *addrlen,
+				      k_timeout_t timeout)
 {
-	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
 	size_t read_len;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
 
-	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
-		timeout = K_NO_WAIT;
-	} else {
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		int ret;
 
-		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
-
 		ret = zsock_wait_data(ctx, &timeout);
 		if (ret < 0) {
 			errno = -ret;
@@ -1229,6 +1225,26 @@ fail:
 	return -1;
 }
 
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       struct msghdr *msg,
+				       void *buf,
+				       size_t max_len,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	return zsock_recv_dgram_timed(ctx, msg, buf, max_len, flags,
+				      src_addr, addrlen, timeout);
+}
+
 static size_t zsock_recv_stream_immediate(struct net_context *ctx, uint8_t **buf, size_t *max_len,
 					  int flags)
 {
@@ -1499,6 +1515,80 @@ ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
 	return -1;
 }
 
+/* Datagrams are dequeued against a single deadline for the whole batch,
+ * other socket types only check it between messages.
+ */
+int zsock_recvmmsg_ctx(struct net_context *ctx, struct mmsghdr *msgvec,
+		       unsigned int vlen, int flags, const k_timeout_t *timeout)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	const bool waitforone = (flags & ZSOCK_MSG_WAITFORONE) != 0;
+	k_timeout_t wait = K_FOREVER;
+	unsigned int count = 0;
+	struct msghdr *msg;
+	k_timepoint_t end;
+	size_t i, max_len;
+	ssize_t len;
+
+	flags &= ~ZSOCK_MSG_WAITFORONE;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		wait = K_NO_WAIT;
+	} else if (timeout != NULL) {
+		wait = *timeout;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &wait, NULL);
+	}
+
+	if (K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	end = sys_timepoint_calc(wait);
+
+	while (count < vlen) {
+		msg = &msgvec[count].msg_hdr;
+
+		if (sock_type != SOCK_DGRAM) {
+			len = zsock_recvmsg_ctx(ctx, msg, flags);
+		} else if (msg->msg_iov == NULL) {
+			errno = ENOMEM;
+			len = -1;
+		} else {
+			for (i = 0, max_len = 0; i < msg->msg_iovlen; i++) {
+				max_len += msg->msg_iov[i].iov_len;
+			}
+
+			len = zsock_recv_dgram_timed(ctx, msg, NULL, max_len, flags,
+						     msg->msg_name,
+						     &msg->msg_namelen,
+						     sys_timepoint_timeout(end));
+		}
+
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[count++].msg_len = len;
+
+		if (len == 0 && sock_type == SOCK_STREAM) {
+			/* End of stream */
+			break;
+		}
+
+		if (waitforone || sys_timepoint_expired(end)) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+			end = sys_timepoint_calc(K_NO_WAIT);
+		}
+	}
+
+	if (count == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return count;
+}
+
 static int zsock_poll_prepare_ctx(struct net_context *ctx,
 				  struct zsock_pollfd *pfd,
 				  struct k_poll_event **pev,
@@ -1597,6 +1687,8 @@ static enum tcp_conn_option get_tcp_option(int optname)
 		return TCP_OPT_KEEPINTVL;
 	case TCP_KEEPCNT:
 		return TCP_OPT_KEEPCNT;
+	case TCP_CONGESTION:
+		return TCP_OPT_CONGESTION;
 	}
 
 	return -EINVAL;
@@ -1788,6 +1880,21 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx,
+							 get_tcp_option(optname),
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -2320,6 +2427,21 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx,
+							 get_tcp_option(optname),
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
@@ -2751,6 +2873,13 @@ static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
 	return zsock_recvmsg_ctx(obj, msg, flags);
 }
 
+static int sock_recvmmsg_vmeth(void *obj, struct mmsghdr *msgvec,
+			      unsigned int vlen, int flags,
+			      const k_timeout_t *timeout)
+{
+	return zsock_recvmmsg_ctx(obj, msgvec, vlen, flags, timeout);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -2802,6 +2931,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvmsg = sock_recvmsg_vmeth,
+	.recvmmsg = sock_recvmmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
@@ -71,6 +71,13 @@ struct socket_op_vtable {
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
 	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
+	/* Optional, the sockets layer loops over sendmsg/recvmsg otherwise.
+	 * A NULL timeout means the socket's own timeouts apply.
+	 */
+	int (*sendmmsg)(void *obj, struct mmsghdr *msgvec, unsigned int vlen,
+			int flags);
+	int (*recvmmsg)(void *obj, struct mmsghdr *msgvec, unsigned int vlen,
+			int flags, const k_timeout_t *timeout);
 	int (*getpeername)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
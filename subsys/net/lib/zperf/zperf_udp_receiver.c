@@ -312,14 +312,65 @@ static void udp_receiver_cleanup(void)
 	zperf_session_reset(SESSION_UDP);
 }
 
-static int udp_recv_data(struct net_socket_service_event *pev)
+#if CONFIG_NET_ZPERF_UDP_BATCH > 1
+static int udp_recv_batch(int sock)
+{
+	static uint8_t bufs[CONFIG_NET_ZPERF_UDP_BATCH][UDP_RECEIVER_BUF_SIZE];
+	static struct sockaddr addrs[CONFIG_NET_ZPERF_UDP_BATCH];
+	static struct iovec iov[CONFIG_NET_ZPERF_UDP_BATCH];
+	static struct mmsghdr msgs[CONFIG_NET_ZPERF_UDP_BATCH];
+	int count;
+
+	/* The receive functions update the headers, reset them every time */
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+
+		msgs[i].msg_hdr = (struct msghdr) {
+			.msg_name = &addrs[i],
+			.msg_namelen = sizeof(addrs[i]),
+			.msg_iov = &iov[i],
+			.msg_iovlen = 1,
+		};
+	}
+
+	/* Polling has reported data, do not wait for a full batch */
+	count = zsock_recvmmsg(sock, msgs, ARRAY_SIZE(msgs), ZSOCK_MSG_DONTWAIT,
+			       NULL);
+	if (count < 0) {
+		return -1;
+	}
+
+	for (int i = 0; i < count; i++) {
+		udp_received(sock, &addrs[i], bufs[i], msgs[i].msg_len);
+	}
+
+	return count;
+}
+#else
+static int udp_recv_one(int sock)
 {
 	static uint8_t buf[UDP_RECEIVER_BUF_SIZE];
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	int ret;
+
+	ret = zsock_recvfrom(sock, buf, sizeof(buf), 0, &addr, &addrlen);
+	if (ret < 0) {
+		return -1;
+	}
+
+	udp_received(sock, &addr, buf, ret);
+
+	return ret;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH > 1 */
+
+static int udp_recv_data(struct net_socket_service_event *pev)
+{
 	int ret = 0;
 	int family, sock_error;
-	struct sockaddr addr;
 	socklen_t optlen = sizeof(int);
-	socklen_t addrlen = sizeof(addr);
 
 	if (!udp_server_running) {
 		return -ENOENT;
@@ -341,8 +392,11 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		return 0;
 	}
 
-	ret = zsock_recvfrom(pev->event.fd, buf, sizeof(buf), 0,
-			     &addr, &addrlen);
+#if CONFIG_NET_ZPERF_UDP_BATCH > 1
+	ret = udp_recv_batch(pev->event.fd);
+#else
+	ret = udp_recv_one(pev->event.fd);
+#endif
 	if (ret < 0) {
 		ret = -errno;
 		(void)zsock_getsockopt(pev->event.fd, SOL_SOCKET,
@@ -352,8 +406,6 @@ static int udp_recv_data(struct net_socket_service_event *pev)
 		goto error;
 	}
 
-	udp_received(pev->event.fd, &addr, buf, ret);
-
 	return ret;
 
 error:
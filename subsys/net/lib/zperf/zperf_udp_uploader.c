@@ -20,6 +20,52 @@ static uint8_t sample_packet[sizeof(struct zperf_udp_datagram) +
 
 static struct zperf_async_upload_context udp_async_upload_ctx;
 
+#if CONFIG_NET_ZPERF_UDP_BATCH > 1
+#define UDP_UPLOAD_HDR_LEN (sizeof(struct zperf_udp_datagram) + \
+			    sizeof(struct zperf_client_hdr_v1))
+
+/* Only the headers differ between the datagrams of a batch, the payload
+ * of sample_packet is shared by all of them.
+ */
+static uint8_t batch_hdrs[CONFIG_NET_ZPERF_UDP_BATCH][UDP_UPLOAD_HDR_LEN];
+static struct iovec batch_iov[CONFIG_NET_ZPERF_UDP_BATCH][2];
+static struct mmsghdr batch_msgs[CONFIG_NET_ZPERF_UDP_BATCH];
+
+static int udp_send_batch(int sock, uint32_t packet_size,
+			  uint32_t *nb_packets)
+{
+	size_t hdr_len = MIN(packet_size, UDP_UPLOAD_HDR_LEN);
+	struct zperf_udp_datagram *datagram;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(batch_msgs); i++) {
+		memcpy(batch_hdrs[i], sample_packet, hdr_len);
+
+		datagram = (struct zperf_udp_datagram *)batch_hdrs[i];
+		datagram->id = htonl(*nb_packets + i);
+
+		batch_iov[i][0].iov_base = batch_hdrs[i];
+		batch_iov[i][0].iov_len = hdr_len;
+		batch_iov[i][1].iov_base = sample_packet + hdr_len;
+		batch_iov[i][1].iov_len = packet_size - hdr_len;
+
+		batch_msgs[i].msg_hdr = (struct msghdr) {
+			.msg_iov = batch_iov[i],
+			.msg_iovlen = ARRAY_SIZE(batch_iov[i]),
+		};
+	}
+
+	ret = zsock_sendmmsg(sock, batch_msgs, ARRAY_SIZE(batch_msgs), 0);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	*nb_packets += ret;
+
+	return 0;
+}
+#endif /* CONFIG_NET_ZPERF_UDP_BATCH > 1 */
+
 static inline void zperf_upload_decode_stat(const uint8_t *data,
 					    size_t datalen,
 					    struct zperf_results *results)
@@ -146,7 +192,9 @@ static int udp_upload(int sock, int port,
 	uint32_t packet_size = param->packet_size;
 	uint32_t rate_in_kbps = param->rate_kbps;
 	uint32_t packet_duration_us = zperf_packet_duration(packet_size, rate_in_kbps);
-	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us);
+	/* Each loop iteration sends a batch of packets */
+	uint32_t packet_duration = k_us_to_ticks_ceil32(packet_duration_us *
+							CONFIG_NET_ZPERF_UDP_BATCH);
 	uint32_t delay = packet_duration;
 	uint32_t nb_packets = 0U;
 	int64_t start_time, end_time;
@@ -227,6 +275,13 @@ static int udp_upload(int sock, int port,
 		hdr->num_of_bytes = htonl(packet_size);
 
 		/* Send the packet */
+#if CONFIG_NET_ZPERF_UDP_BATCH > 1
+		ret = udp_send_batch(sock, packet_size, &nb_packets);
+		if (ret < 0) {
+			NET_ERR("Failed to send the packets (%d)", -ret);
+			return ret;
+		}
+#else
 		ret = zsock_send(sock, sample_packet, packet_size, 0);
 		if (ret < 0) {
 			NET_ERR("Failed to send the packet (%d)", errno);
@@ -234,6 +289,7 @@ static int udp_upload(int sock, int port,
 		} else {
 			nb_packets++;
 		}
+#endif
 
 		if (IS_ENABLED(CONFIG_NET_ZPERF_LOG_LEVEL_DBG)) {
 			if (print_time >= loop_time) {
@@ -104,3 +104,15 @@ size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
 
 	return idx;
 }
+
+/*
+ * Only the interrupted pc is needed by the sampler, which is saved in the
+ * esf, so no frame is unwound
+ */
+uintptr_t arch_perf_current_pc(void)
+{
+	const struct arch_esf * const esf =
+		*((struct arch_esf **)(((uintptr_t)_current_cpu->irq_stack) - 16));
+
+	return (uintptr_t)esf->mepc;
+}
@@ -92,3 +92,15 @@ size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
 
 	return idx;
 }
+
+/*
+ * Only the interrupted %eip is needed by the sampler, which is saved in the
+ * isf, so no frame is unwound
+ */
+uintptr_t arch_perf_current_pc(void)
+{
+	const struct isf * const isf =
+		*((struct isf **)(((void **)_current_cpu->irq_stack)-1));
+
+	return (uintptr_t)isf->eip;
+}
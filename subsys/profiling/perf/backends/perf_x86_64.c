@@ -78,3 +78,12 @@ size_t arch_perf_current_stack_trace(uintptr_t *buf, size_t size)
 
 	return idx;
 }
+
+/*
+ * Only the interrupted %rip is needed by the sampler, which is saved in
+ * _current->callee_saved, so no frame is unwound
+ */
+uintptr_t arch_perf_current_pc(void)
+{
+	return (uintptr_t)_current->callee_saved.rip;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/debug/symtab.h>
+#include <zephyr/profiling/sampler.h>
+#include <zephyr/sys/util.h>
+
+uintptr_t arch_perf_current_pc(void);
+
+/*
+ * The samples are counted in place, in an open addressing hash table keyed
+ * by thread and function, so that the timer interrupt does a symbol table
+ * lookup and a few probes, and nothing needs to be post-processed.
+ */
+#define SAMPLER_MAX_PROBES 8
+
+struct sampler_slot {
+	k_tid_t thread;
+	const char *func;
+	uint32_t count;
+};
+
+static struct sampler_slot slots[CONFIG_PROFILING_SAMPLER_ENTRIES];
+static struct profiling_sampler_stats stats;
+static struct k_spinlock lock;
+
+static void sampler_tick(struct k_timer *timer);
+static K_TIMER_DEFINE(sampler_timer, sampler_tick, NULL);
+
+static inline uint32_t sampler_hash(k_tid_t thread, const char *func)
+{
+	uint32_t h = (uint32_t)((uintptr_t)thread ^ ((uintptr_t)func << 3));
+
+	/* Knuth's multiplicative hash */
+	return (h * 2654435761U) % CONFIG_PROFILING_SAMPLER_ENTRIES;
+}
+
+/* must be called with the lock held */
+static bool sampler_count(k_tid_t thread, const char *func)
+{
+	uint32_t i = sampler_hash(thread, func);
+
+	for (int probe = 0; probe < SAMPLER_MAX_PROBES; probe++) {
+		struct sampler_slot *slot = &slots[i];
+
+		if (slot->count == 0U) {
+			slot->thread = thread;
+			slot->func = func;
+		}
+
+		if ((slot->thread == thread) && (slot->func == func)) {
+			slot->count++;
+			return true;
+		}
+
+		i = (i + 1U) % CONFIG_PROFILING_SAMPLER_ENTRIES;
+	}
+
+	return false;
+}
+
+static void sampler_tick(struct k_timer *timer)
+{
+	const char *func;
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(timer);
+
+	/*
+	 * Only the interrupted function is counted, the callers are not, so
+	 * the stack is not unwound
+	 */
+	func = symtab_find_symbol_name(arch_perf_current_pc(), NULL);
+
+	key = k_spin_lock(&lock);
+
+	stats.samples++;
+	if ((func == NULL) || !sampler_count(_current, func)) {
+		stats.dropped++;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+int profiling_sampler_start(uint32_t frequency)
+{
+	k_timeout_t period;
+
+	if ((frequency == 0U) ||
+	    (frequency > CONFIG_SYS_CLOCK_TICKS_PER_SEC)) {
+		return -EINVAL;
+	}
+
+	period = K_NSEC(NSEC_PER_SEC / frequency);
+	stats.frequency = frequency;
+	k_timer_start(&sampler_timer, period, period);
+
+	return 0;
+}
+
+void profiling_sampler_stop(void)
+{
+	k_timer_stop(&sampler_timer);
+	stats.frequency = 0U;
+}
+
+void profiling_sampler_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(slots, 0, sizeof(slots));
+	stats.samples = 0U;
+	stats.dropped = 0U;
+
+	k_spin_unlock(&lock, key);
+}
+
+void profiling_sampler_stats_get(struct profiling_sampler_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+size_t profiling_sampler_top(struct profiling_sampler_entry *entries,
+			     size_t max_entries)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(slots); i++) {
+		struct profiling_sampler_entry entry;
+		k_spinlock_key_t key;
+		size_t j;
+
+		key = k_spin_lock(&lock);
+		entry.thread = slots[i].thread;
+		entry.func = slots[i].func;
+		entry.count = slots[i].count;
+		k_spin_unlock(&lock, key);
+
+		if (entry.count == 0U) {
+			continue;
+		}
+
+		/* Insertion into the entries sorted so far */
+		for (j = count; j > 0; j--) {
+			if (entries[j - 1].count >= entry.count) {
+				break;
+			}
+			if (j < max_entries) {
+				entries[j] = entries[j - 1];
+			}
+		}
+
+		if (j < max_entries) {
+			entries[j] = entry;
+			count = MIN(count + 1, max_entries);
+		}
+	}
+
+	return count;
+}
+
+struct thread_name_data {
+	k_tid_t thread;
+	char *buf;
+	size_t size;
+	bool found;
+};
+
+static void thread_name_cb(const struct k_thread *thread, void *user_data)
+{
+	struct thread_name_data *data = user_data;
+	const char *name;
+
+	if (thread != data->thread) {
+		return;
+	}
+
+	name = k_thread_name_get((k_tid_t)thread);
+	if ((name != NULL) && (name[0] != '\0')) {
+		strncpy(data->buf, name, data->size - 1);
+		data->buf[data->size - 1] = '\0';
+		data->found = true;
+	}
+}
+
+const char *profiling_sampler_thread_name(k_tid_t thread, char *buf,
+					  size_t size)
+{
+	struct thread_name_data data = {
+		.thread = thread,
+		.buf = buf,
+		.size = size,
+	};
+
+	if (IS_ENABLED(CONFIG_THREAD_MONITOR) && IS_ENABLED(CONFIG_THREAD_NAME)) {
+		k_thread_foreach(thread_name_cb, &data);
+	}
+
+	if (!data.found) {
+		snprintf(buf, size, "%p", (void *)thread);
+	}
+
+	return buf;
+}
+
+#ifdef CONFIG_PROFILING_SAMPLER_AUTOSTART
+static int sampler_init(void)
+{
+	return profiling_sampler_start(CONFIG_PROFILING_SAMPLER_FREQUENCY);
+}
+
+SYS_INIT(sampler_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+#endif /* CONFIG_PROFILING_SAMPLER_AUTOSTART */
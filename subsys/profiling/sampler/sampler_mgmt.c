@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/sampler.h>
+
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+
+#include <mgmt/mcumgr/util/zcbor_bulk.h>
+
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/mgmt/handlers.h>
+#include <zephyr/mgmt/mcumgr/smp/smp.h>
+#include <zephyr/mgmt/mcumgr/grp/zephyr/zephyr_profiling.h>
+
+/**
+ * Command handler: read the sampler histogram
+ */
+static int sampler_mgmt_samples_read(struct smp_streamer *ctxt)
+{
+	struct profiling_sampler_entry entries[CONFIG_PROFILING_SAMPLER_MGMT_TOP_MAX];
+	struct profiling_sampler_stats stats;
+	zcbor_state_t *zse = ctxt->writer->zs;
+	char name[CONFIG_PROFILING_SAMPLER_MGMT_MAX_NAME_LEN];
+	size_t count;
+	bool ok;
+
+	profiling_sampler_stats_get(&stats);
+	count = profiling_sampler_top(entries, ARRAY_SIZE(entries));
+
+	ok = zcbor_tstr_put_lit(zse, "freq")		&&
+	     zcbor_uint32_put(zse, stats.frequency)	&&
+	     zcbor_tstr_put_lit(zse, "samples")		&&
+	     zcbor_uint32_put(zse, stats.samples)	&&
+	     zcbor_tstr_put_lit(zse, "dropped")		&&
+	     zcbor_uint32_put(zse, stats.dropped)	&&
+	     zcbor_tstr_put_lit(zse, "top")		&&
+	     zcbor_list_start_encode(zse, count);
+
+	for (size_t i = 0; ok && (i < count); i++) {
+		profiling_sampler_thread_name(entries[i].thread, name, sizeof(name));
+
+		ok = zcbor_map_start_encode(zse, 3)				&&
+		     zcbor_tstr_put_lit(zse, "thread")				&&
+		     zcbor_tstr_put_term(zse, name, sizeof(name))		&&
+		     zcbor_tstr_put_lit(zse, "func")				&&
+		     zcbor_tstr_put_term(zse, entries[i].func,
+					 CONFIG_PROFILING_SAMPLER_MGMT_MAX_NAME_LEN) &&
+		     zcbor_tstr_put_lit(zse, "count")				&&
+		     zcbor_uint32_put(zse, entries[i].count)			&&
+		     zcbor_map_end_encode(zse, 3);
+	}
+
+	ok = ok && zcbor_list_end_encode(zse, count);
+
+	return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
+}
+
+/**
+ * Command handler: reset the sampler histogram
+ */
+static int sampler_mgmt_samples_reset(struct smp_streamer *ctxt)
+{
+	ARG_UNUSED(ctxt);
+
+	profiling_sampler_reset();
+
+	return MGMT_ERR_EOK;
+}
+
+/**
+ * Command handler: start the sampler at "freq" Hz, or stop it if 0
+ */
+static int sampler_mgmt_sampler_write(struct smp_streamer *ctxt)
+{
+	zcbor_state_t *zse = ctxt->writer->zs;
+	zcbor_state_t *zsd = ctxt->reader->zs;
+	uint32_t frequency = 0;
+	size_t decoded;
+	bool ok = true;
+
+	struct zcbor_map_decode_key_val sampler_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("freq", zcbor_uint32_decode, &frequency),
+	};
+
+	if ((zcbor_map_decode_bulk(zsd, sampler_decode, ARRAY_SIZE(sampler_decode),
+				   &decoded) != 0) ||
+	    !zcbor_map_decode_bulk_key_found(sampler_decode, ARRAY_SIZE(sampler_decode),
+					     "freq")) {
+		return MGMT_ERR_EINVAL;
+	}
+
+	if (frequency == 0U) {
+		profiling_sampler_stop();
+	} else if (profiling_sampler_start(frequency) != 0) {
+		ok = smp_add_cmd_err(zse, ZEPHYR_MGMT_GRP_PROFILING,
+				     ZEPHYRPROFILING_MGMT_ERR_INVALID_FREQUENCY);
+	}
+
+	return ok ? MGMT_ERR_EOK : MGMT_ERR_EMSGSIZE;
+}
+
+#ifdef CONFIG_MCUMGR_SMP_SUPPORT_ORIGINAL_PROTOCOL
+/*
+ * @brief	Translate zephyr profiling group error code into MCUmgr error code
+ *
+ * @param ret	#zephyr_profiling_group_err_code_t error code
+ *
+ * @return	#mcumgr_err_t error code
+ */
+static int zephyr_profiling_group_translate_error_code(uint16_t err)
+{
+	int rc;
+
+	switch (err) {
+	case ZEPHYRPROFILING_MGMT_ERR_INVALID_FREQUENCY:
+		rc = MGMT_ERR_EINVAL;
+		break;
+
+	default:
+		rc = MGMT_ERR_EUNKNOWN;
+	}
+
+	return rc;
+}
+#endif
+
+static const struct mgmt_handler zephyr_mgmt_profiling_handlers[] = {
+	[ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLES] = {
+		.mh_read  = sampler_mgmt_samples_read,
+		.mh_write = sampler_mgmt_samples_reset,
+	},
+	[ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLER] = {
+		.mh_read  = NULL,
+		.mh_write = sampler_mgmt_sampler_write,
+	},
+};
+
+static struct mgmt_group zephyr_profiling_mgmt_group = {
+	.mg_handlers = zephyr_mgmt_profiling_handlers,
+	.mg_handlers_count = ARRAY_SIZE(zephyr_mgmt_profiling_handlers),
+	.mg_group_id = ZEPHYR_MGMT_GRP_PROFILING,
+#ifdef CONFIG_MCUMGR_SMP_SUPPORT_ORIGINAL_PROTOCOL
+	.mg_translate_error = zephyr_profiling_group_translate_error_code,
+#endif
+#ifdef CONFIG_MCUMGR_GRP_ENUM_DETAILS_NAME
+	.mg_group_name = "zephyr profiling mgmt",
+#endif
+};
+
+static void zephyr_profiling_mgmt_init(void)
+{
+	mgmt_register_group(&zephyr_profiling_mgmt_group);
+}
+
+MCUMGR_HANDLER_DEFINE(zephyr_profiling_mgmt, zephyr_profiling_mgmt_init);
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/profiling/sampler.h>
+
+#define SAMPLER_TOP_DEFAULT 10
+#define SAMPLER_NAME_LEN    32
+
+static int cmd_sampler_start(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t frequency = CONFIG_PROFILING_SAMPLER_FREQUENCY;
+	int ret;
+
+	if (argc > 1) {
+		frequency = strtoul(argv[1], NULL, 10);
+	}
+
+	ret = profiling_sampler_start(frequency);
+	if (ret != 0) {
+		shell_error(sh, "Invalid frequency %u Hz", frequency);
+		return ret;
+	}
+
+	shell_print(sh, "Sampling at %u Hz", frequency);
+
+	return 0;
+}
+
+static int cmd_sampler_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	profiling_sampler_stop();
+
+	return 0;
+}
+
+static int cmd_sampler_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	profiling_sampler_reset();
+
+	return 0;
+}
+
+static int cmd_sampler_info(const struct shell *sh, size_t argc, char **argv)
+{
+	struct profiling_sampler_stats stats;
+
+	profiling_sampler_stats_get(&stats);
+
+	if (stats.frequency != 0U) {
+		shell_print(sh, "Sampling at %u Hz", stats.frequency);
+	} else {
+		shell_print(sh, "Stopped");
+	}
+
+	shell_print(sh, "Samples: %u, dropped: %u", stats.samples, stats.dropped);
+
+	return 0;
+}
+
+static int cmd_sampler_top(const struct shell *sh, size_t argc, char **argv)
+{
+	struct profiling_sampler_entry entries[CONFIG_PROFILING_SAMPLER_SHELL_TOP_MAX];
+	struct profiling_sampler_stats stats;
+	char name[SAMPLER_NAME_LEN];
+	size_t max_entries = SAMPLER_TOP_DEFAULT;
+	size_t count;
+
+	if (argc > 1) {
+		max_entries = strtoul(argv[1], NULL, 10);
+	}
+	max_entries = CLAMP(max_entries, 1, ARRAY_SIZE(entries));
+
+	profiling_sampler_stats_get(&stats);
+	count = profiling_sampler_top(entries, max_entries);
+
+	shell_print(sh, "%10s %6s  %-20s %s", "SAMPLES", "%", "THREAD", "FUNCTION");
+
+	for (size_t i = 0; i < count; i++) {
+		uint32_t permille = (uint32_t)(((uint64_t)entries[i].count * 1000U) /
+					       MAX(stats.samples, 1U));
+
+		shell_print(sh, "%10u %4u.%u  %-20s %s", entries[i].count,
+			    permille / 10U, permille % 10U,
+			    profiling_sampler_thread_name(entries[i].thread, name,
+							  sizeof(name)),
+			    entries[i].func);
+	}
+
+	return 0;
+}
+
+#define CMD_HELP_START                                                                             \
+	"Start sampling at <frequency> Hz\n"                                                       \
+	"Usage: start [<frequency>]"
+
+#define CMD_HELP_TOP                                                                               \
+	"Print the <count> functions sampled the most, per thread\n"                               \
+	"Usage: top [<count>]"
+
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_sampler,
+	SHELL_CMD_ARG(start, NULL, CMD_HELP_START, cmd_sampler_start, 1, 1),
+	SHELL_CMD_ARG(stop, NULL, "Stop sampling", cmd_sampler_stop, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Discard the samples", cmd_sampler_reset, 1, 0),
+	SHELL_CMD_ARG(info, NULL, "Print the sampler state", cmd_sampler_info, 1, 0),
+	SHELL_CMD_ARG(top, NULL, CMD_HELP_TOP, cmd_sampler_top, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+SHELL_CMD_ARG_REGISTER(sampler, &m_sub_sampler, "Sampling profiler", NULL, 0, 0);
@@ -13,6 +13,7 @@
  * 2. Immediately receiving any or all events.
  * 3. Blocking to receive either any or all events.
  * 4. Waking (and switching to) a thread waiting for any or all events.
+ * 5. Posting events to an event object many other threads wait on.
  */
 
 #include <zephyr/kernel.h>
@@ -330,3 +331,163 @@ int event_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 
 	return 0;
 }
+
+#ifdef CONFIG_BENCHMARK_EVENT_FANOUT
+#define FANOUT_WAITERS     31
+#define FANOUT_STACK_SIZE  (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_EVENT_DEFINE(event_fanout);
+
+static struct k_thread fanout_thread[FANOUT_WAITERS];
+static K_THREAD_STACK_ARRAY_DEFINE(fanout_stack, FANOUT_WAITERS,
+				   FANOUT_STACK_SIZE);
+static volatile bool fanout_done;
+
+static void fanout_waiter_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  events = (uint32_t)(uintptr_t)p1;
+
+	do {
+		k_event_wait(&event_fanout, events, true, K_FOREVER);
+	} while (!fanout_done);
+}
+
+static void fanout_start_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	timing_t  start;
+	timing_t  finish;
+	uint32_t  i;
+
+	/* 2. Post and clear an event none of the waiters is waiting for */
+
+	start = timing_timestamp_get();
+	for (i = 0; i < num_iterations; i++) {
+		k_event_post(&event_fanout, BIT(0));
+		k_event_clear(&event_fanout, BIT(0));
+	}
+	finish = timing_timestamp_get();
+
+	timestamp.cycles = timing_cycles_get(&start, &finish);
+
+	/* 3. Pause to allow main thread to print results */
+
+	k_sem_take(&pause_sem, K_FOREVER);
+
+	k_thread_start(&alt_thread);
+
+	for (i = 0; i < num_iterations; i++) {
+
+		/* 6. Post the event to wake alt_thread */
+
+		timestamp.sample = timing_timestamp_get();
+		k_event_post(&event_fanout, BIT(0));
+	}
+
+	k_thread_join(&alt_thread, K_FOREVER);
+}
+
+static void fanout_alt_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t  num_iterations = (uint32_t)(uintptr_t)p1;
+	uint32_t  i;
+	timing_t  mid;
+	timing_t  finish;
+	uint64_t  sum = 0ULL;
+
+	for (i = 0; i < num_iterations; i++) {
+
+		/* 5. Wait for the event */
+
+		k_event_wait(&event_fanout, BIT(0), true, K_FOREVER);
+
+		/* 7. Record the final timestamp */
+
+		finish = timing_timestamp_get();
+		mid = timestamp.sample;
+
+		sum += timing_cycles_get(&mid, &finish);
+	}
+
+	timestamp.cycles = sum;
+}
+
+int event_fanout_ops(uint32_t num_iterations)
+{
+	int       priority;
+	char      tag[50];
+	char      description[120];
+	uint64_t  cycles;
+	uint32_t  i;
+
+	priority = k_thread_priority_get(k_current_get());
+
+	timing_start();
+
+	/* 1. Block one waiter on each of the other events */
+
+	k_event_clear(&event_fanout, ALL_EVENTS);
+	fanout_done = false;
+
+	for (i = 0; i < FANOUT_WAITERS; i++) {
+		k_thread_create(&fanout_thread[i], fanout_stack[i],
+				K_THREAD_STACK_SIZEOF(fanout_stack[i]),
+				fanout_waiter_entry,
+				(void *)(uintptr_t)BIT(i + 1), NULL, NULL,
+				priority - 1, 0, K_NO_WAIT);
+	}
+
+	k_thread_create(&start_thread, start_stack,
+			K_THREAD_STACK_SIZEOF(start_stack),
+			fanout_start_entry,
+			(void *)(uintptr_t)num_iterations,
+			NULL, NULL,
+			priority - 1, 0, K_FOREVER);
+
+	k_thread_create(&alt_thread, alt_stack,
+			K_THREAD_STACK_SIZEOF(alt_stack),
+			fanout_alt_entry,
+			(void *)(uintptr_t)num_iterations,
+			NULL, NULL,
+			priority - 2, 0, K_FOREVER);
+
+	k_thread_start(&start_thread);
+
+	/* 4. Benchmark thread has paused */
+
+	snprintf(tag, sizeof(tag), "events.post.fanout.immediate.kernel");
+	snprintf(description, sizeof(description),
+		 "%-40s - Post+clear events (%d waiters, nothing wakes)",
+		 tag, FANOUT_WAITERS);
+	cycles = timestamp.cycles;
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	k_sem_give(&pause_sem);
+
+	k_thread_join(&start_thread, K_FOREVER);
+
+	/* 8. Benchmark threads have finished */
+
+	snprintf(tag, sizeof(tag), "events.post.fanout.wake+ctx.k_to_k");
+	snprintf(description, sizeof(description),
+		 "%-40s - Post events to 1 of %d waiters (w/ ctx switch)",
+		 tag, FANOUT_WAITERS + 1);
+	cycles = timestamp.cycles - timestamp_overhead_adjustment(0, 0);
+	PRINT_STATS_AVG(description, (uint32_t)cycles,
+			num_iterations, false, "");
+
+	/* 9. Release the other waiters */
+
+	fanout_done = true;
+	k_event_post(&event_fanout, ALL_EVENTS & ~BIT(0));
+
+	for (i = 0; i < FANOUT_WAITERS; i++) {
+		k_thread_join(&fanout_thread[i], K_FOREVER);
+	}
+
+	timing_stop();
+
+	return 0;
+}
+#endif /* CONFIG_BENCHMARK_EVENT_FANOUT */
@@ -61,6 +61,7 @@ extern int lifo_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 extern int event_ops(uint32_t num_iterations, uint32_t options);
 extern int event_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 			      uint32_t alt_options);
+extern int event_fanout_ops(uint32_t num_iterations);
 extern int condvar_blocking_ops(uint32_t num_iterations, uint32_t start_options,
 				uint32_t alt_options);
 extern int stack_ops(uint32_t num_iterations, uint32_t options);
@@ -72,6 +73,9 @@ extern void heap_malloc_free(void);
 static void busy_thread_entry(void *arg1, void *arg2, void *arg3)
 {
 	while (1) {
+		if (IS_ENABLED(CONFIG_BENCHMARK_BUSY_THREADS_YIELD)) {
+			k_yield();
+		}
 	}
 }
 #endif
@@ -108,6 +112,12 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 
 	TC_START("Time Measurement");
 	TC_PRINT("Timing results: Clock frequency: %u MHz\n", freq);
+#if (CONFIG_MP_MAX_NUM_CPUS > 1)
+	TC_PRINT("CPUs: %u (%s run queues%s)\n", arch_num_cpus(),
+		 IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "per-CPU" : "shared",
+		 IS_ENABLED(CONFIG_BENCHMARK_BUSY_THREADS_YIELD) ?
+		 ", other CPUs yielding" : "");
+#endif
 
 	timestamp_overhead_init(CONFIG_BENCHMARK_NUM_ITERATIONS);
 
@@ -165,6 +175,10 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	event_blocking_ops(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER, K_USER);
 #endif
 
+#ifdef CONFIG_BENCHMARK_EVENT_FANOUT
+	event_fanout_ops(CONFIG_BENCHMARK_NUM_ITERATIONS);
+#endif
+
 	sema_test_signal(CONFIG_BENCHMARK_NUM_ITERATIONS, 0);
 #ifdef CONFIG_USERSPACE
 	sema_test_signal(CONFIG_BENCHMARK_NUM_ITERATIONS, K_USER);
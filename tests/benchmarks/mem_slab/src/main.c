@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring the number of block
+ * allocations and frees per second on a memory slab shared by several
+ * threads.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS CONFIG_BENCHMARK_NUM_THREADS
+#define BLOCKS_HELD CONFIG_BENCHMARK_BLOCKS_HELD
+#define BLOCK_SIZE 32
+#define NUM_BLOCKS (NUM_THREADS * BLOCKS_HELD)
+
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, BLOCK_SIZE, NUM_BLOCKS, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static K_SEM_DEFINE(start_sem, 0, NUM_THREADS);
+static K_SEM_DEFINE(done_sem, 0, NUM_THREADS);
+
+static atomic_t failures;
+
+static void bench_thread(void *p1, void *p2, void *p3)
+{
+	void *held[BLOCKS_HELD] = { NULL };
+	unsigned int slot = 0;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_OPS; i++) {
+		if (held[slot] != NULL) {
+			k_mem_slab_free(&bench_slab, held[slot]);
+		}
+		if (k_mem_slab_alloc(&bench_slab, &held[slot], K_NO_WAIT) != 0) {
+			held[slot] = NULL;
+			atomic_inc(&failures);
+		}
+		slot = (slot + 1U) % BLOCKS_HELD;
+	}
+
+	for (slot = 0; slot < BLOCKS_HELD; slot++) {
+		if (held[slot] != NULL) {
+			k_mem_slab_free(&bench_slab, held[slot]);
+		}
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void measure(unsigned int num_threads, const char *name)
+{
+	uint64_t total = (uint64_t)num_threads * CONFIG_BENCHMARK_NUM_OPS;
+	timing_t start;
+	timing_t finish;
+	uint64_t ns;
+	unsigned int i;
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, bench_thread,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		if (arch_num_cpus() > 1U) {
+			(void)k_thread_cpu_pin(&threads[i], i % arch_num_cpus());
+		}
+		k_thread_start(&threads[i]);
+	}
+
+	/* Let all threads block on the start semaphore */
+	k_sleep(K_MSEC(10));
+
+	start = timing_counter_get();
+
+	for (i = 0; i < num_threads; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (i = 0; i < num_threads; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	for (i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+	printk("    %-28s: %10llu ns, %8llu allocs/s\n", name, ns,
+	       (ns != 0U) ? (total * NSEC_PER_SEC) / ns : 0U);
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	timing_init();
+
+	printk("Memory slab throughput: %u CPUs, %s free list\n",
+	       arch_num_cpus(),
+	       IS_ENABLED(CONFIG_MEM_SLAB_LOCK_FREE) ? "lock-free" : "locked");
+	printk("%u threads, %u allocs each, %u blocks held\n", NUM_THREADS,
+	       CONFIG_BENCHMARK_NUM_OPS, BLOCKS_HELD);
+
+	timing_start();
+
+	measure(1, "Single thread");
+	measure(NUM_THREADS, "Contending threads");
+	printk("------------------------------------\n");
+
+	timing_stop();
+
+	if ((atomic_get(&failures) != 0) ||
+	    (k_mem_slab_num_used_get(&bench_slab) != 0U)) {
+		printk("Slab accounting mismatch: %ld failed allocs, %u used\n",
+		       (long)atomic_get(&failures),
+		       k_mem_slab_num_used_get(&bench_slab));
+		status = TC_FAIL;
+	}
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
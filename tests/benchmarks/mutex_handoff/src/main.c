@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring the time needed to lock a
+ * mutex handed back and forth between threads running on different CPUs.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_THREADS CONFIG_BENCHMARK_NUM_THREADS
+#define NUM_OPS CONFIG_BENCHMARK_NUM_OPS
+
+static K_MUTEX_DEFINE(bench_mutex);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static K_SEM_DEFINE(start_sem, 0, NUM_THREADS);
+static K_SEM_DEFINE(done_sem, 0, NUM_THREADS);
+
+static uint64_t lock_cycles[NUM_THREADS];
+static uint64_t max_lock_cycles[NUM_THREADS];
+
+static uint32_t shared_count;
+
+static void bench_thread(void *p1, void *p2, void *p3)
+{
+	unsigned int id = POINTER_TO_UINT(p1);
+	timing_t start;
+	timing_t finish;
+	uint64_t cycles;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	for (unsigned int i = 0; i < NUM_OPS; i++) {
+		start = timing_counter_get();
+		k_mutex_lock(&bench_mutex, K_FOREVER);
+		finish = timing_counter_get();
+
+		shared_count++;
+		k_busy_wait(CONFIG_BENCHMARK_HOLD_US);
+
+		k_mutex_unlock(&bench_mutex);
+
+		cycles = timing_cycles_get(&start, &finish);
+		lock_cycles[id] += cycles;
+		max_lock_cycles[id] = MAX(max_lock_cycles[id], cycles);
+
+		k_busy_wait(CONFIG_BENCHMARK_HOLD_US);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+int main(void)
+{
+	uint64_t total = (uint64_t)NUM_THREADS * NUM_OPS;
+	uint64_t cycles = 0;
+	uint64_t max_cycles = 0;
+	int status = TC_PASS;
+	timing_t start;
+	timing_t finish;
+	uint64_t ns;
+	unsigned int i;
+
+	timing_init();
+
+	printk("Mutex handoff: %u CPUs, %s\n", arch_num_cpus(),
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "adaptive spin" : "pend at once");
+	printk("%u threads, %u locks each, %u us held\n", NUM_THREADS, NUM_OPS,
+	       CONFIG_BENCHMARK_HOLD_US);
+
+	timing_start();
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, bench_thread,
+				UINT_TO_POINTER(i), NULL, NULL, K_PRIO_PREEMPT(1),
+				0, K_FOREVER);
+		(void)k_thread_cpu_pin(&threads[i], i % arch_num_cpus());
+		k_thread_start(&threads[i]);
+	}
+
+	/* Let all threads block on the start semaphore */
+	k_sleep(K_MSEC(10));
+
+	start = timing_counter_get();
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		cycles += lock_cycles[i];
+		max_cycles = MAX(max_cycles, max_lock_cycles[i]);
+	}
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+	printk("    %-28s: %10llu ns, %8llu locks/s\n", "Total", ns,
+	       (ns != 0U) ? (total * NSEC_PER_SEC) / ns : 0U);
+	printk("    %-28s: %10llu ns\n", "Average k_mutex_lock()",
+	       timing_cycles_to_ns_avg(cycles, total));
+	printk("    %-28s: %10llu ns\n", "Maximum k_mutex_lock()",
+	       timing_cycles_to_ns(max_cycles));
+	printk("------------------------------------\n");
+
+	timing_stop();
+
+	if (shared_count != total) {
+		printk("Mutual exclusion broken: %u of %llu increments\n",
+		       shared_count, total);
+		status = TC_FAIL;
+	}
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file measures the rate at which received UDP packets are delivered
+ * to their connection handler, for an increasing number of registered
+ * handlers. The handlers share the local port and each one is connected to
+ * a different remote port, as the sockets of a server would be, and the
+ * packets are sent to all of them in turn.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/udp.h>
+
+#include "ipv6.h"
+#include "udp_internal.h"
+
+#define NUM_PACKETS  2000
+#define MAX_HANDLERS 128
+#define LOCAL_PORT   4242
+#define REMOTE_PORT  10000
+
+BUILD_ASSERT(CONFIG_NET_MAX_CONN > MAX_HANDLERS,
+	     "The handlers and the listener need a connection each");
+
+static const unsigned int num_handlers[] = { 1, 4, 16, 64, MAX_HANDLERS };
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_conn_handle *handles[MAX_HANDLERS];
+static struct net_conn_handle *listener;
+static unsigned int received;
+static unsigned int misdelivered;
+
+static uint8_t mac_addr[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+static void bench_iface_init(struct net_if *iface)
+{
+	net_if_set_link_addr(iface, mac_addr, sizeof(mac_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int bench_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static struct dummy_api bench_if_api = {
+	.iface_api.init = bench_iface_init,
+	.send = bench_send,
+};
+
+NET_DEVICE_INIT(net_conn_demux_bench, "net_conn_demux_bench", NULL, NULL,
+		NULL, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&bench_if_api, DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static enum net_verdict bench_recv(struct net_conn *conn,
+				   struct net_pkt *pkt,
+				   union net_ip_header *ip_hdr,
+				   union net_proto_header *proto_hdr,
+				   void *user_data)
+{
+	uint16_t expected = POINTER_TO_UINT(user_data);
+
+	if (expected != ntohs(proto_hdr->udp->src_port)) {
+		misdelivered++;
+	}
+
+	received++;
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static int register_handlers(unsigned int count)
+{
+	struct sockaddr_in6 local = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = my_addr,
+	};
+	struct sockaddr_in6 remote = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = peer_addr,
+	};
+	int ret;
+
+	ret = net_udp_register(AF_INET6, NULL, (struct sockaddr *)&local,
+			       0, LOCAL_PORT, NULL, bench_recv, NULL,
+			       &listener);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (unsigned int i = 0; i < count; i++) {
+		ret = net_udp_register(AF_INET6, (struct sockaddr *)&remote,
+				       (struct sockaddr *)&local,
+				       REMOTE_PORT + i, LOCAL_PORT, NULL,
+				       bench_recv, UINT_TO_POINTER(REMOTE_PORT + i),
+				       &handles[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void unregister_handlers(unsigned int count)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		if (handles[i] != NULL) {
+			(void)net_udp_unregister(handles[i]);
+			handles[i] = NULL;
+		}
+	}
+
+	if (listener != NULL) {
+		(void)net_udp_unregister(listener);
+		listener = NULL;
+	}
+}
+
+static struct net_pkt *build_packet(struct net_if *iface, uint16_t src_port)
+{
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, 0, AF_INET6, IPPROTO_UDP,
+					K_FOREVER);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_ipv6_create(pkt, &peer_addr, &my_addr) ||
+	    net_udp_create(pkt, htons(src_port), htons(LOCAL_PORT))) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_ipv6_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+static int run(struct net_if *iface, unsigned int count)
+{
+	uint64_t cycles = 0U;
+	uint64_t ns;
+	timing_t start;
+	timing_t finish;
+	struct net_pkt *pkt;
+	int ret;
+
+	ret = register_handlers(count);
+	if (ret < 0) {
+		printk("Cannot register %u handlers (%d)\n", count, ret);
+		unregister_handlers(count);
+		return ret;
+	}
+
+	received = 0U;
+	misdelivered = 0U;
+
+	for (unsigned int i = 0; i < NUM_PACKETS; i++) {
+		pkt = build_packet(iface, REMOTE_PORT + (i % count));
+		if (pkt == NULL) {
+			printk("Cannot build packet\n");
+			ret = -ENOMEM;
+			break;
+		}
+
+		start = timing_counter_get();
+		ret = net_recv_data(iface, pkt);
+		finish = timing_counter_get();
+
+		if (ret < 0) {
+			printk("Cannot receive packet (%d)\n", ret);
+			net_pkt_unref(pkt);
+			break;
+		}
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	unregister_handlers(count);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (received != NUM_PACKETS || misdelivered != 0U) {
+		printk("%u handlers: %u packets received, %u misdelivered\n",
+		       count, received, misdelivered);
+		return -EIO;
+	}
+
+	ns = timing_cycles_to_ns_avg(cycles, NUM_PACKETS);
+
+	printk("%4u handlers: %7llu packets/s (%6llu ns per packet)\n",
+	       count, ns != 0U ? NSEC_PER_SEC / ns : 0U, ns);
+
+	return 0;
+}
+
+int main(void)
+{
+	struct net_if *iface;
+	int ret = 0;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (iface == NULL ||
+	    net_if_ipv6_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0) == NULL) {
+		printk("Cannot set up the network interface\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("UDP receive rate, %d hash buckets\n",
+	       CONFIG_NET_CONN_HASH_BUCKETS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(num_handlers); i++) {
+		ret = run(iface, num_handlers[i]);
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -17,6 +17,10 @@
 
 #define TEST_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
 #define BUSY_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define YIELD_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Two threads yielding to each other on every CPU */
+#define NUM_YIELD_THREADS (2 * CONFIG_MP_MAX_NUM_CPUS)
 
 uint32_t tm_off;
 
@@ -38,6 +42,11 @@ static struct k_thread test_thread[CONFIG_BENCHMARK_NUM_THREADS];
 static uint64_t add_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 static uint64_t remove_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 
+K_THREAD_STACK_ARRAY_DEFINE(yield_stack, NUM_YIELD_THREADS, YIELD_STACK_SIZE);
+static struct k_thread yield_thread[NUM_YIELD_THREADS];
+static uint64_t yield_cycles[NUM_YIELD_THREADS];
+static K_SEM_DEFINE(yield_done, 0, NUM_YIELD_THREADS);
+
 extern void z_unready_thread(struct k_thread *thread);
 
 static void busy_entry(void *p1, void *p2, void *p3)
@@ -65,6 +74,58 @@ static void test_entry(void *p1, void *p2, void *p3)
 	}
 }
 
+static void yield_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = (unsigned int)(uintptr_t)p1;
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_yield();
+	}
+	finish = timing_counter_get();
+
+	yield_cycles[id] = timing_cycles_get(&start, &finish);
+
+	k_sem_give(&yield_done);
+}
+
+/*
+ * Measure k_yield() context switches while every CPU is doing the same,
+ * so that the cost of sharing scheduler state between CPUs shows up.
+ * Each pair of threads alternates on one CPU: a thread's loop spans two
+ * context switches per iteration.
+ */
+static void test_ctx_switch_all_cpus(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < NUM_YIELD_THREADS; i++) {
+		k_thread_create(&yield_thread[i], yield_stack[i], YIELD_STACK_SIZE,
+				yield_entry, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_pin(&yield_thread[i], i / 2);
+#endif
+	}
+
+	for (i = 0; i < NUM_YIELD_THREADS; i++) {
+		k_thread_start(&yield_thread[i]);
+	}
+
+	for (i = 0; i < NUM_YIELD_THREADS; i++) {
+		k_sem_take(&yield_done, K_FOREVER);
+	}
+
+	for (i = 0; i < NUM_YIELD_THREADS; i++) {
+		k_thread_join(&yield_thread[i], K_FOREVER);
+	}
+}
+
 static void start_threads(unsigned int num_threads)
 {
 	unsigned int i;
@@ -206,8 +267,8 @@ int main(void)
 {
 	unsigned int i;
 	unsigned int freq;
-#ifdef CONFIG_BENCHMARK_VERBOSE
 	char description[120];
+#ifdef CONFIG_BENCHMARK_VERBOSE
 	char tag[50];
 	struct k_thread *thread;
 #endif
@@ -218,15 +279,27 @@ int main(void)
 
 	freq = timing_freq_get_mhz();
 
-	printk("Time Measurements for %s sched queues\n",
+	printk("Time Measurements for %s%s sched queues\n",
 	       IS_ENABLED(CONFIG_SCHED_DUMB) ? "dumb" :
-	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
+	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq",
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? " per-CPU" : "");
 	printk("Timing results: Clock frequency: %u MHz\n", freq);
 
-	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
-
 	timing_start();
 
+	test_ctx_switch_all_cpus();
+
+	snprintf(description, sizeof(description),
+		 "Context switch (k_yield) with %u CPUs switching",
+		 arch_num_cpus());
+	compute_and_report_stats(NUM_YIELD_THREADS,
+				 2 * CONFIG_BENCHMARK_NUM_ITERATIONS,
+				 yield_cycles, description);
+
+	printk("------------------------------------\n");
+
+	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
+
 	cycles_reset(CONFIG_BENCHMARK_NUM_THREADS);
 
 	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
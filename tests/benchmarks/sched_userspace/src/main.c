@@ -6,6 +6,9 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
+#include <zephyr/sys/rwlock.h>
 
 /* private kernel APIs */
 #include <wait_q.h>
@@ -116,6 +119,143 @@ static int exec_test(uint8_t nb_threads)
 	return yielder_status;
 }
 
+K_SEM_DEFINE(bench_sem, 0, 1);
+
+/* Uncontended user mode locks, reachable by the first app thread */
+static K_APP_BMEM(app_1_partition) SYS_MUTEX_DEFINE(bench_mutex);
+static K_APP_BMEM(app_1_partition) SYS_CONDVAR_DEFINE(bench_condvar);
+static K_APP_BMEM(app_1_partition) SYS_RWLOCK_DEFINE(bench_rwlock);
+
+static void locker_entry(void *_thread, void *_fn, void *obj)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	k_thread_entry_t fn = (k_thread_entry_t)_fn;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+
+	k_thread_user_mode_enter(fn, obj, NULL, NULL);
+}
+
+/* Time <fn> on <obj> from a user thread, which makes <rounds> calls */
+static int exec_user_test(const char *name, k_thread_entry_t fn, void *obj,
+			  uint32_t rounds)
+{
+	k_tid_t tid;
+
+	yielder_status = 0;
+
+	app_threads[0].partition = app_partitions[0];
+	app_threads[0].stack = &app_thread_stacks[0];
+
+	tid = k_thread_create(&app_threads[0].thread, app_thread_stacks[0],
+			      APP_STACKSIZE, locker_entry, &app_threads[0],
+			      (void *)fn, obj, THREADS_PRIO, 0, K_FOREVER);
+	/* No-op unless obj is a kernel object */
+	k_object_access_grant(obj, tid);
+
+	stamp(MEAS_START);
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / rounds;
+
+	printk("%-24s: %8" PRIu32 " cyc & %6" PRIu32 " calls -> %6" PRIu64
+	       " ns per call\n", name, full_time, rounds, time_ns);
+
+	return yielder_status;
+}
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+#define MAX_NB_DYN_OBJECTS 512
+
+static struct k_sem *dyn_sems[MAX_NB_DYN_OBJECTS];
+static size_t nb_dyn_sems;
+
+static void syscaller_entry(void *_thread, void *_sem, void *p3)
+{
+	struct k_app_thread *thread = (struct k_app_thread *) _thread;
+	int ret;
+
+	struct k_mem_partition *parts[] = {
+		thread->partition,
+	};
+
+	ret = k_mem_domain_init(&thread->domain, ARRAY_SIZE(parts), parts);
+	if (ret != 0) {
+		printk("k_mem_domain_init failed %d\n", ret);
+		yielder_status = 1;
+		return;
+	}
+
+	k_mem_domain_add_thread(&thread->domain, k_current_get());
+
+	k_thread_user_mode_enter(syscall_object_lookup, _sem, NULL, NULL);
+}
+
+/* Time a syscall on a dynamic object while nb_objects are allocated.
+ * The object used is the most recently allocated one.
+ */
+static int exec_syscall_test(size_t nb_objects)
+{
+	struct k_sem *sem;
+	k_tid_t tid;
+
+	if (nb_objects > MAX_NB_DYN_OBJECTS) {
+		printk("Too many objects\n");
+		return 1;
+	}
+
+	while (nb_dyn_sems < nb_objects) {
+		sem = k_object_alloc(K_OBJ_SEM);
+		if (sem == NULL) {
+			printk("k_object_alloc failed after %zu objects\n",
+			       nb_dyn_sems);
+			return 1;
+		}
+		k_sem_init(sem, 0, 1);
+		dyn_sems[nb_dyn_sems++] = sem;
+	}
+
+	yielder_status = 0;
+	sem = dyn_sems[nb_objects - 1];
+
+	app_threads[0].partition = app_partitions[0];
+	app_threads[0].stack = &app_thread_stacks[0];
+
+	tid = k_thread_create(&app_threads[0].thread, app_thread_stacks[0],
+			      APP_STACKSIZE, syscaller_entry, &app_threads[0],
+			      sem, NULL, THREADS_PRIO, 0, K_FOREVER);
+	k_object_access_grant(sem, tid);
+
+	stamp(MEAS_START);
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+	stamp(MEAS_END);
+
+	uint32_t full_time = stamps[MEAS_END] - stamps[MEAS_START];
+	uint64_t time_ns = k_cyc_to_ns_near64(full_time) / NB_SYSCALLS;
+
+	printk("Syscall with %4zu dynamic objects: %8" PRIu32 " cyc & %6" PRIu32
+	       " calls -> %6" PRIu64 " ns per call\n", nb_objects, full_time,
+	       NB_SYSCALLS, time_ns);
+
+	return yielder_status;
+}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
 
 int main(void)
 {
@@ -136,6 +276,58 @@ int main(void)
 		}
 	}
 
+	printk("============================\n");
+	printk("user uncontended locks%s\n",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) ? " (fast path)" : "");
+
+	ret = exec_user_test("sys_mutex lock/unlock", sys_mutex_lock_unlock,
+			     &bench_mutex, NB_LOCKS);
+	if (ret == 0) {
+		ret = exec_user_test("sys_condvar signal",
+				     sys_condvar_signal_idle, &bench_condvar,
+				     NB_LOCKS);
+	}
+	if (ret == 0) {
+		ret = exec_user_test("sys_rwlock rdlock/unlock",
+				     sys_rwlock_read_unlock, &bench_rwlock,
+				     NB_LOCKS);
+	}
+	if (ret != 0) {
+		printk("FAIL\n");
+		return 0;
+	}
+
+	printk("============================\n");
+	printk("user k_sem_give, one by one and in batches of %u\n",
+	       SYSCALL_BATCH_SIZE);
+
+	ret = exec_user_test("k_sem_give", syscall_sem_give, &bench_sem,
+			     NB_SYSCALLS);
+	if (ret == 0) {
+		ret = exec_user_test("k_sem_give batched",
+				     syscall_batch_sem_give, &bench_sem,
+				     NB_SYSCALLS);
+	}
+	if (ret != 0) {
+		printk("FAIL\n");
+		return 0;
+	}
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	size_t nb_objects_list[] = {1, 16, 64, 256, 512, 0};
+
+	printk("============================\n");
+	printk("user syscall on a dynamic object\n");
+
+	for (size_t i = 0; nb_objects_list[i] > 0; i++) {
+		ret = exec_syscall_test(nb_objects_list[i]);
+		if (ret != 0) {
+			printk("FAIL\n");
+			return 0;
+		}
+	}
+#endif /* CONFIG_DYNAMIC_OBJECTS */
+
 	printk("SUCCESS\n");
 	return 0;
 }
@@ -7,6 +7,10 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
+#include <zephyr/sys/rwlock.h>
+#include <zephyr/sys/syscall_batch.h>
 
 #include "user.h"
 
@@ -19,3 +23,72 @@ void context_switch_yield(void *p1, void *p2, void *p3)
 		k_yield();
 	}
 }
+
+void syscall_object_lookup(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+	uint32_t rounds = NB_SYSCALLS;
+
+	/* The handler does next to nothing beyond validating sem */
+	while (rounds--) {
+		(void)k_sem_count_get(sem);
+	}
+}
+
+void syscall_sem_give(void *p1, void *p2, void *p3)
+{
+	struct k_sem *sem = p1;
+	uint32_t rounds = NB_SYSCALLS;
+
+	while (rounds--) {
+		k_sem_give(sem);
+	}
+}
+
+void syscall_batch_sem_give(void *p1, void *p2, void *p3)
+{
+	struct k_syscall_batch_entry batch[SYSCALL_BATCH_SIZE];
+	uint32_t rounds = NB_SYSCALLS / SYSCALL_BATCH_SIZE;
+
+	for (size_t i = 0; i < SYSCALL_BATCH_SIZE; i++) {
+		batch[i] = (struct k_syscall_batch_entry)
+			K_SYSCALL_BATCH_ENTRY(K_SYSCALL_K_SEM_GIVE, (uintptr_t)p1);
+	}
+
+	while (rounds--) {
+		(void)k_syscall_batch(batch, SYSCALL_BATCH_SIZE);
+	}
+}
+
+void sys_mutex_lock_unlock(void *p1, void *p2, void *p3)
+{
+	struct sys_mutex *mutex = p1;
+	uint32_t rounds = NB_LOCKS;
+
+	while (rounds--) {
+		(void)sys_mutex_lock(mutex, K_FOREVER);
+		(void)sys_mutex_unlock(mutex);
+	}
+}
+
+void sys_condvar_signal_idle(void *p1, void *p2, void *p3)
+{
+	struct sys_condvar *condvar = p1;
+	uint32_t rounds = NB_LOCKS;
+
+	/* Nobody waits on condvar */
+	while (rounds--) {
+		(void)sys_condvar_signal(condvar);
+	}
+}
+
+void sys_rwlock_read_unlock(void *p1, void *p2, void *p3)
+{
+	struct sys_rwlock *rwlock = p1;
+	uint32_t rounds = NB_LOCKS;
+
+	while (rounds--) {
+		(void)sys_rwlock_rdlock(rwlock, K_FOREVER);
+		(void)sys_rwlock_unlock(rwlock);
+	}
+}
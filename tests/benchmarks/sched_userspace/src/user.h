@@ -5,5 +5,14 @@
  */
 
 #define NB_YIELDS UINT32_C(1000000)
+#define NB_SYSCALLS UINT32_C(100000)
+#define NB_LOCKS UINT32_C(100000)
+#define SYSCALL_BATCH_SIZE 8
 
 void context_switch_yield(void *p1, void *p2, void *p3);
+void syscall_object_lookup(void *p1, void *p2, void *p3);
+void syscall_sem_give(void *p1, void *p2, void *p3);
+void syscall_batch_sem_give(void *p1, void *p2, void *p3);
+void sys_mutex_lock_unlock(void *p1, void *p2, void *p3);
+void sys_condvar_signal_idle(void *p1, void *p2, void *p3);
+void sys_rwlock_read_unlock(void *p1, void *p2, void *p3);
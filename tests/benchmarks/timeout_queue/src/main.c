@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to
+ * arm and cancel a kernel timeout while a varying number of other timeouts
+ * are pending. The timeouts are driven directly through z_add_timeout() and
+ * z_abort_timeout() so that no thread or timer object bookkeeping is
+ * included in the measurements.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <timeout_q.h>
+
+static struct _timeout background[CONFIG_BENCHMARK_MAX_TIMEOUTS];
+static struct _timeout probe[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static uint32_t seed = 0x2545F491;
+
+static k_ticks_t random_ticks(void)
+{
+	/* Simple LCG, reproducible across runs and backends */
+	seed = (seed * 1103515245U) + 12345U;
+
+	return 1 + ((seed >> 8) % CONFIG_BENCHMARK_TIMEOUT_SPAN);
+}
+
+static void timeout_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void background_fill(unsigned int from, unsigned int to)
+{
+	for (unsigned int i = from; i < to; i++) {
+		z_add_timeout(&background[i], timeout_handler,
+			      K_TICKS(random_ticks()));
+	}
+}
+
+static void background_flush(unsigned int num_timeouts)
+{
+	for (unsigned int i = 0; i < num_timeouts; i++) {
+		(void)z_abort_timeout(&background[i]);
+	}
+}
+
+static void measure(unsigned int num_timeouts)
+{
+	uint64_t add_cycles = 0;
+	uint64_t abort_cycles = 0;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+
+	/* Arm all probes first so that each one sees a slightly different
+	 * queue, then cancel them in arming order.
+	 */
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		k_timeout_t timeout = K_TICKS(random_ticks());
+
+		start = timing_counter_get();
+		z_add_timeout(&probe[i], timeout_handler, timeout);
+		finish = timing_counter_get();
+
+		add_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		(void)z_abort_timeout(&probe[i]);
+		finish = timing_counter_get();
+
+		abort_cycles += timing_cycles_get(&start, &finish);
+	}
+
+	add_cycles /= CONFIG_BENCHMARK_NUM_ITERATIONS;
+	abort_cycles /= CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+	printk("%6u pending timeouts\n", num_timeouts);
+	printk("    Arm    : %7llu cycles (%7u nsec)\n",
+	       add_cycles, (uint32_t)timing_cycles_to_ns(add_cycles));
+	printk("    Cancel : %7llu cycles (%7u nsec)\n",
+	       abort_cycles, (uint32_t)timing_cycles_to_ns(abort_cycles));
+}
+
+int main(void)
+{
+	unsigned int num_timeouts = 0;
+	unsigned int next = 10;
+
+	timing_init();
+
+	printk("Time Measurements for %s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dumb");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(probe); i++) {
+		z_init_timeout(&probe[i]);
+	}
+
+	for (unsigned int i = 0; i < ARRAY_SIZE(background); i++) {
+		z_init_timeout(&background[i]);
+	}
+
+	timing_start();
+
+	while (num_timeouts < CONFIG_BENCHMARK_MAX_TIMEOUTS) {
+		next = MIN(next, CONFIG_BENCHMARK_MAX_TIMEOUTS);
+
+		background_fill(num_timeouts, next);
+		num_timeouts = next;
+
+		measure(num_timeouts);
+		printk("------------------------------------\n");
+
+		next *= 10;
+	}
+
+	background_flush(num_timeouts);
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
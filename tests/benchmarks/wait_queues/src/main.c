@@ -15,6 +15,9 @@
  * reduce the memory footprint as not only are thread stacks not required,
  * but we also do not need the full k_thread structure for each of these
  * dummy threads.
+ *
+ * It also measures the time required to wake up all the threads waiting
+ * on a condition variable, for a varying number of real waiting threads.
  */
 
 #include <zephyr/kernel.h>
@@ -34,6 +37,17 @@ static _wait_q_t wait_q;
 uint64_t add_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 uint64_t remove_cycles[CONFIG_BENCHMARK_NUM_THREADS];
 
+#define NUM_WAITERS CONFIG_BENCHMARK_NUM_BROADCAST_WAITERS
+#define WAITER_STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS,
+				   WAITER_STACK_SIZE);
+static struct k_thread waiter_threads[NUM_WAITERS];
+
+static K_MUTEX_DEFINE(broadcast_mutex);
+static K_CONDVAR_DEFINE(broadcast_condvar);
+static K_SEM_DEFINE(waiting_sem, 0, NUM_WAITERS);
+
 /**
  * Initialize each dummy thread.
  */
@@ -125,6 +139,70 @@ static void test_increasing_priority(_wait_q_t *q, unsigned int num_threads)
 	}
 }
 
+/**
+ * Each waiter signals that it is about to wait while holding the mutex,
+ * which k_condvar_wait() only releases once the waiter is pended. So by
+ * the time the main thread gets the mutex, every waiter is pended.
+ */
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&broadcast_mutex, K_FOREVER);
+
+	while (true) {
+		k_sem_give(&waiting_sem);
+		k_condvar_wait(&broadcast_condvar, &broadcast_mutex, K_FOREVER);
+	}
+}
+
+/**
+ * Start waiters until <num_waiters> are waiting. They are spread over
+ * all preemptible priorities below that of the main thread, so that the
+ * broadcast does not switch to any of them.
+ */
+static void waiters_start(unsigned int first, unsigned int num_waiters)
+{
+	unsigned int i;
+	int prio;
+
+	for (i = first; i < num_waiters; i++) {
+		prio = 1 + (int)(i % (CONFIG_NUM_PREEMPT_PRIORITIES - 1));
+		k_thread_create(&waiter_threads[i], waiter_stacks[i],
+				WAITER_STACK_SIZE, waiter_entry,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(prio), 0,
+				K_NO_WAIT);
+	}
+}
+
+static uint64_t test_broadcast(unsigned int num_waiters)
+{
+	uint64_t cycles = 0ULL;
+	timing_t start;
+	timing_t finish;
+	unsigned int i;
+	unsigned int j;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_BROADCAST_ITERATIONS; i++) {
+		for (j = 0; j < num_waiters; j++) {
+			k_sem_take(&waiting_sem, K_FOREVER);
+		}
+		k_mutex_lock(&broadcast_mutex, K_FOREVER);
+
+		start = timing_counter_get();
+		k_condvar_broadcast(&broadcast_condvar);
+		finish = timing_counter_get();
+
+		k_mutex_unlock(&broadcast_mutex);
+
+		cycles += timing_cycles_get(&start, &finish);
+	}
+
+	return cycles;
+}
+
 
 static uint64_t sqrt_u64(uint64_t square)
 {
@@ -197,9 +275,9 @@ int main(void)
 {
 	unsigned int i;
 	unsigned int freq;
+	char tag[50];
 #ifdef CONFIG_BENCHMARK_VERBOSE
 	char description[120];
-	char tag[50];
 	struct k_thread *thread;
 #endif
 
@@ -311,6 +389,21 @@ int main(void)
 	}
 #endif
 
+	printk("------------------------------------\n");
+
+	printk("Wake all threads waiting on a condition variable\n");
+
+	for (i = 1; i <= NUM_WAITERS; i *= 2) {
+		uint64_t cycles;
+
+		waiters_start(i / 2, i);
+		cycles = test_broadcast(i);
+
+		snprintf(tag, sizeof(tag), "WaitQ.broadcast.%04u.waiters", i);
+		PRINT_STATS_AVG(tag, (uint32_t)cycles,
+				CONFIG_BENCHMARK_NUM_BROADCAST_ITERATIONS);
+	}
+
 	timing_stop();
 
 	TC_END_REPORT(0);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark measuring the number of work items per
+ * second processed by a work queue served by a single thread, and by the
+ * same kind of queue served by additional worker threads.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORK_PRIORITY K_PRIO_PREEMPT(1)
+#define MAX_WORKERS MAX(1, CONFIG_MP_MAX_NUM_CPUS - 1)
+
+struct bench_item {
+	struct k_work work;
+	struct k_work_q *queue;
+	uint32_t runs;
+};
+
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(multi_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, MAX_WORKERS, STACK_SIZE);
+
+static struct k_work_q single_q;
+static struct k_work_q multi_q;
+static struct k_work_q_worker workers[MAX_WORKERS];
+
+static struct bench_item items[CONFIG_BENCHMARK_NUM_ITEMS];
+static K_SEM_DEFINE(done_sem, 0, CONFIG_BENCHMARK_NUM_ITEMS);
+
+static uint32_t work_load_us;
+
+static void bench_handler(struct k_work *work)
+{
+	struct bench_item *item = CONTAINER_OF(work, struct bench_item, work);
+
+	if (work_load_us != 0U) {
+		k_busy_wait(work_load_us);
+	}
+
+	if (++item->runs < CONFIG_BENCHMARK_NUM_RUNS) {
+		(void)k_work_submit_to_queue(item->queue, work);
+	} else {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void measure(struct k_work_q *queue, const char *name)
+{
+	uint64_t total = (uint64_t)CONFIG_BENCHMARK_NUM_ITEMS *
+			 CONFIG_BENCHMARK_NUM_RUNS;
+	timing_t start;
+	timing_t finish;
+	uint64_t ns;
+	unsigned int i;
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+		k_work_init(&items[i].work, bench_handler);
+		items[i].queue = queue;
+		items[i].runs = 0;
+	}
+
+	start = timing_counter_get();
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+		(void)k_work_submit_to_queue(queue, &items[i].work);
+	}
+
+	for (i = 0; i < CONFIG_BENCHMARK_NUM_ITEMS; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	finish = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+	printk("    %-28s: %10llu ns, %8llu items/s\n", name, ns,
+	       (ns != 0U) ? (total * NSEC_PER_SEC) / ns : 0U);
+}
+
+int main(void)
+{
+	unsigned int num_workers = MAX(1U, arch_num_cpus() - 1U);
+	int cpu;
+
+	timing_init();
+
+	printk("Work queue throughput: %u CPUs, %u workers\n",
+	       arch_num_cpus(), num_workers + 1U);
+	printk("%u items, %u runs each\n", CONFIG_BENCHMARK_NUM_ITEMS,
+	       CONFIG_BENCHMARK_NUM_RUNS);
+
+	k_work_queue_start(&single_q, single_stack,
+			   K_THREAD_STACK_SIZEOF(single_stack),
+			   WORK_PRIORITY, NULL);
+	k_work_queue_start(&multi_q, multi_stack,
+			   K_THREAD_STACK_SIZEOF(multi_stack),
+			   WORK_PRIORITY, NULL);
+
+	for (unsigned int i = 0; i < num_workers; i++) {
+		cpu = (arch_num_cpus() > 1U) ? (int)(i + 1U) : -1;
+
+		(void)k_work_queue_add_worker(&multi_q, &workers[i],
+					      worker_stacks[i],
+					      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+					      cpu);
+	}
+
+	timing_start();
+
+	for (unsigned int load = 0; load < 2; load++) {
+		work_load_us = (load != 0U) ? CONFIG_BENCHMARK_WORK_LOAD_US : 0U;
+
+		printk("Handler load %u us\n", work_load_us);
+		measure(&single_q, "Single thread queue");
+		measure(&multi_q, "Queue with workers");
+		printk("------------------------------------\n");
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
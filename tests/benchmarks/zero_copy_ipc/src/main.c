@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains a benchmark comparing the throughput of the copying
+ * message queue and pipe calls with that of their zero-copy counterparts.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_MSGS   CONFIG_BENCHMARK_NUM_MSGS
+#define DEPTH      CONFIG_BENCHMARK_QUEUE_DEPTH
+#define MIN_SIZE   1024U
+#define MAX_SIZE   4096U
+
+/* Shared by the message queue and the pipe, which are measured in turn */
+static char __aligned(4) ring[DEPTH * MAX_SIZE];
+
+static char __aligned(4) tx_frame[MAX_SIZE];
+static char __aligned(4) rx_frame[MAX_SIZE];
+
+static struct k_msgq bench_msgq;
+static struct k_pipe bench_pipe;
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+
+static atomic_t failures;
+
+struct bench_case {
+	const char *name;
+	void (*produce)(size_t size);
+	void (*consume)(size_t size);
+};
+
+static inline void fill(void *frame, size_t size, unsigned int seq)
+{
+	memset(frame, (int)(seq & 0xFFU), size);
+}
+
+static inline void check(const void *frame, size_t size, unsigned int seq)
+{
+	const uint8_t *bytes = frame;
+
+	if ((bytes[0] != (seq & 0xFFU)) || (bytes[size - 1] != (seq & 0xFFU))) {
+		atomic_inc(&failures);
+	}
+}
+
+static void msgq_copy_produce(size_t size)
+{
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		fill(tx_frame, size, i);
+		(void)k_msgq_put(&bench_msgq, tx_frame, K_FOREVER);
+	}
+}
+
+static void msgq_copy_consume(size_t size)
+{
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		(void)k_msgq_get(&bench_msgq, rx_frame, K_FOREVER);
+		check(rx_frame, size, i);
+	}
+}
+
+static void pipe_copy_produce(size_t size)
+{
+	size_t written;
+
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		fill(tx_frame, size, i);
+		(void)k_pipe_put(&bench_pipe, tx_frame, size, &written, size,
+				 K_FOREVER);
+	}
+}
+
+static void pipe_copy_consume(size_t size)
+{
+	size_t read;
+
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		(void)k_pipe_get(&bench_pipe, rx_frame, size, &read, size,
+				 K_FOREVER);
+		check(rx_frame, size, i);
+	}
+}
+
+#ifdef CONFIG_MSGQ_ZERO_COPY
+static void msgq_zc_produce(size_t size)
+{
+	void *slot;
+
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		(void)k_msgq_put_reserve(&bench_msgq, &slot, K_FOREVER);
+		fill(slot, size, i);
+		(void)k_msgq_put_commit(&bench_msgq, slot);
+	}
+}
+
+static void msgq_zc_consume(size_t size)
+{
+	void *msg;
+
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		(void)k_msgq_get_peek(&bench_msgq, &msg, K_FOREVER);
+		check(msg, size, i);
+		(void)k_msgq_get_release(&bench_msgq, msg);
+	}
+}
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
+#ifdef CONFIG_PIPE_ZERO_COPY
+/*
+ * Frames never straddle the end of the pipe buffer, whose size is a
+ * multiple of the frame size, so each one is reserved and claimed whole.
+ */
+static void pipe_zc_produce(size_t size)
+{
+	size_t len;
+	void *space;
+
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		len = size;
+		(void)k_pipe_put_reserve(&bench_pipe, &space, &len, K_FOREVER);
+		if (len != size) {
+			atomic_inc(&failures);
+		}
+		fill(space, len, i);
+		(void)k_pipe_put_commit(&bench_pipe, len);
+	}
+}
+
+static void pipe_zc_consume(size_t size)
+{
+	size_t len;
+	void *data;
+
+	for (unsigned int i = 0; i < NUM_MSGS; i++) {
+		len = size;
+		(void)k_pipe_get_peek(&bench_pipe, &data, &len, K_FOREVER);
+		if (len != size) {
+			atomic_inc(&failures);
+		} else {
+			check(data, size, i);
+		}
+		(void)k_pipe_get_release(&bench_pipe, len);
+	}
+}
+#endif /* CONFIG_PIPE_ZERO_COPY */
+
+static const struct bench_case cases[] = {
+	{ "msgq put/get", msgq_copy_produce, msgq_copy_consume },
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	{ "msgq reserve/peek", msgq_zc_produce, msgq_zc_consume },
+#endif
+	{ "pipe put/get", pipe_copy_produce, pipe_copy_consume },
+#ifdef CONFIG_PIPE_ZERO_COPY
+	{ "pipe reserve/peek", pipe_zc_produce, pipe_zc_consume },
+#endif
+};
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	const struct bench_case *c = p1;
+
+	ARG_UNUSED(p3);
+
+	c->produce((size_t)p2);
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	const struct bench_case *c = p1;
+
+	ARG_UNUSED(p3);
+
+	c->consume((size_t)p2);
+}
+
+static void measure(const struct bench_case *c, size_t size)
+{
+	uint64_t kbytes = ((uint64_t)NUM_MSGS * size) / 1024U;
+	timing_t start;
+	timing_t finish;
+	uint64_t ns;
+
+	k_msgq_init(&bench_msgq, ring, size, sizeof(ring) / size);
+	k_pipe_init(&bench_pipe, ring, (sizeof(ring) / size) * size);
+
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE,
+			producer_entry, (void *)c, (void *)size, NULL,
+			K_PRIO_PREEMPT(1), 0, K_FOREVER);
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			consumer_entry, (void *)c, (void *)size, NULL,
+			K_PRIO_PREEMPT(1), 0, K_FOREVER);
+
+	start = timing_counter_get();
+
+	k_thread_start(&consumer_thread);
+	k_thread_start(&producer_thread);
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	finish = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &finish));
+
+	printk("    %-18s %4zu B: %10llu ns, %8llu msgs/s, %8llu KB/s\n",
+	       c->name, size, ns,
+	       (ns != 0U) ? ((uint64_t)NUM_MSGS * NSEC_PER_SEC) / ns : 0U,
+	       (ns != 0U) ? (kbytes * NSEC_PER_SEC) / ns : 0U);
+}
+
+int main(void)
+{
+	int status = TC_PASS;
+
+	timing_init();
+
+	printk("Zero-copy IPC throughput: %u messages, queue depth %u\n",
+	       NUM_MSGS, DEPTH);
+
+	timing_start();
+
+	for (size_t size = MIN_SIZE; size <= MAX_SIZE; size *= 2U) {
+		for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+			measure(&cases[i], size);
+		}
+	}
+	printk("------------------------------------\n");
+
+	timing_stop();
+
+	if (atomic_get(&failures) != 0) {
+		printk("%ld messages were corrupted or split\n",
+		       (long)atomic_get(&failures));
+		status = TC_FAIL;
+	}
+
+	TC_END_REPORT(status);
+
+	return 0;
+}
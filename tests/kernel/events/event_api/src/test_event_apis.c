@@ -64,14 +64,18 @@ ZTEST(events_api, test_k_event_init)
 	/*
 	 * The type of wait queue used by the event may vary depending upon
 	 * which kernel features have been enabled. As such, the most flexible
-	 * useful check is to verify that the waitq is empty.
+	 * useful check is to verify that the waitqs are empty.
 	 */
 
+	for (int i = 0; i < ARRAY_SIZE(event.wait_q); i++) {
+		thread = z_waitq_head(&event.wait_q[i]);
 
-	thread = z_waitq_head(&event.wait_q);
+		zassert_is_null(thread, NULL);
+		zassert_equal(event.wait_mask[i], 0);
+	}
 
-	zassert_is_null(thread, NULL);
 	zassert_true(event.events == 0);
+	zassert_true(event.waiting == 0);
 }
 
 static void receive_existing_events(void)
@@ -337,7 +337,20 @@ ZTEST(ipi, test_high_thread_wakes_some_ipis)
 			continue;
 		}
 
+#if defined(CONFIG_IPI_COALESCE) && defined(CONFIG_ARCH_HAS_DIRECTED_IPIS)
+		/*
+		 * Only the CPU executing the lowest priority busy thread
+		 * needs to reschedule to run the high priority thread.
+		 */
+
+		if (_kernel.cpus[i].current == &thread[NUM_THREADS - 1]) {
+			zassert_true(set[i] == 1, "CPU%u got %u IPIs", i, set[i]);
+		} else {
+			zassert_true(set[i] == 0, "CPU%u got %u IPI(s)", i, set[i]);
+		}
+#else
 		zassert_true(set[i] == 1, "CPU%u got %u IPIs", i, set[i]);
+#endif
 	}
 
 	zassert_true(set[id] == 0, "Current CPU got %u IPI(s).\n", set[id]);
@@ -435,6 +448,64 @@ ZTEST(ipi, test_thread_coop_no_ipis)
 	}
 }
 
+#ifdef CONFIG_OBJ_CORE_STATS_IPI
+/*
+ * Verify that the IPI object core statistics count the IPIs sent, handled
+ * and coalesced.
+ */
+ZTEST(ipi, test_ipi_stats)
+{
+	struct k_ipi_stats before[CONFIG_MP_MAX_NUM_CPUS];
+	struct k_ipi_stats after;
+	uint32_t  set[CONFIG_MP_MAX_NUM_CPUS];
+	uint32_t  id;
+	int priority;
+	int key;
+	int rv;
+	unsigned int i;
+
+	priority = k_thread_priority_get(k_current_get());
+
+	id = busy_threads_create(priority - 1);
+
+	for (i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		rv = k_obj_core_stats_raw(K_OBJ_CORE(&_kernel.cpus[i].ipi),
+					  &before[i], sizeof(before[i]));
+		zassert_equal(rv, 0, "Failed to get CPU%u IPI stats (%d)", i, rv);
+	}
+
+	/* Flag all other CPUs twice, the second request being coalesced */
+
+	clear_ipi_counts();
+	key = arch_irq_lock();
+	flag_ipi(IPI_ALL_CPUS_MASK ^ BIT(id));
+	flag_ipi(IPI_ALL_CPUS_MASK ^ BIT(id));
+	signal_pending_ipi();
+	arch_irq_unlock(key);
+	k_busy_wait(DELAY_FOR_IPIS);
+	get_ipi_counts(set, CONFIG_MP_MAX_NUM_CPUS);
+
+	for (i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		rv = k_obj_core_stats_raw(K_OBJ_CORE(&_kernel.cpus[i].ipi),
+					  &after, sizeof(after));
+		zassert_equal(rv, 0, "Failed to get CPU%u IPI stats (%d)", i, rv);
+
+		zassert_equal(after.received - before[i].received, set[i],
+			      "CPU%u handled %u IPIs, %u counted", i, set[i],
+			      after.received - before[i].received);
+
+		if (i == id) {
+			zassert_true(after.sent > before[i].sent,
+				     "IPI sent by CPU%u not counted", i);
+			zassert_true(after.coalesced > before[i].coalesced,
+				     "Coalesced IPI on CPU%u not counted", i);
+		} else {
+			zassert_true(set[i] == 1, "CPU%u got %u IPIs", i, set[i]);
+		}
+	}
+}
+#endif /* CONFIG_OBJ_CORE_STATS_IPI */
+
 static void *ipi_tests_setup(void)
 {
 	/*
@@ -11,12 +11,16 @@
 #include <mmu.h>
 #include <zephyr/linker/sections.h>
 
-#ifdef CONFIG_BACKING_STORE_RAM_PAGES
-#define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#if defined(CONFIG_BACKING_STORE_RAM_PAGES)
+#define BACKING_STORE_PAGES	CONFIG_BACKING_STORE_RAM_PAGES
+#elif defined(CONFIG_BACKING_STORE_COMPRESSED_PAGES)
+#define BACKING_STORE_PAGES	CONFIG_BACKING_STORE_COMPRESSED_PAGES
 #else
 #error "Unsupported configuration"
 #endif
 
+#define EXTRA_PAGES	(BACKING_STORE_PAGES - 1)
+
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
 #ifdef CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS
 
@@ -83,6 +87,17 @@ void k_sys_fatal_error_handler(unsigned int reason, const struct arch_esf *pEsf)
  */
 #define HALF_PAGES	(EXTRA_PAGES / 2)
 #define HALF_BYTES	(HALF_PAGES * CONFIG_MMU_PAGE_SIZE)
+
+/* Faults taken streaming through HALF_PAGES paged out pages: with
+ * prefetching, a first fault, then one sequential fault every
+ * CONFIG_DEMAND_PAGING_PREFETCH_PAGES + 1 pages.
+ */
+#ifdef CONFIG_DEMAND_PAGING_PREFETCH
+#define STREAM_FAULTS	(1 + DIV_ROUND_UP(HALF_PAGES - 1,			\
+					  CONFIG_DEMAND_PAGING_PREFETCH_PAGES + 1))
+#else
+#define STREAM_FAULTS	HALF_PAGES
+#endif
 static const char *nums = "0123456789";
 
 ZTEST(demand_paging, test_map_anon_pages)
@@ -113,6 +128,14 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+
+#ifdef CONFIG_BACKING_STORE_COMPRESSED
+	printk("* Compression (%s):\n", scope);
+	printk("    - Pages stored: %lu\n", stats->compression.pages);
+	printk("    - Incompressible pages: %lu\n",
+	       stats->compression.incompressible);
+	printk("    - Bytes used: %lu\n", stats->compression.bytes);
+#endif
 }
 
 static void touch_anon_pages(bool zig, bool zag)
@@ -252,9 +275,9 @@ static void test_k_mem_page_out(void)
 	faults = k_mem_num_pagefaults_get() - faults;
 	irq_unlock(key);
 
-	zassert_equal(faults, HALF_PAGES,
+	zassert_equal(faults, STREAM_FAULTS,
 		      "unexpected num pagefaults expected %lu got %d",
-		      HALF_PAGES, faults);
+		      STREAM_FAULTS, faults);
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
@@ -288,6 +311,48 @@ ZTEST(demand_paging_api, test_k_mem_page_in)
 		      faults);
 }
 
+#ifdef CONFIG_EVICTION_CLOCK_PRO
+#define HOT_PAGES	2
+
+static void read_pages(char *start, size_t pages, char *hot)
+{
+	for (size_t i = 0; i < pages; i++) {
+		(void)*(volatile char *)(start + i * CONFIG_MMU_PAGE_SIZE);
+		for (size_t j = 0; (hot != NULL) && (j < HOT_PAGES); j++) {
+			(void)*(volatile char *)(hot + j * CONFIG_MMU_PAGE_SIZE);
+		}
+	}
+}
+
+/* A working set reused while the rest of the arena is streamed through
+ * becomes hot, and then survives scans which touch each page only once.
+ */
+ZTEST(demand_paging_api, test_scan_resistance)
+{
+	char *scan = arena + HOT_PAGES * CONFIG_MMU_PAGE_SIZE;
+	size_t scan_pages = arena_size / CONFIG_MMU_PAGE_SIZE - HOT_PAGES;
+	unsigned long faults;
+	unsigned int key;
+
+	for (int pass = 0; pass < 3; pass++) {
+		read_pages(scan, scan_pages, arena);
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		read_pages(scan, scan_pages, NULL);
+	}
+
+	key = irq_lock();
+	faults = k_mem_num_pagefaults_get();
+	read_pages(arena, HOT_PAGES, NULL);
+	faults = k_mem_num_pagefaults_get() - faults;
+	irq_unlock(key);
+
+	zassert_equal(faults, 0, "%lu page faults, working set was evicted by a scan",
+		      faults);
+}
+#endif /* CONFIG_EVICTION_CLOCK_PRO */
+
 ZTEST(demand_paging_api, test_k_mem_pin)
 {
 	unsigned long faults;
@@ -337,7 +402,7 @@ ZTEST(demand_paging_stat, test_backing_store_capacity)
 	char *mem, *ret;
 	unsigned int key;
 	unsigned long faults;
-	size_t size = (((CONFIG_BACKING_STORE_RAM_PAGES - 1) - HALF_PAGES) *
+	size_t size = (((BACKING_STORE_PAGES - 1) - HALF_PAGES) *
 		       CONFIG_MMU_PAGE_SIZE);
 
 	/* Consume the rest of memory */
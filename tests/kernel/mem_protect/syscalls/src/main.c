@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/syscall_batch.h>
 #include <zephyr/ztest.h>
 #include <zephyr/linker/linker-defs.h>
 #include "test_syscalls.h"
@@ -446,6 +447,43 @@ ZTEST(syscalls, test_syscall_context)
 	k_thread_user_mode_enter(test_syscall_context_user, NULL, NULL, NULL);
 }
 
+/**
+ * @brief Test making several system calls in a single trap
+ *
+ * @see k_syscall_batch()
+ */
+ZTEST_USER(syscalls, test_syscall_batch)
+{
+	int err = -1;
+	struct k_syscall_batch_entry batch[] = {
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_STRING_NLEN, (uintptr_t)user_string,
+				      BUF_SIZE, (uintptr_t)&err),
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_SYSCALL_CONTEXT, 0),
+	};
+	int ret;
+
+	ret = k_syscall_batch(batch, ARRAY_SIZE(batch));
+	zassert_equal(ret, 0, "batch failed");
+	zassert_equal(err, 0, "user string faulted");
+	zassert_equal(batch[0].ret, strlen(user_string),
+		      "incorrect length returned");
+	zassert_true(batch[1].ret, "not reported in user syscall");
+
+	/* Rejected before the entries are looked at */
+	ret = k_syscall_batch(batch, CONFIG_SYSCALL_BATCH_MAX + 1);
+	zassert_equal(ret, -EINVAL, "oversized batch accepted");
+}
+
+ZTEST(syscalls, test_syscall_batch_supervisor)
+{
+	struct k_syscall_batch_entry batch[] = {
+		K_SYSCALL_BATCH_ENTRY(K_SYSCALL_SYSCALL_CONTEXT, 0),
+	};
+
+	zassert_equal(k_syscall_batch(batch, ARRAY_SIZE(batch)), -ENOTSUP,
+		      "batch made from supervisor mode");
+}
+
 K_HEAP_DEFINE(test_heap, BUF_SIZE * (4 * MAX_NR_THREADS));
 
 void *syscalls_setup(void)
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_ZERO_COPY
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) zc_buffer[MSG_SIZE * MSGQ_LEN];
+
+static void put_in_place(struct k_msgq *q, uint32_t value)
+{
+	void *slot;
+
+	zassert_ok(k_msgq_put_reserve(q, &slot, K_NO_WAIT));
+	*(uint32_t *)slot = value;
+	zassert_ok(k_msgq_put_commit(q, slot));
+}
+
+static uint32_t get_in_place(struct k_msgq *q)
+{
+	uint32_t value;
+	void *msg;
+
+	zassert_ok(k_msgq_get_peek(q, &msg, K_NO_WAIT));
+	value = *(uint32_t *)msg;
+	zassert_ok(k_msgq_get_release(q, msg));
+
+	return value;
+}
+
+static void zero_copy_order(struct k_msgq *q)
+{
+	uint32_t value = MSG1;
+	uint32_t rx;
+	void *slot;
+	void *msg;
+
+	/* messages written in place and copied keep their order */
+	put_in_place(q, MSG0);
+	zassert_ok(k_msgq_put(q, &value, K_NO_WAIT));
+	zassert_equal(get_in_place(q), MSG0);
+	zassert_ok(k_msgq_get(q, &rx, K_NO_WAIT));
+	zassert_equal(rx, MSG1);
+
+	/* a reservation holds up copying senders */
+	zassert_ok(k_msgq_put_reserve(q, &slot, K_NO_WAIT));
+	zassert_equal(k_msgq_put(q, &value, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_reserve(q, &msg, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get(q, &rx, K_NO_WAIT), -ENOMSG);
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_put_commit(q, zc_buffer + MSG_SIZE * MSGQ_LEN),
+		      -EINVAL);
+	zassert_ok(k_msgq_put_commit(q, slot));
+	zassert_equal(k_msgq_put_commit(q, slot), -EINVAL);
+
+	/* a claim holds up copying receivers, but not senders */
+	zassert_ok(k_msgq_put(q, &value, K_NO_WAIT));
+	zassert_ok(k_msgq_get_peek(q, &msg, K_NO_WAIT));
+	zassert_equal(*(uint32_t *)msg, MSG0);
+	zassert_equal(k_msgq_get(q, &rx, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_peek(q, &slot, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_num_used_get(q), MSGQ_LEN);
+	zassert_ok(k_msgq_get_release(q, msg));
+	zassert_equal(k_msgq_get_release(q, msg), -EINVAL);
+	zassert_ok(k_msgq_get(q, &rx, K_NO_WAIT));
+	zassert_equal(rx, MSG1);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test reserving, committing, claiming and releasing messages
+ * @see k_msgq_put_reserve(), k_msgq_put_commit(), k_msgq_get_peek(),
+ * k_msgq_get_release()
+ */
+ZTEST(msgq_api, test_msgq_zero_copy)
+{
+	k_msgq_init(&msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	zero_copy_order(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	zero_copy_order((struct k_msgq *)p1);
+}
+
+/**
+ * @brief Test zero-copy access from a user thread
+ * @see k_msgq_put_reserve(), k_msgq_put_commit(), k_msgq_get_peek(),
+ * k_msgq_get_release()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_user_zero_copy)
+{
+	k_msgq_init(&msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, user_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_thread_join(&tdata, K_FOREVER);
+}
+#endif
+
+static void release_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(get_in_place(q), MSG0);
+}
+
+static void commit_entry(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *q = p1;
+
+	k_msleep(TIMEOUT_MS >> 1);
+	put_in_place(q, MSG1);
+}
+
+/**
+ * @brief Test zero-copy calls waiting for space and for messages
+ * @see k_msgq_put_reserve(), k_msgq_get_peek()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_wait)
+{
+	void *slot;
+	void *msg;
+
+	k_msgq_init(&msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+	put_in_place(&msgq, MSG0);
+	put_in_place(&msgq, MSG0);
+
+	/* a full queue: wait for a receiver to release a message */
+	zassert_equal(k_msgq_put_reserve(&msgq, &slot, TIMEOUT), -EAGAIN);
+	k_thread_create(&tdata, tstack, STACK_SIZE, release_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_msgq_put_reserve(&msgq, &slot, TIMEOUT));
+	zassert_ok(k_msgq_put_commit(&msgq, slot));
+	k_thread_join(&tdata, K_FOREVER);
+
+	k_msgq_purge(&msgq);
+
+	/* an empty queue: wait for a sender to commit a message */
+	zassert_equal(k_msgq_get_peek(&msgq, &msg, TIMEOUT), -EAGAIN);
+	k_thread_create(&tdata, tstack, STACK_SIZE, commit_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_msgq_get_peek(&msgq, &msg, TIMEOUT));
+	zassert_equal(*(uint32_t *)msg, MSG1);
+	zassert_ok(k_msgq_get_release(&msgq, msg));
+	k_thread_join(&tdata, K_FOREVER);
+}
+
+/**
+ * @brief Test purging a message queue with a claimed message
+ * @see k_msgq_purge(), k_msgq_get_peek(), k_msgq_get_release()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_purge)
+{
+	uint32_t value = MSG1;
+	void *msg;
+
+	k_msgq_init(&msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+	put_in_place(&msgq, MSG0);
+	zassert_ok(k_msgq_put(&msgq, &value, K_NO_WAIT));
+
+	zassert_ok(k_msgq_get_peek(&msgq, &msg, K_NO_WAIT));
+	k_msgq_purge(&msgq);
+
+	/* the claimed message survives, the rest goes with it */
+	zassert_equal(*(uint32_t *)msg, MSG0);
+	zassert_ok(k_msgq_get_release(&msgq, msg));
+	zassert_equal(k_msgq_num_used_get(&msgq), 0);
+
+	put_in_place(&msgq, MSG1);
+	zassert_equal(get_in_place(&msgq), MSG1);
+}
+
+/**
+ * @}
+ */
+
+#endif /* CONFIG_MSGQ_ZERO_COPY */
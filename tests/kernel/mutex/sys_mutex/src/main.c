@@ -49,6 +49,8 @@
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <zephyr/sys/mutex.h>
+#include <zephyr/sys/condvar.h>
+#include <zephyr/sys/rwlock.h>
 
 #define STACKSIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
 
@@ -67,6 +69,9 @@ static SYS_MUTEX_DEFINE(no_access_mutex);
 #endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
 static ZTEST_BMEM SYS_MUTEX_DEFINE(bad_count_mutex);
+static ZTEST_BMEM SYS_MUTEX_DEFINE(condvar_mutex);
+static ZTEST_BMEM SYS_CONDVAR_DEFINE(condvar);
+static ZTEST_BMEM SYS_RWLOCK_DEFINE(rwlock);
 
 #ifdef CONFIG_USERSPACE
 #define ZTEST_USER_OR_NOT ZTEST_USER
@@ -451,12 +456,15 @@ ZTEST(mutex_complex, test_supervisor_access)
 	/* coverage for get_k_mutex checks */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
-	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
-	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
 	rv = sys_mutex_unlock((struct sys_mutex *)NULL);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
+#ifndef CONFIG_SYS_MUTEX_FAST_PATH
+	/* The fast path writes to the mutex before any syscall */
+	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
+	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
 	rv = sys_mutex_unlock((struct sys_mutex *)k_current_get());
 	zassert_true(rv == -EINVAL, "accepted object that was not a mutex");
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 #endif /* CONFIG_USERSPACE */
 
 	rv = sys_mutex_unlock(&not_my_mutex);
@@ -467,7 +475,7 @@ ZTEST(mutex_complex, test_supervisor_access)
 
 ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 {
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST_PATH)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
@@ -476,7 +484,83 @@ ZTEST_USER_OR_NOT(mutex_complex, test_user_access)
 	zassert_true(rv == -EACCES, "accessed mutex not in memory domain");
 #else
 	ztest_test_skip();
-#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_USERSPACE && !CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+static ZTEST_BMEM SYS_MUTEX_DEFINE(forged_mutex);
+static struct k_mem_domain forged_owner_domain;
+static struct k_thread forged_owner;
+static K_THREAD_STACK_DEFINE(forged_owner_stack, STACKSIZE);
+
+static void forged_owner_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
+/**
+ * @brief Test that a forged owner in a mutex lock word is rejected
+ *
+ * The lock word lives in user memory, so a thread may write any thread
+ * there.  The kernel must not take it as the owner, and boost its
+ * priority, unless the caller could access that thread anyway.
+ */
+ZTEST_USER_OR_NOT(mutex_complex, test_forged_owner)
+{
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	int rv;
+
+	if (!k_is_user_context()) {
+		ztest_test_skip();
+	}
+
+	atomic_set(&forged_mutex.val, (atomic_val_t)&forged_owner);
+	rv = sys_mutex_lock(&forged_mutex, K_NO_WAIT);
+	zassert_equal(rv, -EPERM, "accepted a thread outside our domain");
+
+	atomic_set(&forged_mutex.val, (atomic_val_t)&condvar);
+	rv = sys_mutex_lock(&forged_mutex, K_NO_WAIT);
+	zassert_equal(rv, -EINVAL, "accepted an object that is not a thread");
+
+	atomic_clear(&forged_mutex.val);
+	zassert_equal(sys_mutex_lock(&forged_mutex, K_NO_WAIT), 0);
+	zassert_equal(sys_mutex_unlock(&forged_mutex), 0);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+}
+
+/**
+ * @brief Test uncontended sys_condvar and sys_rwlock operations
+ */
+ZTEST_USER_OR_NOT(mutex_complex, test_condvar_rwlock)
+{
+	int rv;
+
+	zassert_equal(sys_condvar_signal(&condvar), 0);
+	zassert_equal(sys_condvar_broadcast(&condvar), 0);
+
+	zassert_equal(sys_mutex_lock(&condvar_mutex, K_NO_WAIT), 0);
+	rv = sys_condvar_wait(&condvar, &condvar_mutex, K_MSEC(10));
+	zassert_equal(rv, -ETIMEDOUT, "condvar wait didn't time out");
+	/* The mutex is held again after the wait */
+	zassert_equal(sys_mutex_unlock(&condvar_mutex), 0);
+
+	zassert_equal(sys_rwlock_rdlock(&rwlock, K_NO_WAIT), 0);
+	zassert_equal(sys_rwlock_rdlock(&rwlock, K_NO_WAIT), 0);
+	rv = sys_rwlock_wrlock(&rwlock, K_NO_WAIT);
+	zassert_equal(rv, -ETIMEDOUT, "took rwlock for writing with readers");
+	zassert_equal(sys_rwlock_unlock(&rwlock), 0);
+	zassert_equal(sys_rwlock_unlock(&rwlock), 0);
+
+	zassert_equal(sys_rwlock_wrlock(&rwlock, K_NO_WAIT), 0);
+	rv = sys_rwlock_rdlock(&rwlock, K_NO_WAIT);
+	zassert_equal(rv, -ETIMEDOUT, "took rwlock for reading with a writer");
+	zassert_equal(sys_rwlock_unlock(&rwlock), 0);
+	zassert_equal(sys_rwlock_unlock(&rwlock), -EPERM);
 }
 
 /*test case main entry*/
@@ -502,6 +586,15 @@ static void *sys_mutex_tests_setup(void)
 	if (rv != 0) {
 		TC_ERROR("Failed to take mutex %p\n", &not_my_mutex);
 	}
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* A thread that the test thread has no access to, which never runs */
+	k_mem_domain_init(&forged_owner_domain, 0, NULL);
+	k_thread_create(&forged_owner, forged_owner_stack, STACKSIZE,
+			forged_owner_entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_FOREVER);
+	k_mem_domain_add_thread(&forged_owner_domain, &forged_owner);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
 	return NULL;
 }
 
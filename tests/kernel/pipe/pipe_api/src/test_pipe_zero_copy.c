@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for zero-copy pipe access
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#ifdef CONFIG_PIPE_ZERO_COPY
+
+#define ZC_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define ZC_PIPE_LEN   16
+#define ZC_TIMEOUT    K_MSEC(100)
+
+static ZTEST_BMEM unsigned char __aligned(4) zc_buffer[ZC_PIPE_LEN];
+static struct k_pipe zc_pipe;
+
+static K_THREAD_STACK_DEFINE(zc_stack, ZC_STACK_SIZE);
+static struct k_thread zc_thread;
+
+static void put_in_place(struct k_pipe *pipe, const char *str, size_t len)
+{
+	size_t granted = len;
+	void *space;
+
+	zassert_ok(k_pipe_put_reserve(pipe, &space, &granted, K_NO_WAIT));
+	zassert_equal(granted, len);
+	memcpy(space, str, len);
+	zassert_ok(k_pipe_put_commit(pipe, len));
+}
+
+static void zero_copy_order(struct k_pipe *pipe)
+{
+	unsigned char rx[ZC_PIPE_LEN];
+	size_t written;
+	size_t read;
+	size_t len;
+	void *space;
+	void *data;
+
+	/* data written in place and copied keeps its order */
+	put_in_place(pipe, "abcd", 4);
+	zassert_ok(k_pipe_put(pipe, "efgh", 4, &written, 4, K_NO_WAIT));
+
+	len = 2;
+	zassert_ok(k_pipe_get_peek(pipe, &data, &len, K_NO_WAIT));
+	zassert_equal(len, 2);
+	zassert_mem_equal(data, "ab", 2);
+
+	/* a claim holds up copying readers, but not writers */
+	zassert_equal(k_pipe_get(pipe, rx, 1, &read, 1, K_NO_WAIT), -EIO);
+	zassert_equal(k_pipe_read_avail(pipe), 6);
+	zassert_ok(k_pipe_put(pipe, "ijkl", 4, &written, 4, K_NO_WAIT));
+	zassert_equal(k_pipe_get_release(pipe, 3), -EINVAL);
+	zassert_ok(k_pipe_get_release(pipe, 2));
+	zassert_equal(k_pipe_get_release(pipe, 0), -EINVAL);
+
+	zassert_ok(k_pipe_get(pipe, rx, 10, &read, 10, K_NO_WAIT));
+	zassert_mem_equal(rx, "cdefghijkl", 10);
+
+	/* an empty pipe rewinds, so the whole buffer is contiguous */
+	len = ZC_PIPE_LEN * 2;
+	zassert_ok(k_pipe_put_reserve(pipe, &space, &len, K_NO_WAIT));
+	zassert_equal(len, ZC_PIPE_LEN);
+	zassert_equal(k_pipe_write_avail(pipe), 0);
+
+	/* a reservation holds up copying writers */
+	zassert_equal(k_pipe_put(pipe, "x", 1, &written, 1, K_NO_WAIT), -EIO);
+	len = 1;
+	zassert_equal(k_pipe_put_reserve(pipe, &data, &len, K_NO_WAIT), -EIO);
+	memcpy(space, "0123456789abcdef", ZC_PIPE_LEN);
+	zassert_ok(k_pipe_put_commit(pipe, 12));
+
+	/* data wrapping around the end is claimed in two parts */
+	zassert_ok(k_pipe_get(pipe, rx, 8, &read, 8, K_NO_WAIT));
+	zassert_ok(k_pipe_put(pipe, "WXYZ", 4, &written, 4, K_NO_WAIT));
+	zassert_ok(k_pipe_put(pipe, "!?", 2, &written, 2, K_NO_WAIT));
+
+	len = ZC_PIPE_LEN;
+	zassert_ok(k_pipe_get_peek(pipe, &data, &len, K_NO_WAIT));
+	zassert_equal(len, 8);
+	zassert_mem_equal(data, "89abWXYZ", 8);
+	zassert_ok(k_pipe_get_release(pipe, len));
+
+	len = ZC_PIPE_LEN;
+	zassert_ok(k_pipe_get_peek(pipe, &data, &len, K_NO_WAIT));
+	zassert_equal(len, 2);
+	zassert_mem_equal(data, "!?", 2);
+	zassert_ok(k_pipe_get_release(pipe, len));
+
+	len = 1;
+	zassert_equal(k_pipe_get_peek(pipe, &data, &len, K_NO_WAIT), -EIO);
+}
+
+/**
+ * @brief Test reserving, committing, claiming and releasing pipe data
+ * @see k_pipe_put_reserve(), k_pipe_put_commit(), k_pipe_get_peek(),
+ * k_pipe_get_release()
+ */
+ZTEST(pipe_api, test_pipe_zero_copy)
+{
+	k_pipe_init(&zc_pipe, zc_buffer, sizeof(zc_buffer));
+
+	zero_copy_order(&zc_pipe);
+}
+
+#ifdef CONFIG_USERSPACE
+static void user_entry(void *p1, void *p2, void *p3)
+{
+	zero_copy_order((struct k_pipe *)p1);
+}
+
+/**
+ * @brief Test zero-copy pipe access from a user thread
+ * @see k_pipe_put_reserve(), k_pipe_put_commit(), k_pipe_get_peek(),
+ * k_pipe_get_release()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_user_zero_copy)
+{
+	k_pipe_init(&zc_pipe, zc_buffer, sizeof(zc_buffer));
+	k_object_access_grant(&zc_pipe, k_current_get());
+
+	k_thread_create(&zc_thread, zc_stack, ZC_STACK_SIZE, user_entry,
+			&zc_pipe, NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	k_thread_join(&zc_thread, K_FOREVER);
+}
+#endif
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	unsigned char rx[4];
+	size_t read;
+
+	zassert_ok(k_pipe_get(p1, rx, sizeof(rx), &read, sizeof(rx),
+			      ZC_TIMEOUT));
+	zassert_mem_equal(rx, "abcd", sizeof(rx));
+}
+
+static void writer_entry(void *p1, void *p2, void *p3)
+{
+	size_t written;
+
+	k_msleep(50);
+	zassert_ok(k_pipe_put(p1, "wxyz", 4, &written, 4, K_NO_WAIT));
+}
+
+/**
+ * @brief Test zero-copy pipe access with waiting threads
+ * @see k_pipe_put_commit(), k_pipe_get_peek()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_zero_copy_wait)
+{
+	size_t len = 4;
+	void *data;
+
+	k_pipe_init(&zc_pipe, zc_buffer, sizeof(zc_buffer));
+
+	/* a commit feeds a reader waiting on the empty pipe */
+	k_thread_create(&zc_thread, zc_stack, ZC_STACK_SIZE, reader_entry,
+			&zc_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(10);
+	put_in_place(&zc_pipe, "abcd", 4);
+	k_thread_join(&zc_thread, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&zc_pipe), 0);
+
+	/* a claim waits for a writer */
+	k_thread_create(&zc_thread, zc_stack, ZC_STACK_SIZE, writer_entry,
+			&zc_pipe, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_ok(k_pipe_get_peek(&zc_pipe, &data, &len, ZC_TIMEOUT));
+	zassert_equal(len, 4);
+	zassert_mem_equal(data, "wxyz", 4);
+	zassert_ok(k_pipe_get_release(&zc_pipe, len));
+	k_thread_join(&zc_thread, K_FOREVER);
+}
+
+#endif /* CONFIG_PIPE_ZERO_COPY */
+
+/**
+ * @}
+ */
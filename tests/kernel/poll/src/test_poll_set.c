@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define NUM_SEMS 16
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static struct k_sem set_sems[NUM_SEMS];
+static struct k_poll_event set_events[NUM_SEMS];
+static struct k_poll_set set;
+
+static struct k_fifo set_fifo;
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void poll_set_setup(void)
+{
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		zassert_equal(k_poll_set_add(&set, &set_events[i]), 0);
+	}
+}
+
+static void poll_set_teardown(void)
+{
+	for (int i = 0; i < NUM_SEMS; i++) {
+		zassert_equal(k_poll_set_remove(&set, &set_events[i]), 0);
+	}
+}
+
+/**
+ * @brief Test adding, removing and waiting on the events of a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_init(), k_poll_set_add(), k_poll_set_remove(),
+ * k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set)
+{
+	struct k_poll_event *ready[NUM_SEMS];
+	struct k_poll_set other;
+
+	poll_set_setup();
+
+	/* nothing ready */
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_MSEC(10)),
+		      -EAGAIN);
+
+	/* an event can only be in one set */
+	k_poll_set_init(&other);
+	zassert_equal(k_poll_set_add(&set, &set_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_add(&other, &set_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_remove(&other, &set_events[0]), -EINVAL);
+
+	k_sem_give(&set_sems[3]);
+	k_sem_give(&set_sems[7]);
+
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &set_events[3]);
+	zassert_equal_ptr(ready[1], &set_events[7]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+	zassert_equal(ready[1]->state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/* events stay ready as long as their condition is met */
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[7]);
+
+	zassert_equal(k_sem_take(&set_sems[7], K_NO_WAIT), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN);
+
+	/* events stay registered between waits */
+	k_sem_give(&set_sems[3]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[3]);
+	zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0);
+
+	/* a removed event is not returned */
+	zassert_equal(k_poll_set_remove(&set, &set_events[5]), 0);
+	k_sem_give(&set_sems[5]);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT),
+		      -EAGAIN);
+
+	/* an event ready when added is returned */
+	zassert_equal(k_poll_set_add(&set, &set_events[5]), 0);
+	zassert_equal(k_poll_set_wait(&set, ready, NUM_SEMS, K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[5]);
+	zassert_equal(k_sem_take(&set_sems[5], K_NO_WAIT), 0);
+
+	poll_set_teardown();
+}
+
+/**
+ * @brief Test waiting on a poll set with more events ready than room
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_partial)
+{
+	struct k_poll_event *ready[2];
+
+	poll_set_setup();
+
+	k_sem_give(&set_sems[1]);
+	k_sem_give(&set_sems[2]);
+	k_sem_give(&set_sems[3]);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &set_events[1]);
+	zassert_equal_ptr(ready[1], &set_events[2]);
+
+	/* the event left out comes first */
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &set_events[3]);
+	zassert_equal_ptr(ready[1], &set_events[1]);
+
+	for (int i = 1; i <= 3; i++) {
+		zassert_equal(k_sem_take(&set_sems[i], K_NO_WAIT), 0);
+	}
+
+	zassert_equal(k_poll_set_wait(&set, ready, 2, K_NO_WAIT), -EAGAIN);
+
+	poll_set_teardown();
+}
+
+static void set_fifo_put(void *p1, void *p2, void *p3)
+{
+	static struct {
+		void *reserved;
+		uint32_t value;
+	} msg = { .value = 0xdeadbeef };
+
+	k_sleep(K_MSEC(50));
+	k_fifo_put(&set_fifo, &msg);
+}
+
+/**
+ * @brief Test blocking on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[1];
+	struct k_poll_event event;
+
+	k_poll_set_init(&set);
+	k_fifo_init(&set_fifo);
+	k_poll_event_init(&event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	zassert_equal(k_poll_set_add(&set, &event), 0);
+
+	k_thread_create(&set_thread, set_stack, K_THREAD_STACK_SIZEOF(set_stack),
+			set_fifo_put, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_SECONDS(1)), 1);
+	zassert_equal_ptr(ready[0], &event);
+	zassert_equal(event.state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+	zassert_not_null(k_fifo_get(&set_fifo, K_NO_WAIT));
+
+	k_thread_join(&set_thread, K_FOREVER);
+
+	/* times out once the data is gone */
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_MSEC(50)), -EAGAIN);
+
+	/* a cancelled wait is reported */
+	k_fifo_cancel_wait(&set_fifo);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal(event.state, K_POLL_STATE_CANCELLED);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+
+	zassert_equal(k_poll_set_remove(&set, &event), 0);
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define HOG_PRIO   K_PRIO_PREEMPT(5)
+
+static struct k_thread hog_thread;
+static struct k_thread peer_thread;
+static K_THREAD_STACK_DEFINE(hog_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(peer_stack, STACK_SIZE);
+
+static atomic_t overruns;
+static volatile int peer_runs;
+
+static void hog(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_busy_wait(100);
+	}
+}
+
+static void peer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_busy_wait(1000);
+		peer_runs++;
+		k_msleep(10);
+	}
+}
+
+static void overrun_cb(struct k_thread *thread, void *data)
+{
+	zassert_equal(thread, &hog_thread, "overrun reported for wrong thread");
+	zassert_equal_ptr(data, &overruns, "wrong callback data");
+
+	atomic_inc(&overruns);
+}
+
+static void cbs_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_thread_abort(&hog_thread);
+	k_thread_abort(&peer_thread);
+}
+
+static k_tid_t spawn(struct k_thread *thread, k_thread_stack_t *stack,
+		     k_thread_entry_t entry)
+{
+	return k_thread_create(thread, stack, STACK_SIZE, entry,
+			       NULL, NULL, NULL, HOG_PRIO, 0, K_FOREVER);
+}
+
+/**
+ * @brief Check parameter validation and admission control
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_deadline_cbs, test_cbs_admission)
+{
+	uint32_t limit = CONFIG_SCHED_DEADLINE_CBS_MAX_UTILIZATION;
+
+	spawn(&hog_thread, hog_stack, hog);
+	spawn(&peer_thread, peer_stack, peer);
+
+	zassert_equal(k_thread_cbs_set(&hog_thread, 2000, 1000, NULL, NULL),
+		      -EINVAL, "runtime above period accepted");
+
+	/* Fill the bandwidth exactly, then ask for a bit more */
+	zassert_ok(k_thread_cbs_set(&hog_thread, limit * 10000U, 1000000,
+				    NULL, NULL));
+	zassert_equal(k_thread_cbs_set(&peer_thread, 10000, 1000000, NULL, NULL),
+		      -EBUSY, "over-commitment accepted");
+
+	/* Shrinking a reservation frees bandwidth for others */
+	zassert_ok(k_thread_cbs_set(&hog_thread, (limit - 1U) * 10000U,
+				    1000000, NULL, NULL));
+	zassert_ok(k_thread_cbs_set(&peer_thread, 5000, 1000000, NULL, NULL));
+
+	/* As does releasing one */
+	zassert_ok(k_thread_cbs_set(&hog_thread, 0, 0, NULL, NULL));
+	zassert_ok(k_thread_cbs_set(&peer_thread, 500000, 1000000, NULL, NULL));
+
+	/* And aborting a reserved thread */
+	k_thread_abort(&peer_thread);
+	spawn(&peer_thread, peer_stack, peer);
+	zassert_ok(k_thread_cbs_set(&hog_thread, limit * 10000U, 1000000,
+				    NULL, NULL));
+}
+
+/**
+ * @brief Check that budget overruns are reported
+ *
+ * @details A reserved thread that never blocks must exhaust its budget
+ * in every period, and the overrun callback must be called each time.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_deadline_cbs, test_cbs_overrun_notification)
+{
+	atomic_clear(&overruns);
+
+	spawn(&hog_thread, hog_stack, hog);
+	zassert_ok(k_thread_cbs_set(&hog_thread, 2000, 10000, overrun_cb,
+				    &overruns));
+	k_thread_start(&hog_thread);
+
+	k_msleep(100);
+
+	zassert_true(atomic_get(&overruns) >= 3, "only %d overruns reported",
+		     (int)atomic_get(&overruns));
+}
+
+/**
+ * @brief Check that an overrunning thread cannot starve a peer
+ *
+ * @details Two reserved threads share a priority.  One spins forever;
+ * the other runs for 1 ms then sleeps.  Without budgets the spinning
+ * thread would keep the CPU, as threads of equal priority do not
+ * preempt each other.  With them, its deadline keeps being postponed
+ * and the peer, which stays within its reservation, preempts it as
+ * soon as it wakes up.
+ *
+ * @ingroup kernel_sched_tests
+ */
+ZTEST(suite_deadline_cbs, test_cbs_isolation)
+{
+	peer_runs = 0;
+
+	spawn(&hog_thread, hog_stack, hog);
+	spawn(&peer_thread, peer_stack, peer);
+	zassert_ok(k_thread_cbs_set(&hog_thread, 5000, 10000, NULL, NULL));
+	zassert_ok(k_thread_cbs_set(&peer_thread, 2000, 10000, NULL, NULL));
+
+	k_thread_start(&hog_thread);
+	k_msleep(20);
+	k_thread_start(&peer_thread);
+
+	k_msleep(200);
+
+	/* About one run every 11 ms; leave room for slow emulation */
+	zassert_true(peer_runs >= 10, "peer ran only %d times", peer_runs);
+}
+
+ZTEST_SUITE(suite_deadline_cbs, NULL, NULL, NULL, cbs_after, NULL);
@@ -1216,6 +1216,56 @@ ZTEST(smp, test_smp_affinity)
 }
 #endif
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+#define RUNQ_LOOPS 100
+
+static atomic_t runq_cpus;
+
+static void runq_spin(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	for (int i = 0; i < RUNQ_LOOPS; i++) {
+		atomic_or(&runq_cpus, BIT(curr_cpu()));
+		k_busy_wait(1000);
+		k_yield();
+	}
+}
+
+/**
+ * @brief Test that per-CPU run queues spread threads over all CPUs
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Start one spinning thread per CPU from a thread that keeps
+ * its own CPU busy, then block. Placement, idle pulling and balancing
+ * must get every CPU to run at least one of the spinning threads.
+ */
+ZTEST(smp, test_cpu_runq_spread)
+{
+	int num_threads = arch_num_cpus();
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	atomic_clear(&runq_cpus);
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				runq_spin, NULL, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&runq_cpus), BIT_MASK(num_threads),
+		      "threads ran on CPUs 0x%lx only",
+		      (unsigned long)atomic_get(&runq_cpus));
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WORK_PRIORITY K_PRIO_PREEMPT(1)
+#define NUM_WORKERS 2
+#define NUM_ITEMS 32
+#define NUM_RUNS 50
+
+static K_THREAD_STACK_DEFINE(queue_stack, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS, STACK_SIZE);
+
+static struct k_work_q work_q;
+static struct k_work_q_worker workers[NUM_WORKERS];
+
+static struct k_work items[NUM_ITEMS];
+static atomic_t item_runs[NUM_ITEMS];
+static K_SEM_DEFINE(done_sem, 0, NUM_ITEMS);
+
+/* Given by the test thread to release a blocking work item. */
+static K_SEM_DEFINE(rel_sem, 0, 1);
+static atomic_t rel_done;
+
+static atomic_t inside;
+static atomic_t reentered;
+static atomic_t runs;
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+static void count_handler(struct k_work *work)
+{
+	atomic_inc(&item_runs[work - items]);
+	k_busy_wait(100);
+	k_sem_give(&done_sem);
+}
+
+static void rel_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_sem_take(&rel_sem, K_FOREVER);
+	atomic_set(&rel_done, 1);
+}
+
+static void reentrant_handler(struct k_work *work)
+{
+	if (!atomic_cas(&inside, 0, 1)) {
+		atomic_set(&reentered, 1);
+	}
+
+	k_busy_wait(50);
+	atomic_set(&inside, 0);
+
+	if (atomic_inc(&runs) < NUM_RUNS) {
+		(void)k_work_submit_to_queue(&work_q, work);
+	} else {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void release_timer_handler(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	k_sem_give(&rel_sem);
+}
+
+static K_TIMER_DEFINE(release_timer, release_timer_handler, NULL);
+
+static void *workers_setup(void)
+{
+	int cpu;
+
+	k_work_queue_start(&work_q, queue_stack,
+			   K_THREAD_STACK_SIZEOF(queue_stack),
+			   WORK_PRIORITY, NULL);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		cpu = IS_ENABLED(CONFIG_SCHED_CPU_MASK)
+		      ? ((i + 1) % arch_num_cpus()) : -1;
+
+		zassert_equal(k_work_queue_add_worker(&work_q, &workers[i],
+						      worker_stacks[i],
+						      K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+						      cpu),
+			      0, "add worker failed");
+	}
+
+	return NULL;
+}
+
+static void workers_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&done_sem);
+	k_sem_reset(&rel_sem);
+	atomic_clear(&rel_done);
+	atomic_clear(&inside);
+	atomic_clear(&reentered);
+	atomic_clear(&runs);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], count_handler);
+		atomic_clear(&item_runs[i]);
+	}
+}
+
+ZTEST(work_workers, test_add_worker_invalid)
+{
+	static struct k_work_q unstarted_q;
+	static struct k_work_q_worker worker;
+
+	zassert_equal(k_work_queue_add_worker(&unstarted_q, &worker,
+					      worker_stacks[0], STACK_SIZE,
+					      -1),
+		      -ENODEV);
+	zassert_equal(k_work_queue_add_worker(&work_q, &worker,
+					      worker_stacks[0], STACK_SIZE,
+					      arch_num_cpus()),
+		      -EINVAL);
+}
+
+ZTEST(work_workers, test_all_items_run)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_queue(&work_q, &items[i]), 1);
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_SECONDS(1)));
+	}
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(atomic_get(&item_runs[i]), 1,
+			      "item %d ran %ld times", i,
+			      (long)atomic_get(&item_runs[i]));
+	}
+}
+
+ZTEST(work_workers, test_no_reentrancy)
+{
+	k_work_init(&items[0], reentrant_handler);
+
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0]), 1);
+
+	/* Keep resubmitting from outside the queue as well, so that other
+	 * workers get a chance to pick the item while it is running.
+	 */
+	while (k_sem_take(&done_sem, K_NO_WAIT) != 0) {
+		(void)k_work_submit_to_queue(&work_q, &items[0]);
+		k_busy_wait(20);
+		k_yield();
+	}
+
+	(void)k_work_cancel_sync(&items[0], &work_sync);
+
+	zassert_false(atomic_get(&reentered), "work item ran concurrently");
+}
+
+ZTEST(work_workers, test_flush_running)
+{
+	k_work_init(&items[0], rel_handler);
+
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0]), 1);
+
+	/* Wait for the item to start */
+	while ((k_work_busy_get(&items[0]) & K_WORK_RUNNING) == 0) {
+		k_sleep(K_MSEC(1));
+	}
+
+	k_timer_start(&release_timer, K_MSEC(10), K_NO_WAIT);
+
+	zassert_true(k_work_flush(&items[0], &work_sync));
+	zassert_equal(atomic_get(&rel_done), 1, "flush returned early");
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+ZTEST(work_workers, test_flush_queued)
+{
+	/* Make all threads busy so that the flushed item stays queued */
+	for (int i = 0; i <= NUM_WORKERS + 1; i++) {
+		k_work_init(&items[i], rel_handler);
+		zassert_equal(k_work_submit_to_queue(&work_q, &items[i]), 1);
+	}
+
+	/* Release one blocked item at a time */
+	k_timer_start(&release_timer, K_MSEC(10), K_MSEC(10));
+
+	zassert_true(k_work_flush(&items[NUM_WORKERS + 1], &work_sync));
+	zassert_equal(k_work_busy_get(&items[NUM_WORKERS + 1]), 0);
+
+	zassert_true(k_work_queue_drain(&work_q, false) >= 0);
+	k_timer_stop(&release_timer);
+
+	for (int i = 0; i <= NUM_WORKERS + 1; i++) {
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+}
+
+ZTEST(work_workers, test_cancel_sync_running)
+{
+	k_work_init(&items[0], rel_handler);
+
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0]), 1);
+
+	while ((k_work_busy_get(&items[0]) & K_WORK_RUNNING) == 0) {
+		k_sleep(K_MSEC(1));
+	}
+
+	/* Resubmitted while running, the new instance must be cancelled
+	 * and the running one waited for.
+	 */
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0]), 2);
+
+	k_timer_start(&release_timer, K_MSEC(10), K_NO_WAIT);
+
+	zassert_true(k_work_cancel_sync(&items[0], &work_sync));
+	zassert_equal(atomic_get(&rel_done), 1, "cancel returned early");
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+}
+
+ZTEST(work_workers, test_drain)
+{
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(k_work_submit_to_queue(&work_q, &items[i]), 1);
+	}
+
+	zassert_true(k_work_queue_drain(&work_q, true) >= 0);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		zassert_equal(atomic_get(&item_runs[i]), 1);
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+	/* Plugged queue rejects submissions from outside */
+	zassert_equal(k_work_submit_to_queue(&work_q, &items[0]), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&work_q));
+}
+
+ZTEST_SUITE(work_workers, NULL, workers_setup, workers_before, NULL, NULL);
@@ -7,6 +7,7 @@
 #include <zephyr/ztest.h>
 #include <zephyr/sys/sys_heap.h>
 #include <zephyr/sys/heap_listener.h>
+#include <zephyr/sys/heap_cache.h>
 #include <inttypes.h>
 
 /* Guess at a value for heap size based on available memory on the
@@ -41,15 +42,6 @@
 #define BIG_HEAP_SZ MIN(256 * 1024, MEMSZ / 3)
 #define SMALL_HEAP_SZ MIN(BIG_HEAP_SZ, 2048)
 
-/* With enabling SYS_HEAP_RUNTIME_STATS, the size of struct z_heap
- * will increase 16 bytes on 64 bit CPU.
- */
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-#define SOLO_FREE_HEADER_HEAP_SZ (80)
-#else
-#define SOLO_FREE_HEADER_HEAP_SZ (64)
-#endif
-
 #define SCRATCH_SZ (sizeof(heapmem) / 2)
 
 /* The test memory.  Make them pointer arrays for robust alignment
@@ -158,6 +150,8 @@ static void log_result(size_t sz, struct z_heap_stress_result *r)
 		 "  avg usage: %d/%d (%d%%)\n",
 		 r->successful_allocs, r->total_allocs, succ_pct,
 		 r->total_frees, avg, (int) sz, avg_pct);
+	TC_PRINT("fragmented allocs: %d, allocs/sec: %d, max alloc: %d cycles\n",
+		 r->fragmented_allocs, r->allocs_per_sec, r->max_alloc_cycles);
 }
 
 /* Do a heavy test over a small heap, with many iterations that need
@@ -238,34 +232,85 @@ ZTEST(lib_heap, test_big_heap)
 	log_result(BIG_HEAP_SZ, &result);
 }
 
+static void *rawalloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void rawfree(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+/* Unchecked run of the stress test, so that the latency and
+ * fragmentation it reports reflect the allocator alone.  Compare the
+ * output across scenarios (e.g. with CONFIG_SYS_HEAP_TLSF).
+ */
+ZTEST(lib_heap, test_alloc_performance)
+{
+	struct sys_heap heap;
+	struct z_heap_stress_result result;
+
+	TC_PRINT("Measuring small (%d byte) heap at 90%% fill\n",
+		 (int) SMALL_HEAP_SZ);
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_stress(rawalloc, rawfree, &heap,
+			SMALL_HEAP_SZ, 4 * ITERATION_COUNT,
+			scratchmem, sizeof(scratchmem),
+			90, &result);
+
+	log_result(SMALL_HEAP_SZ, &result);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+}
+
 /* Test a heap with a solo free header.  A solo free header can exist
  * only on a heap with 64 bit CPU (or chunk_header_bytes() == 8).
- * With 64 bytes heap and 1 byte allocation on a big heap, we get:
+ * With a 1 byte allocation on a heap just big enough, we get:
  *
- *   0   1   2   3   4   5   6   7
- * | h | h | b | b | c | 1 | s | f |
+ *   0   1  ...  n  n+1 n+2 n+3
+ * | h | b | b | c | 1 | s | f |
  *
  * where
  * - h: chunk0 header
- * - b: buckets in chunk0
+ * - b: buckets (and bucket bitmaps with TLSF) in chunk0
  * - c: chunk header for the first allocation
  * - 1: chunk mem
  * - s: solo free header
  * - f: end marker / footer
+ *
+ * The size of chunk0 depends on the heap size and configuration, so
+ * grow the heap until the allocation leaves exactly one chunk unit
+ * before the footer.
  */
 ZTEST(lib_heap, test_solo_free_header)
 {
 	struct sys_heap heap;
+	uintptr_t end;
+	uint8_t *p;
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
-	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
-	if (sizeof(void *) > 4U) {
-		sys_heap_alloc(&heap, 1);
-		zassert_true(sys_heap_validate(&heap), "");
-	} else {
+	if (sizeof(void *) <= 4U) {
 		ztest_test_skip();
 	}
+
+	for (size_t sz = Z_HEAP_MIN_SIZE; sz <= SMALL_HEAP_SZ; sz += 8) {
+		sys_heap_init(&heap, heapmem, sz);
+		p = sys_heap_alloc(&heap, 1);
+		if (p == NULL) {
+			continue;
+		}
+
+		/* 8 byte header + 1 byte rounded up to 8, then the footer */
+		end = (uintptr_t)heapmem + sz - 8;
+		if (end - (uintptr_t)(p + 8) == 8U) {
+			zassert_true(sys_heap_validate(&heap), "");
+			return;
+		}
+	}
+
+	zassert_unreachable("no heap size leaves a solo free header");
 }
 
 /* Simple clobber detection */
@@ -387,6 +432,232 @@ ZTEST(lib_heap, test_realloc)
 		     "Realloc should have moved %p", p2);
 }
 
+static void *k_heap_testalloc(void *arg, size_t bytes)
+{
+	void *ret = k_heap_alloc(arg, bytes, K_NO_WAIT);
+
+	fill_block(ret, bytes);
+	return ret;
+}
+
+static void k_heap_testfree(void *arg, void *p)
+{
+	check_fill(p);
+	k_heap_free(arg, p);
+}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+static struct sys_heap_cache threaded_cache;
+#endif
+
+/* The same stress test run concurrently from several threads on a
+ * k_heap, through the cache if it is enabled.  This mostly reports
+ * throughput and fragmentation; consistency is checked at the end.
+ */
+ZTEST(lib_heap, test_threaded_stress)
+{
+	static struct k_heap heap;
+	struct z_heap_stress_result result;
+
+	TC_PRINT("Testing small (%d byte) heap from %d threads\n",
+		 (int) SMALL_HEAP_SZ, CONFIG_SYS_HEAP_STRESS_THREADS);
+
+	k_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	sys_heap_cache_init(&threaded_cache, &heap.heap, sizeof(void *));
+#endif
+	sys_heap_stress_threaded(k_heap_testalloc, k_heap_testfree, &heap,
+				 SMALL_HEAP_SZ, ITERATION_COUNT,
+				 scratchmem, sizeof(scratchmem),
+				 50, CONFIG_SYS_HEAP_STRESS_THREADS, &result);
+
+	log_result(SMALL_HEAP_SZ, &result);
+	zassert_true(result.successful_allocs > 0, "no allocation succeeded");
+	zassert_true(sys_heap_validate(&heap.heap), "invalid heap");
+}
+
+#ifdef CONFIG_SYS_HEAP_CACHE
+#define WAIT_HEAP_SZ 1024
+#define WAIT_BLOCK_SZ 32
+
+static struct k_heap wait_heap;
+static struct sys_heap_cache wait_cache;
+static void *wait_blocks[WAIT_HEAP_SZ / WAIT_BLOCK_SZ];
+static K_THREAD_STACK_DEFINE(wait_stack, 1024);
+static struct k_thread wait_thread;
+
+static void wait_freer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_heap_free(&wait_heap, p1);
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
+/* A thread blocked on an exhausted cached k_heap must be woken up by a
+ * free from another thread, although that block goes to a cache.
+ */
+ZTEST(lib_heap, test_k_heap_cache_wait)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	void *p;
+	int n;
+
+	k_heap_init(&wait_heap, heapmem, WAIT_HEAP_SZ);
+	sys_heap_cache_init(&wait_cache, &wait_heap.heap, sizeof(void *));
+
+	for (n = 0; n < (int)ARRAY_SIZE(wait_blocks); n++) {
+		wait_blocks[n] = k_heap_alloc(&wait_heap, WAIT_BLOCK_SZ,
+					      K_NO_WAIT);
+		if (wait_blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > 0, "no block allocated");
+	zassert_true(n < (int)ARRAY_SIZE(wait_blocks), "heap not exhausted");
+	zassert_is_null(k_heap_alloc(&wait_heap, WAIT_BLOCK_SZ, K_NO_WAIT), "");
+
+	k_thread_create(&wait_thread, wait_stack,
+			K_THREAD_STACK_SIZEOF(wait_stack), wait_freer,
+			wait_blocks[0], NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_MSEC(10));
+
+	p = k_heap_alloc(&wait_heap, WAIT_BLOCK_SZ, K_SECONDS(5));
+	zassert_not_null(p, "allocation not woken up by the free");
+	zassert_ok(k_thread_join(&wait_thread, K_FOREVER), "");
+
+	k_heap_free(&wait_heap, p);
+	for (int i = 1; i < n; i++) {
+		k_heap_free(&wait_heap, wait_blocks[i]);
+	}
+	zassert_equal(atomic_get(&wait_heap.waiters), 0, "");
+	zassert_true(sys_heap_validate(&wait_heap.heap), "invalid heap");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_CACHE */
+}
+
+ZTEST(lib_heap, test_heap_cache)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	static struct sys_heap_cache cache;
+	struct sys_heap heap;
+	struct sys_memory_stats stats;
+	void *blocks[2 * CONFIG_SYS_HEAP_CACHE_BATCH];
+	void *p, *list;
+	bool overflowed;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_cache_init(&cache, &heap, sizeof(void *));
+
+	/* Cold cache: the first allocation refills it */
+	zassert_is_null(sys_heap_cache_alloc(&heap, 0, 24), "");
+	p = sys_heap_cache_refill(&heap, 0, 24);
+	zassert_not_null(p, "refill failed");
+	zassert_true(sys_heap_usable_size(&heap, p) >= 24, "block too small");
+
+	/* The rest of the batch is now served without the heap */
+	for (int i = 1; i < CONFIG_SYS_HEAP_CACHE_BATCH; i++) {
+		blocks[i] = sys_heap_cache_alloc(&heap, 0, 32);
+		zassert_not_null(blocks[i], "cache miss %d", i);
+	}
+	zassert_is_null(sys_heap_cache_alloc(&heap, 0, 32), "");
+
+	/* Over-aligned and large requests bypass the cache */
+	zassert_is_null(sys_heap_cache_alloc(&heap, 64, 8), "");
+	zassert_is_null(sys_heap_cache_alloc(&heap, 0, SMALL_HEAP_SZ / 2), "");
+
+	/* Cached blocks count as free */
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_true(stats.allocated_bytes >=
+		     CONFIG_SYS_HEAP_CACHE_BATCH * 32, "");
+	zassert_true(stats.allocated_bytes <
+		     CONFIG_SYS_HEAP_CACHE_BATCH * 64, "");
+
+	blocks[0] = p;
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_BATCH; i++) {
+		zassert_is_null(sys_heap_cache_free(&heap, blocks[i]), "");
+	}
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.allocated_bytes, 0, "cached blocks counted");
+
+	/* Overflowing the bin hands a batch back for flushing */
+	for (int i = 0; i < 2 * CONFIG_SYS_HEAP_CACHE_BATCH; i++) {
+		blocks[i] = sys_heap_alloc(&heap, 32);
+		zassert_not_null(blocks[i], "");
+	}
+	overflowed = false;
+	for (int i = 0; i < 2 * CONFIG_SYS_HEAP_CACHE_BATCH; i++) {
+		list = sys_heap_cache_free(&heap, blocks[i]);
+		if (list != NULL) {
+			overflowed = true;
+			sys_heap_cache_flush(&heap, list);
+		}
+	}
+	zassert_true(overflowed, "cache never overflowed");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	/* Draining gives everything back */
+	sys_heap_cache_drain(&heap);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.allocated_bytes, 0, "");
+	zassert_equal(atomic_get(&cache.cached_bytes), 0, "");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_CACHE */
+}
+
+/* A request too large for the cache must still see the memory held in
+ * the caches, so the heap has to be drained before it fails.
+ */
+ZTEST(lib_heap, test_heap_cache_drain_large)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Largest block size the cache holds */
+#define CACHE_MAX_BLOCK (8 << (CONFIG_SYS_HEAP_CACHE_CLASSES - 1))
+	static struct sys_heap_cache cache;
+	static void *blocks[SMALL_HEAP_SZ / CACHE_MAX_BLOCK + 1];
+	struct sys_heap heap;
+	void *p, *list;
+	int n;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	sys_heap_cache_init(&cache, &heap, sizeof(void *));
+
+	/* Take the whole heap through the cache, then park it there */
+	for (n = 0; n < (int)ARRAY_SIZE(blocks); n++) {
+		p = sys_heap_cache_alloc(&heap, 0, CACHE_MAX_BLOCK);
+		if (p == NULL) {
+			p = sys_heap_cache_refill(&heap, 0, CACHE_MAX_BLOCK);
+		}
+		if (p == NULL) {
+			break;
+		}
+		blocks[n] = p;
+	}
+	zassert_true(n > 0, "no block allocated");
+	zassert_true(n < (int)ARRAY_SIZE(blocks), "heap not exhausted");
+
+	for (int i = 0; i < n; i++) {
+		list = sys_heap_cache_free(&heap, blocks[i]);
+		sys_heap_cache_flush(&heap, list);
+	}
+	zassert_true(atomic_get(&cache.cached_bytes) > 0, "nothing cached");
+
+	p = sys_heap_cache_refill(&heap, 0, SMALL_HEAP_SZ / 2);
+	zassert_not_null(p, "large allocation failed with cached memory");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	sys_heap_free(&heap, p);
+
+	sys_heap_cache_drain(&heap);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_CACHE */
+}
+
 #ifdef CONFIG_SYS_HEAP_LISTENER
 static struct sys_heap listener_heap;
 static uintptr_t listener_heap_id;
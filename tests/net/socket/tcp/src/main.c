@@ -2415,6 +2415,98 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC)
+#define TCP_CA_DEFAULT "cubic"
+#elif defined(CONFIG_NET_TCP_CONGESTION_DEFAULT_BBR)
+#define TCP_CA_DEFAULT "bbr"
+#else
+#define TCP_CA_DEFAULT "reno"
+#endif
+
+static void check_tcp_congestion(int sock, const char *expected)
+{
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int ret;
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, expected, "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(expected) + 1, "getsockopt got invalid size");
+}
+
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in c_saddr, s_saddr;
+	int c_sock, s_sock, new_sock;
+	char name[16];
+	socklen_t optlen;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+		ztest_test_skip();
+	}
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	check_tcp_congestion(c_sock, TCP_CA_DEFAULT);
+
+	/* The name is truncated to the buffer */
+	optlen = 2;
+	ret = zsock_getsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optlen, 2, "getsockopt got invalid size");
+	zassert_mem_equal(name, TCP_CA_DEFAULT, 2, "getsockopt got invalid value");
+
+	/* The terminating NUL is optional */
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "reno", strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	check_tcp_congestion(c_sock, "reno");
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "vegas", sizeof("vegas"));
+	zassert_equal(ret, -1, "setsockopt of an unknown algorithm succeeded");
+	zassert_equal(errno, ENOENT, "setsockopt failed with %d", errno);
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, NULL, sizeof("reno"));
+	zassert_equal(ret, -1, "setsockopt without a name succeeded");
+	zassert_equal(errno, EINVAL, "setsockopt failed with %d", errno);
+
+	ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "reno", 0);
+	zassert_equal(ret, -1, "setsockopt of an empty name succeeded");
+	zassert_equal(errno, EINVAL, "setsockopt failed with %d", errno);
+
+	check_tcp_congestion(c_sock, "reno");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_CUBIC)) {
+		/* Accepted connections use the algorithm of their listener */
+		ret = zsock_setsockopt(s_sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				       sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+		test_listen(s_sock);
+		test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+		test_accept(s_sock, &new_sock, NULL, NULL);
+
+		check_tcp_congestion(new_sock, "cubic");
+		check_tcp_congestion(c_sock, "reno");
+
+		/* And it can be changed on an established connection */
+		ret = zsock_setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				       sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+		check_tcp_congestion(c_sock, "cubic");
+
+		test_close(new_sock);
+	}
+
+	test_close(c_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -2531,6 +2531,113 @@ ZTEST(net_socket_udp, test_37_ipv6_src_addr_select)
 				       &my_addr3, &dest);
 }
 
+#define MMSG_COUNT 3
+
+ZTEST(net_socket_udp, test_38_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[MMSG_COUNT] = {
+		"first", "second", "third",
+	};
+	struct timespec timeout = { .tv_sec = 1 };
+	struct sockaddr_in addrs[MMSG_COUNT];
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec iov[MMSG_COUNT];
+	char bufs[MMSG_COUNT][16];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int64_t start;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock, (struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = zsock_bind(client_sock, (struct sockaddr *)&client_addr,
+			sizeof(client_addr));
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = (void *)payloads[i];
+		iov[i].iov_len = strlen(payloads[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "invalid sent length");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_base = bufs[i];
+		iov[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, MMSG_COUNT, 0, &timeout);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "invalid received length");
+		zassert_mem_equal(bufs[i], payloads[i], msgs[i].msg_len,
+				  "invalid received data");
+		zassert_equal(addrs[i].sin_port, client_addr.sin_port,
+			      "invalid source port");
+	}
+
+	/* Nothing is left, the call gives up after the timeout */
+	timeout.tv_sec = 0;
+	timeout.tv_nsec = 100 * NSEC_PER_MSEC;
+	iov[0].iov_len = sizeof(bufs[0]);
+	msgs[0].msg_hdr.msg_namelen = sizeof(addrs[0]);
+
+	start = k_uptime_get();
+	rv = zsock_recvmmsg(server_sock, msgs, 1, 0, &timeout);
+	zassert_equal(rv, -1, "recvmmsg should fail");
+	zassert_equal(errno, EAGAIN, "unexpected errno (%d)", errno);
+	zassert_true(k_uptime_get() - start >= 100, "returned too early");
+
+	/* With MSG_WAITFORONE, one datagram is enough */
+	rv = zsock_sendto(client_sock, payloads[0], strlen(payloads[0]), 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, strlen(payloads[0]), "sendto failed");
+
+	for (int i = 0; i < MMSG_COUNT; i++) {
+		iov[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, MMSG_COUNT, ZSOCK_MSG_WAITFORONE,
+			    NULL);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+	zassert_equal(msgs[0].msg_len, strlen(payloads[0]),
+		      "invalid received length");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
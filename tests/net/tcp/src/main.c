@@ -114,6 +114,7 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_SERVER_OPTIONS_IPV6 = 19,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +139,10 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+static void handle_server_options_test(struct net_pkt *pkt, struct tcphdr *th);
+#endif
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -235,6 +240,10 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options sent by the peer on every segment, when set */
+static uint8_t peer_options[40];
+static size_t peer_options_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -250,6 +259,8 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == TEST_SERVER_OPTIONS_IPV6) {
+		opts_len = peer_options_len;
 	}
 
 	/* Allocate buffer */
@@ -284,11 +295,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = NET_IPV6_MTU;
@@ -309,6 +316,11 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		if (ret < 0) {
 			goto fail;
 		}
+	} else if (opts_len > 0) {
+		ret = net_pkt_write(pkt, peer_options, opts_len);
+		if (ret < 0) {
+			goto fail;
+		}
 	}
 
 	if (data && len) {
@@ -490,6 +502,12 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+	case TEST_SERVER_OPTIONS_IPV6:
+		handle_server_options_test(pkt, &th);
+		break;
+#endif
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -2012,7 +2030,7 @@ ZTEST(net_tcp, test_client_invalid_rst)
 {
 	struct net_context *ctx;
 	struct tcp *conn;
-	uint16_t wnd;
+	uint32_t wnd;
 
 	ctx = create_server_socket(0, 0);
 
@@ -2602,4 +2620,347 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE) && defined(CONFIG_NET_TCP_TIMESTAMPS) && \
+	defined(CONFIG_NET_TCP_SACK)
+#define PEER_WSCALE 7
+#define PEER_TSVAL  1000U
+
+/* Last segment sent by the server, with its options */
+static struct tcphdr server_th;
+static uint8_t server_options[40];
+static size_t server_options_len;
+static size_t server_data_len;
+static uint32_t server_tsval;
+
+/* Find an option of the last segment sent by the server */
+static const uint8_t *server_option_find(uint8_t kind)
+{
+	size_t i = 0;
+
+	while (i < server_options_len) {
+		if (server_options[i] == NET_TCP_END_OPT) {
+			break;
+		}
+
+		if (server_options[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (server_options[i] == kind) {
+			return &server_options[i];
+		}
+
+		if (server_options[i + 1] < 2U) {
+			break;
+		}
+
+		i += server_options[i + 1];
+	}
+
+	return NULL;
+}
+
+static void handle_server_options_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	const uint8_t *opt;
+
+	server_th = *th;
+	server_options_len = (th->th_off - 5U) * 4U;
+	server_data_len = net_pkt_get_len(pkt) - hdr_len - th->th_off * 4U;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, hdr_len + sizeof(struct tcphdr)) < 0 ||
+	    net_pkt_read(pkt, server_options, server_options_len) < 0) {
+		zassert_true(false, "%s failed", __func__);
+	}
+
+	opt = server_option_find(NET_TCP_TIMESTAMP_OPT);
+	if (opt != NULL) {
+		server_tsval = ntohl(UNALIGNED_GET((uint32_t *)(opt + 2)));
+	}
+
+	test_sem_give();
+}
+
+/* Set the options of the next segments sent by the peer: the SYN ones,
+ * a timestamp, and a SACK block if it is not empty.
+ */
+static void peer_options_set(bool syn, uint32_t tsval, uint32_t sack_start,
+			     uint32_t sack_end)
+{
+	uint8_t *buf = peer_options;
+
+	if (syn) {
+		*buf++ = NET_TCP_MSS_OPT;
+		*buf++ = NET_TCP_MSS_SIZE;
+		UNALIGNED_PUT(htons(1460), (uint16_t *)buf);
+		buf += 2;
+
+		*buf++ = NET_TCP_NOP_OPT;
+		*buf++ = NET_TCP_WINDOW_SCALE_OPT;
+		*buf++ = NET_TCP_WINDOW_SCALE_SIZE;
+		*buf++ = PEER_WSCALE;
+
+		*buf++ = NET_TCP_NOP_OPT;
+		*buf++ = NET_TCP_NOP_OPT;
+		*buf++ = NET_TCP_SACK_PERM_OPT;
+		*buf++ = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	*buf++ = NET_TCP_NOP_OPT;
+	*buf++ = NET_TCP_NOP_OPT;
+	*buf++ = NET_TCP_TIMESTAMP_OPT;
+	*buf++ = NET_TCP_TIMESTAMP_SIZE;
+	UNALIGNED_PUT(htonl(tsval), (uint32_t *)buf);
+	UNALIGNED_PUT(htonl(syn ? 0U : server_tsval), (uint32_t *)(buf + 4));
+	buf += 8;
+
+	if (sack_start != sack_end) {
+		*buf++ = NET_TCP_NOP_OPT;
+		*buf++ = NET_TCP_NOP_OPT;
+		*buf++ = NET_TCP_SACK_OPT;
+		*buf++ = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(sack_start), (uint32_t *)buf);
+		UNALIGNED_PUT(htonl(sack_end), (uint32_t *)(buf + 4));
+		buf += 8;
+	}
+
+	peer_options_len = buf - peer_options;
+}
+
+static uint32_t server_tsecr(void)
+{
+	const uint8_t *opt = server_option_find(NET_TCP_TIMESTAMP_OPT);
+
+	zassert_not_null(opt, "No timestamp sent");
+
+	return ntohl(UNALIGNED_GET((uint32_t *)(opt + 6)));
+}
+
+static void peer_send(struct net_pkt *pkt)
+{
+	zassert_not_null(pkt, "Cannot create pkt");
+	zassert_ok(net_recv_data(net_iface, pkt), "recv data failed");
+}
+
+/* Open a connection to a listening server, with all options offered */
+static struct net_context *options_conn_open(void)
+{
+	struct net_context *ctx;
+	const uint8_t *opt;
+
+	test_case_no = TEST_SERVER_OPTIONS_IPV6;
+	seq = ack = 0;
+	k_sem_reset(&test_sem);
+
+	zassert_ok(net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+	net_context_ref(ctx);
+	zassert_ok(net_context_bind(ctx, (struct sockaddr *)&my_addr_v6_s,
+				    sizeof(struct sockaddr_in6)),
+		   "Failed to bind net_context");
+	zassert_ok(net_context_listen(ctx, 1), "Failed to listen on net_context");
+	zassert_ok(net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL),
+		   "Failed to set accept on net_context");
+
+	peer_options_set(true, PEER_TSVAL, 0, 0);
+	peer_send(prepare_syn_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+
+	/* The SYN-ACK offers all the options back */
+	test_sem_take(K_MSEC(100), __LINE__);
+	test_verify_flags(&server_th, SYN | ACK);
+
+	opt = server_option_find(NET_TCP_MSS_OPT);
+	zassert_not_null(opt, "No MSS sent");
+	opt = server_option_find(NET_TCP_WINDOW_SCALE_OPT);
+	zassert_not_null(opt, "No window scale sent");
+	zassert_true(opt[2] <= NET_TCP_MAX_WINDOW_SCALE, "Invalid shift %u", opt[2]);
+	zassert_not_null(server_option_find(NET_TCP_SACK_PERM_OPT), "No SACK permitted sent");
+	zassert_equal(server_tsecr(), PEER_TSVAL, "SYN timestamp not echoed");
+
+	seq++;
+	ack = ntohl(server_th.th_seq) + 1U;
+
+	peer_options_set(false, PEER_TSVAL + 1U, 0, 0);
+	peer_send(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+
+	/* test_tcp_accept_cb() releases the semaphore */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	return ctx;
+}
+
+static void options_conn_close(struct net_context *ctx)
+{
+	peer_options_len = 0;
+	peer_send(prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Test that the options of the SYN are parsed and agreed on */
+ZTEST(net_tcp, test_server_options_ipv6)
+{
+	struct net_context *ctx = options_conn_open();
+	struct tcp *conn = accepted_ctx->tcp;
+
+	zassert_true(conn->wscale_ok, "Window scaling not agreed");
+	zassert_equal(conn->snd_wscale, PEER_WSCALE, "Wrong send window shift");
+	zassert_true(conn->ts_ok, "Timestamps not agreed");
+	zassert_equal(conn->ts_recent, PEER_TSVAL + 1U, "Timestamp not recorded");
+	zassert_true(conn->sack_ok, "SACK not agreed");
+	zassert_equal(conn->recv_options.mss, 1460, "Wrong MSS");
+
+	/* Windows received after the SYN are scaled. The peer writes its
+	 * window field in host byte order.
+	 */
+	zassert_equal(conn->send_win, MIN((uint32_t)ntohs(NET_IPV6_MTU) << PEER_WSCALE,
+					  conn->send_win_max),
+		      "Window not scaled");
+
+	options_conn_close(ctx);
+}
+
+/* Test that a segment with an old timestamp is dropped and acked */
+ZTEST(net_tcp, test_server_paws_ipv6)
+{
+	struct net_context *ctx = options_conn_open();
+	struct tcp *conn = accepted_ctx->tcp;
+	int drop_before;
+
+	peer_options_set(false, PEER_TSVAL + 2U, 0, 0);
+	peer_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT), "A", 1U));
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(ntohl(server_th.th_ack), seq + 1U, "Data not acked");
+	zassert_equal(server_tsecr(), PEER_TSVAL + 2U, "Timestamp not echoed");
+	seq++;
+
+	drop_before = GET_STAT(net_iface, tcp.seg_drop);
+
+	/* Older than the last timestamp: dropped, and the ACK is resent */
+	peer_options_set(false, PEER_TSVAL, 0, 0);
+	peer_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT), "B", 1U));
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(ntohl(server_th.th_ack), seq, "Old segment accepted");
+	zassert_equal(server_tsecr(), PEER_TSVAL + 2U, "Old timestamp recorded");
+	zassert_equal(GET_STAT(net_iface, tcp.seg_drop), drop_before + 1,
+		      "Old segment not counted as dropped");
+	zassert_equal(conn->ts_recent, PEER_TSVAL + 2U, "Old timestamp recorded");
+
+	/* The same data with a newer timestamp is accepted */
+	peer_options_set(false, PEER_TSVAL + 3U, 0, 0);
+	peer_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT), "B", 1U));
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(ntohl(server_th.th_ack), seq + 1U, "Data not acked");
+	seq++;
+
+	options_conn_close(ctx);
+}
+
+/* Test that out-of-order data is SACKed, and that received SACK blocks are
+ * merged into the scoreboard and drive the recovery.
+ */
+ZTEST(net_tcp, test_server_sack_ipv6)
+{
+	struct net_context *ctx = options_conn_open();
+	struct tcp *conn = accepted_ctx->tcp;
+	const uint8_t *opt;
+	uint32_t snd;
+	int ret;
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT > 0) {
+		/* A byte is missing: the ACK does not move, the data is SACKed */
+		seq++;
+		peer_options_set(false, PEER_TSVAL + 2U, 0, 0);
+		peer_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					      "D", 1U));
+
+		test_sem_take(K_MSEC(100), __LINE__);
+		zassert_equal(ntohl(server_th.th_ack), seq - 1U, "Gap acked");
+
+		opt = server_option_find(NET_TCP_SACK_OPT);
+		zassert_not_null(opt, "No SACK sent");
+		zassert_equal(opt[1], 2 + NET_TCP_SACK_BLOCK_SIZE, "Wrong SACK length");
+		zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)(opt + 2))), seq,
+			      "Wrong SACK start");
+		zassert_equal(ntohl(UNALIGNED_GET((uint32_t *)(opt + 6))), seq + 1U,
+			      "Wrong SACK end");
+
+		/* Filling the gap acks both bytes, and nothing is SACKed */
+		seq--;
+		peer_send(prepare_data_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT),
+					      "C", 1U));
+
+		test_sem_take(K_MSEC(100), __LINE__);
+		zassert_equal(ntohl(server_th.th_ack), seq + 2U, "Gap not filled");
+		zassert_is_null(server_option_find(NET_TCP_SACK_OPT), "SACK sent");
+		seq += 2U;
+	}
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, 30, NULL, K_NO_WAIT, NULL);
+	zassert_equal(ret, 30, "Failed to send data (%d)", ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+	zassert_equal(server_data_len, 30, "Data not sent in one segment");
+	snd = ntohl(server_th.th_seq);
+	zassert_equal(snd, ack, "Unexpected sequence number");
+
+	/* Duplicate ACKs, each SACKing a part of the data */
+	peer_options_set(false, PEER_TSVAL + 4U, snd + 10U, snd + 20U);
+	peer_send(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	k_msleep(10);
+
+	zassert_equal(conn->sack_block_cnt, 1, "SACK block not recorded");
+	zassert_equal(conn->sack_blocks[0].start, snd + 10U, "Wrong block start");
+	zassert_equal(conn->sack_blocks[0].end, snd + 20U, "Wrong block end");
+
+	peer_options_set(false, PEER_TSVAL + 4U, snd + 20U, snd + 30U);
+	peer_send(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	k_msleep(10);
+
+	zassert_equal(conn->sack_block_cnt, 1, "Adjacent blocks not merged");
+	zassert_equal(conn->sack_blocks[0].start, snd + 10U, "Wrong block start");
+	zassert_equal(conn->sack_blocks[0].end, snd + 30U, "Wrong block end");
+
+	/* A block beyond the data sent is ignored, and the third duplicate
+	 * ACK only resends the hole below the SACKed data.
+	 */
+	peer_options_set(false, PEER_TSVAL + 4U, snd + 30U, snd + 40U);
+	peer_send(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+
+	if (IS_ENABLED(CONFIG_NET_TCP_FAST_RETRANSMIT)) {
+		test_sem_take(K_MSEC(100), __LINE__);
+		zassert_equal(ntohl(server_th.th_seq), snd, "Hole not resent");
+		zassert_equal(server_data_len, 10, "More than the hole resent");
+	} else {
+		k_msleep(10);
+	}
+
+	zassert_equal(conn->sack_block_cnt, 1, "Invalid block recorded");
+	zassert_equal(conn->sack_blocks[0].end, snd + 30U, "Invalid block merged");
+
+	/* The cumulative ACK empties the scoreboard */
+	ack = snd + 30U;
+	peer_options_set(false, PEER_TSVAL + 5U, 0, 0);
+	peer_send(prepare_ack_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT)));
+	k_msleep(10);
+
+	zassert_equal(conn->sack_block_cnt, 0, "Scoreboard not emptied");
+	zassert_false(conn->in_recovery, "Recovery not ended");
+
+	options_conn_close(ctx);
+}
+#endif /* CONFIG_NET_TCP_WINDOW_SCALE && CONFIG_NET_TCP_TIMESTAMPS && CONFIG_NET_TCP_SACK */
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
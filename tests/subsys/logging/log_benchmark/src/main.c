@@ -47,6 +47,11 @@ struct backend_cb {
 static void process(struct log_backend const *const backend,
 		    union log_msg_generic *msg)
 {
+	struct backend_cb *cb = (struct backend_cb *)backend->cb->ctx;
+
+	if (cb != NULL) {
+		cb->counter++;
+	}
 }
 
 static void panic(struct log_backend const *const backend)
@@ -230,13 +235,101 @@ ZTEST(test_log_benchmark, test_log_message_with_string)
 		cyc / repeat, us / repeat);
 }
 
+#ifdef CONFIG_SCHED_CPU_MASK
+#define THROUGHPUT_ROUNDS 20
+#define THROUGHPUT_BURST 32
+#define THROUGHPUT_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   THROUGHPUT_STACK_SIZE);
+static struct k_thread producer_threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t producer_cyc[CONFIG_MP_MAX_NUM_CPUS];
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t cyc = test_helpers_cycle_get();
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < THROUGHPUT_BURST; i++) {
+		LOG_ERR("test %d %d", id, i);
+	}
+
+	producer_cyc[id] += test_helpers_cycle_get() - cyc;
+}
+#endif
+
+/** Log bursts from every CPU at once, then process them.
+ *
+ * Reports the rate at which each CPU stores messages and the share of
+ * messages which were dropped.
+ */
+ZTEST(test_log_benchmark, test_log_throughput_per_cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	unsigned int cpus = arch_num_cpus();
+	uint32_t total = cpus * THROUGHPUT_ROUNDS * THROUGHPUT_BURST;
+	uint32_t per_cpu = THROUGHPUT_ROUNDS * THROUGHPUT_BURST;
+	int prio = k_thread_priority_get(k_current_get());
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		producer_cyc[i] = 0;
+	}
+
+	test_helpers_log_setup();
+	backend_ctrl_blk.counter = 0;
+	log_backend_enable(&backend, &backend_ctrl_blk, LOG_LEVEL_DBG);
+
+	for (int round = 0; round < THROUGHPUT_ROUNDS; round++) {
+		for (unsigned int i = 0; i < cpus; i++) {
+			k_thread_create(&producer_threads[i], producer_stacks[i],
+					THROUGHPUT_STACK_SIZE, producer,
+					INT_TO_POINTER(i), NULL, NULL, prio - 1, 0,
+					K_FOREVER);
+			zassert_ok(k_thread_cpu_pin(&producer_threads[i], i));
+		}
+
+		for (unsigned int i = 0; i < cpus; i++) {
+			k_thread_start(&producer_threads[i]);
+		}
+
+		for (unsigned int i = 0; i < cpus; i++) {
+			k_thread_join(&producer_threads[i], K_FOREVER);
+		}
+
+		while (log_process()) {
+		}
+	}
+
+	log_backend_disable(&backend);
+
+	for (unsigned int i = 0; i < cpus; i++) {
+		uint32_t us = k_cyc_to_us_ceil32(producer_cyc[i]);
+
+		PRINT("CPU %u: %u messages/s (%u cycles per message)\n", i,
+		      us ? (uint32_t)(((uint64_t)per_cpu * USEC_PER_SEC) / us) : 0,
+		      producer_cyc[i] / per_cpu);
+	}
+
+	PRINT("%sPer-CPU buffers: %u of %u messages dropped (%u%%)\n",
+	      IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS) ? "" : "No ",
+	      total - backend_ctrl_blk.counter, total,
+	      ((total - backend_ctrl_blk.counter) * 100U) / total);
+#else
+	ztest_test_skip();
+#endif
+}
+
 /*test case main entry*/
 static void *log_benchmark_setup(void)
 {
 	PRINT("LOGGING MODE:%s\n", IS_ENABLED(CONFIG_LOG_MODE_DEFERRED) ? "DEFERRED" : "IMMEDIATE");
 	PRINT("\tOVERWRITE: %d\n", IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW));
 	PRINT("\tBUFFER_SIZE: %d\n", CONFIG_LOG_BUFFER_SIZE);
-	PRINT("\tSPEED: %d", IS_ENABLED(CONFIG_LOG_SPEED));
+	PRINT("\tSPEED: %d\n", IS_ENABLED(CONFIG_LOG_SPEED));
+	PRINT("\tPER_CPU_BUFFERS: %d", IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS));
 
 	return NULL;
 }
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2024 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/ztest.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/profiling/sampler.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/mgmt/mcumgr/mgmt/mgmt.h>
+#include <zephyr/mgmt/mcumgr/transport/smp_dummy.h>
+#include <zephyr/mgmt/mcumgr/grp/zephyr/zephyr_profiling.h>
+#include <zcbor_common.h>
+#include <zcbor_decode.h>
+#include <zcbor_encode.h>
+#include <mgmt/mcumgr/util/zcbor_bulk.h>
+#include <smp_internal.h>
+
+#define SAMPLER_FREQUENCY      100
+#define SAMPLER_SPIN_MS        500
+#define SMP_RESPONSE_WAIT_TIME 3
+#define ZCBOR_BUFFER_SIZE      64
+#define ZCBOR_HISTORY_SIZE     4
+
+/* Payload of the requests which take no argument */
+static const uint8_t empty_map[] = { 0xa0 };
+
+/*
+ * Keeps the CPU in this function, which is then expected at the top of
+ * the histogram for the test thread.
+ */
+static __noinline void sampler_test_spin(uint32_t ms)
+{
+	int64_t end = k_uptime_get() + ms;
+
+	while (k_uptime_get() < end) {
+		for (volatile int i = 0; i < 10000; i++) {
+		}
+	}
+}
+
+static void sampler_test_check_top(void)
+{
+	struct profiling_sampler_entry entries[4];
+	size_t count;
+
+	count = profiling_sampler_top(entries, ARRAY_SIZE(entries));
+	zassert_true(count > 0, "no sample counted");
+
+	for (size_t i = 1; i < count; i++) {
+		zassert_true(entries[i - 1].count >= entries[i].count,
+			     "entries are not sorted");
+	}
+
+	zassert_equal(entries[0].thread, k_current_get());
+	zassert_str_equal(entries[0].func, "sampler_test_spin");
+}
+
+ZTEST(sampler, test_histogram)
+{
+	struct profiling_sampler_entry entry;
+	struct profiling_sampler_stats stats;
+	uint32_t samples;
+
+	zassert_equal(profiling_sampler_start(0), -EINVAL);
+	zassert_equal(profiling_sampler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1),
+		      -EINVAL);
+
+	zassert_ok(profiling_sampler_start(SAMPLER_FREQUENCY));
+	profiling_sampler_stats_get(&stats);
+	zassert_equal(stats.frequency, SAMPLER_FREQUENCY);
+
+	sampler_test_spin(SAMPLER_SPIN_MS);
+	profiling_sampler_stop();
+
+	profiling_sampler_stats_get(&stats);
+	zassert_equal(stats.frequency, 0U);
+	zassert_true(stats.samples >= SAMPLER_FREQUENCY * SAMPLER_SPIN_MS / MSEC_PER_SEC / 2,
+		     "only %u samples taken", stats.samples);
+	zassert_true(stats.dropped < stats.samples, "all samples dropped");
+
+	sampler_test_check_top();
+
+	/* The samples are kept while stopped */
+	samples = stats.samples;
+	k_msleep(100);
+	profiling_sampler_stats_get(&stats);
+	zassert_equal(stats.samples, samples);
+
+	profiling_sampler_reset();
+	profiling_sampler_stats_get(&stats);
+	zassert_equal(stats.samples, 0U);
+	zassert_equal(stats.dropped, 0U);
+	zassert_equal(profiling_sampler_top(&entry, 1), 0);
+}
+
+ZTEST(sampler, test_shell)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+	const char *buf;
+	size_t size;
+
+	zassert_not_ok(shell_execute_cmd(sh, "sampler start 0"));
+
+	zassert_ok(shell_execute_cmd(sh, "sampler start 100"));
+	sampler_test_spin(SAMPLER_SPIN_MS);
+	zassert_ok(shell_execute_cmd(sh, "sampler stop"));
+
+	sampler_test_check_top();
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_ok(shell_execute_cmd(sh, "sampler info"));
+	buf = shell_backend_dummy_get_output(sh, &size);
+	zassert_not_null(strstr(buf, "Stopped"), "unexpected output: %s", buf);
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_ok(shell_execute_cmd(sh, "sampler top 1"));
+	buf = shell_backend_dummy_get_output(sh, &size);
+	zassert_not_null(strstr(buf, "sampler_test_spin"), "unexpected output: %s", buf);
+
+	zassert_ok(shell_execute_cmd(sh, "sampler reset"));
+	shell_backend_dummy_clear_output(sh);
+	zassert_ok(shell_execute_cmd(sh, "sampler info"));
+	buf = shell_backend_dummy_get_output(sh, &size);
+	zassert_not_null(strstr(buf, "Samples: 0, dropped: 0"), "unexpected output: %s", buf);
+}
+
+/* Sends an SMP request to the profiling group and returns the response */
+static struct net_buf *sampler_test_smp(uint8_t id, bool write, const uint8_t *payload,
+					size_t len)
+{
+	uint8_t request[sizeof(struct smp_hdr) + ZCBOR_BUFFER_SIZE];
+	struct smp_hdr *hdr = (struct smp_hdr *)request;
+	struct net_buf *nb;
+
+	*hdr = (struct smp_hdr) {
+		.nh_len = sys_cpu_to_be16(len),
+		.nh_version = SMP_MCUMGR_VERSION_1,
+		.nh_op = write ? MGMT_OP_WRITE : MGMT_OP_READ,
+		.nh_group = sys_cpu_to_be16(ZEPHYR_MGMT_GRP_PROFILING),
+		.nh_seq = 1,
+		.nh_id = id,
+	};
+	memcpy(&request[sizeof(*hdr)], payload, len);
+
+	smp_dummy_enable();
+	smp_dummy_clear_state();
+
+	(void)smp_dummy_tx_pkt(request, sizeof(*hdr) + len);
+	smp_dummy_add_data();
+
+	zassert_true(smp_dummy_wait_for_data(SMP_RESPONSE_WAIT_TIME),
+		     "Expected to receive data but timed out");
+
+	nb = smp_dummy_get_outgoing();
+	smp_dummy_disable();
+
+	(void)net_buf_pull(nb, sizeof(struct smp_hdr));
+
+	return nb;
+}
+
+static struct net_buf *sampler_test_smp_freq(uint32_t frequency)
+{
+	zcbor_state_t zse[ZCBOR_HISTORY_SIZE];
+	uint8_t payload[ZCBOR_BUFFER_SIZE];
+	bool ok;
+
+	zcbor_new_encode_state(zse, ARRAY_SIZE(zse), payload, sizeof(payload), 0);
+	ok = zcbor_map_start_encode(zse, 1)	&&
+	     zcbor_tstr_put_lit(zse, "freq")	&&
+	     zcbor_uint32_put(zse, frequency)	&&
+	     zcbor_map_end_encode(zse, 1);
+	zassert_true(ok, "Expected packet creation to be successful");
+
+	return sampler_test_smp(ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLER, true, payload,
+				zse->payload_mut - payload);
+}
+
+static int32_t sampler_test_smp_rc(struct net_buf *nb)
+{
+	zcbor_state_t zsd[ZCBOR_HISTORY_SIZE];
+	size_t decoded = 0;
+	int32_t rc = 0;
+
+	struct zcbor_map_decode_key_val output_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("rc", zcbor_int32_decode, &rc),
+	};
+
+	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), nb->data, nb->len, 1, NULL, 0);
+	zassert_ok(zcbor_map_decode_bulk(zsd, output_decode, ARRAY_SIZE(output_decode),
+					 &decoded));
+
+	return rc;
+}
+
+/* Checks that the top entry of a "top" list is the spinning function */
+static bool sampler_test_parse_top(zcbor_state_t *state, void *user_data)
+{
+	bool *found = user_data;
+	struct zcbor_string func = { 0 };
+	struct zcbor_string thread = { 0 };
+	uint32_t count = 0;
+	size_t decoded = 0;
+
+	struct zcbor_map_decode_key_val entry_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("thread", zcbor_tstr_decode, &thread),
+		ZCBOR_MAP_DECODE_KEY_DECODER("func", zcbor_tstr_decode, &func),
+		ZCBOR_MAP_DECODE_KEY_DECODER("count", zcbor_uint32_decode, &count),
+	};
+
+	if (!zcbor_list_start_decode(state)) {
+		return false;
+	}
+
+	if (!zcbor_array_at_end(state)) {
+		if (zcbor_map_decode_bulk(state, entry_decode, ARRAY_SIZE(entry_decode),
+					  &decoded) != 0) {
+			return false;
+		}
+
+		*found = (decoded == 3) && (count > 0U) &&
+			 (func.len == strlen("sampler_test_spin")) &&
+			 (memcmp(func.value, "sampler_test_spin", func.len) == 0);
+	}
+
+	while (!zcbor_array_at_end(state)) {
+		if (!zcbor_any_skip(state, NULL)) {
+			return false;
+		}
+	}
+
+	return zcbor_list_end_decode(state);
+}
+
+ZTEST(sampler, test_mgmt)
+{
+	struct profiling_sampler_entry entry;
+	zcbor_state_t zsd[ZCBOR_HISTORY_SIZE];
+	uint32_t frequency = UINT32_MAX;
+	uint32_t samples = 0;
+	uint32_t dropped = 0;
+	bool found = false;
+	size_t decoded = 0;
+	struct net_buf *nb;
+
+	struct zcbor_map_decode_key_val output_decode[] = {
+		ZCBOR_MAP_DECODE_KEY_DECODER("freq", zcbor_uint32_decode, &frequency),
+		ZCBOR_MAP_DECODE_KEY_DECODER("samples", zcbor_uint32_decode, &samples),
+		ZCBOR_MAP_DECODE_KEY_DECODER("dropped", zcbor_uint32_decode, &dropped),
+		ZCBOR_MAP_DECODE_KEY_DECODER("top", sampler_test_parse_top, &found),
+	};
+
+	nb = sampler_test_smp_freq(CONFIG_SYS_CLOCK_TICKS_PER_SEC + 1);
+	zassert_equal(sampler_test_smp_rc(nb), MGMT_ERR_EINVAL);
+	net_buf_unref(nb);
+
+	nb = sampler_test_smp_freq(SAMPLER_FREQUENCY);
+	zassert_equal(sampler_test_smp_rc(nb), MGMT_ERR_EOK);
+	net_buf_unref(nb);
+
+	sampler_test_spin(SAMPLER_SPIN_MS);
+
+	nb = sampler_test_smp_freq(0);
+	zassert_equal(sampler_test_smp_rc(nb), MGMT_ERR_EOK);
+	net_buf_unref(nb);
+
+	nb = sampler_test_smp(ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLES, false, empty_map,
+			      sizeof(empty_map));
+	zcbor_new_decode_state(zsd, ARRAY_SIZE(zsd), nb->data, nb->len, 1, NULL, 0);
+	zassert_ok(zcbor_map_decode_bulk(zsd, output_decode, ARRAY_SIZE(output_decode),
+					 &decoded));
+	net_buf_unref(nb);
+
+	zassert_equal(decoded, 4);
+	zassert_equal(frequency, 0U);
+	zassert_true(samples > dropped, "%u samples, %u dropped", samples, dropped);
+	zassert_true(found, "spinning function is not the top entry");
+
+	/* A write to the samples command resets the histogram */
+	nb = sampler_test_smp(ZEPHYR_MGMT_GRP_PROFILING_CMD_SAMPLES, true, empty_map,
+			      sizeof(empty_map));
+	zassert_equal(sampler_test_smp_rc(nb), MGMT_ERR_EOK);
+	net_buf_unref(nb);
+
+	zassert_equal(profiling_sampler_top(&entry, 1), 0);
+}
+
+static void sampler_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	profiling_sampler_stop();
+	profiling_sampler_reset();
+}
+
+ZTEST_SUITE(sampler, NULL, NULL, sampler_before, NULL, NULL);